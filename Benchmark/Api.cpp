@@ -0,0 +1,389 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// CPU overhead of per-frame API calls ("SetCommonSettings" and "GetComputeDispatches") for a sweep of denoiser sets, resolutions,
+// accumulation modes and settings permutations. Reports "ns per call", "allocations per call" and "cache misses per call" (Linux only) as JSON
+// Usage: NRDBenchmarkApi [frameNum] [output.json]
+
+#include "NRD.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__)
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+//========================================================================================================================================
+// Counters
+//========================================================================================================================================
+
+struct AllocationCounter {
+    uint64_t allocationNum;
+};
+
+static void* NRD_CALL CountingAllocate(void* userArg, size_t size, size_t alignment) {
+    ((AllocationCounter*)userArg)->allocationNum++;
+
+#if _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    return aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+static void* NRD_CALL CountingReallocate(void* userArg, void* memory, size_t size, size_t alignment) {
+    ((AllocationCounter*)userArg)->allocationNum++;
+
+#if _WIN32
+    return _aligned_realloc(memory, size, alignment);
+#else
+    // "realloc" preserves only fundamental alignment (not an issue, since NRD doesn't reallocate)
+    return alignment <= alignof(std::max_align_t) ? realloc(memory, size) : nullptr;
+#endif
+}
+
+static void NRD_CALL CountingFree(void*, void* memory) {
+#if _WIN32
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr = {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        m_Fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (m_Fd >= 0) {
+            ioctl(m_Fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_Fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    ~CacheMissCounter() {
+#if defined(__linux__)
+        if (m_Fd >= 0)
+            close(m_Fd);
+#endif
+    }
+
+    inline bool IsAvailable() const {
+        return m_Fd >= 0;
+    }
+
+    inline uint64_t Read() const {
+        uint64_t value = 0;
+
+#if defined(__linux__)
+        if (m_Fd >= 0 && read(m_Fd, &value, sizeof(value)) != sizeof(value))
+            value = 0;
+#endif
+
+        return value;
+    }
+
+private:
+    int m_Fd = -1;
+};
+
+//========================================================================================================================================
+// Sweep
+//========================================================================================================================================
+
+struct DenoiserSet {
+    const char* name;
+    std::vector<nrd::Denoiser> denoisers;
+};
+
+struct Resolution {
+    uint16_t w;
+    uint16_t h;
+};
+
+struct Measurement {
+    double ns;
+    double allocationNum;
+    double cacheMissNum;
+};
+
+enum class SettingsPermutation : uint32_t {
+    DEFAULT,
+    CHECKERBOARD,       // checkerboard + hit distance reconstruction
+    ANTIFIREFLY_TOGGLE, // "enableAntiFirefly" flipped
+
+    MAX_NUM
+};
+
+const char* g_SettingsPermutationNames[] = {
+    "default",
+    "checkerboard",
+    "antifirefly_toggle",
+};
+
+const char* g_AccumulationModeNames[] = {
+    "CONTINUE",
+    "RESTART",
+    "CLEAR_AND_RESTART",
+};
+
+static void SetDenoiserSettings(nrd::Instance& instance, nrd::Identifier identifier, nrd::Denoiser denoiser, SettingsPermutation permutation) {
+    bool isCheckerboard = permutation == SettingsPermutation::CHECKERBOARD;
+    bool isAntifireflyToggle = permutation == SettingsPermutation::ANTIFIREFLY_TOGGLE;
+
+    if ((uint32_t)denoiser <= (uint32_t)nrd::Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION) {
+        nrd::ReblurSettings settings = {};
+        if (isCheckerboard) {
+            settings.checkerboardMode = nrd::CheckerboardMode::BLACK;
+            settings.hitDistanceReconstructionMode = nrd::HitDistanceReconstructionMode::AREA_3X3;
+        }
+        if (isAntifireflyToggle)
+            settings.enableAntiFirefly = !settings.enableAntiFirefly;
+
+        nrd::SetDenoiserSettings(instance, identifier, &settings);
+    } else if ((uint32_t)denoiser <= (uint32_t)nrd::Denoiser::RELAX_DIFFUSE_SPECULAR_SH) {
+        nrd::RelaxSettings settings = {};
+        if (isCheckerboard) {
+            settings.checkerboardMode = nrd::CheckerboardMode::BLACK;
+            settings.hitDistanceReconstructionMode = nrd::HitDistanceReconstructionMode::AREA_3X3;
+        }
+        if (isAntifireflyToggle)
+            settings.enableAntiFirefly = !settings.enableAntiFirefly;
+
+        nrd::SetDenoiserSettings(instance, identifier, &settings);
+    } else if (denoiser == nrd::Denoiser::SIGMA_SHADOW || denoiser == nrd::Denoiser::SIGMA_SHADOW_TRANSLUCENCY) {
+        nrd::SigmaSettings settings = {};
+        if (isCheckerboard)
+            settings.checkerboardMode = nrd::CheckerboardMode::BLACK;
+
+        nrd::SetDenoiserSettings(instance, identifier, &settings);
+    } else {
+        nrd::ReferenceSettings settings = {};
+        nrd::SetDenoiserSettings(instance, identifier, &settings);
+    }
+}
+
+static void SetCamera(nrd::CommonSettings& commonSettings, uint32_t frameIndex) {
+    // Column-major, D3D-style perspective projection
+    const float zNear = 0.1f;
+    const float zFar = 1000.0f;
+    const float yScale = 1.0f / tanf(0.5f * 1.0472f);
+    const float xScale = yScale * commonSettings.resourceSize[1] / commonSettings.resourceSize[0];
+
+    float viewToClip[16] = {
+        xScale, 0.0f, 0.0f, 0.0f,
+        0.0f, yScale, 0.0f, 0.0f,
+        0.0f, 0.0f, zFar / (zFar - zNear), 1.0f,
+        0.0f, 0.0f, -zNear * zFar / (zFar - zNear), 0.0f};
+
+    // Moving camera, i.e. no "static frame" shortcuts
+    float worldToView[16] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.01f * frameIndex, 0.0f, 0.0f, 1.0f};
+
+    memcpy(commonSettings.viewToClipMatrixPrev, commonSettings.viewToClipMatrix, sizeof(viewToClip));
+    memcpy(commonSettings.worldToViewMatrixPrev, commonSettings.worldToViewMatrix, sizeof(worldToView));
+    memcpy(commonSettings.viewToClipMatrix, viewToClip, sizeof(viewToClip));
+    memcpy(commonSettings.worldToViewMatrix, worldToView, sizeof(worldToView));
+
+    memcpy(commonSettings.cameraJitterPrev, commonSettings.cameraJitter, sizeof(commonSettings.cameraJitter));
+    commonSettings.cameraJitter[0] = (frameIndex % 8) / 8.0f - 0.5f;
+    commonSettings.cameraJitter[1] = (frameIndex % 3) / 3.0f - 0.5f;
+
+    commonSettings.frameIndex = frameIndex;
+}
+
+static void PrintMeasurement(FILE* out, const char* name, const Measurement& m, bool hasCacheMisses, bool isLast) {
+    fprintf(out, "        \"%s\": {\"nsPerCall\": %.1f, \"allocationsPerCall\": %.3f, \"cacheMissesPerCall\": ", name, m.ns, m.allocationNum);
+    if (hasCacheMisses)
+        fprintf(out, "%.1f", m.cacheMissNum);
+    else
+        fprintf(out, "null");
+    fprintf(out, "}%s\n", isLast ? "" : ",");
+}
+
+int main(int argc, char** argv) {
+    uint32_t frameNum = argc > 1 ? (uint32_t)atoi(argv[1]) : 256;
+    frameNum = frameNum ? frameNum : 1;
+
+    FILE* out = stdout;
+    if (argc > 2) {
+        out = fopen(argv[2], "w");
+        if (!out) {
+            printf("Can't open '%s'!\n", argv[2]);
+            return 1;
+        }
+    }
+
+    const nrd::LibraryDesc& libraryDesc = *nrd::GetLibraryDesc();
+
+    std::vector<DenoiserSet> denoiserSets = {
+        {"REBLUR_DIFFUSE_SPECULAR", {nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR}},
+        {"RELAX_DIFFUSE_SPECULAR", {nrd::Denoiser::RELAX_DIFFUSE_SPECULAR}},
+        {"SIGMA_SHADOW", {nrd::Denoiser::SIGMA_SHADOW}},
+        {"REBLUR_DIFFUSE_SPECULAR+SIGMA_SHADOW", {nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR, nrd::Denoiser::SIGMA_SHADOW}},
+        {"ALL", std::vector<nrd::Denoiser>(libraryDesc.supportedDenoisers, libraryDesc.supportedDenoisers + libraryDesc.supportedDenoisersNum)},
+    };
+
+    const Resolution resolutions[] = {{1920, 1080}, {2560, 1440}, {3840, 2160}};
+
+    CacheMissCounter cacheMissCounter;
+    AllocationCounter allocationCounter = {};
+
+    fprintf(out, "{\n  \"version\": \"%u.%u.%u\",\n  \"frameNum\": %u,\n  \"results\": [\n", libraryDesc.versionMajor, libraryDesc.versionMinor, libraryDesc.versionBuild, frameNum);
+
+    bool isFirst = true;
+    for (const DenoiserSet& denoiserSet : denoiserSets) {
+        // Skip unsupported
+        bool isSupported = true;
+        for (nrd::Denoiser denoiser : denoiserSet.denoisers) {
+            bool isFound = false;
+            for (uint32_t i = 0; i < libraryDesc.supportedDenoisersNum; i++)
+                isFound |= libraryDesc.supportedDenoisers[i] == denoiser;
+
+            isSupported &= isFound;
+        }
+
+        if (!isSupported)
+            continue;
+
+        std::vector<nrd::DenoiserDesc> denoiserDescs;
+        std::vector<nrd::Identifier> identifiers;
+        for (size_t i = 0; i < denoiserSet.denoisers.size(); i++) {
+            denoiserDescs.push_back({nrd::Identifier(i), denoiserSet.denoisers[i]});
+            identifiers.push_back(nrd::Identifier(i));
+        }
+
+        nrd::InstanceCreationDesc instanceCreationDesc = {};
+        instanceCreationDesc.allocationCallbacks = {CountingAllocate, CountingReallocate, CountingFree, &allocationCounter};
+        instanceCreationDesc.denoisers = denoiserDescs.data();
+        instanceCreationDesc.denoisersNum = (uint32_t)denoiserDescs.size();
+
+        for (const Resolution& resolution : resolutions) {
+            for (uint32_t accumulationMode = 0; accumulationMode < 3; accumulationMode++) {
+                for (uint32_t permutation = 0; permutation < (uint32_t)SettingsPermutation::MAX_NUM; permutation++) {
+                    nrd::Instance* instance = nullptr;
+                    if (nrd::CreateInstance(instanceCreationDesc, instance) != nrd::Result::SUCCESS) {
+                        printf("CreateInstance() failed!\n");
+                        return 1;
+                    }
+
+                    for (const nrd::DenoiserDesc& denoiserDesc : denoiserDescs)
+                        SetDenoiserSettings(*instance, denoiserDesc.identifier, denoiserDesc.denoiser, (SettingsPermutation)permutation);
+
+                    nrd::CommonSettings commonSettings = {};
+                    commonSettings.resourceSize[0] = commonSettings.resourceSizePrev[0] = commonSettings.rectSize[0] = commonSettings.rectSizePrev[0] = resolution.w;
+                    commonSettings.resourceSize[1] = commonSettings.resourceSizePrev[1] = commonSettings.rectSize[1] = commonSettings.rectSizePrev[1] = resolution.h;
+                    commonSettings.timeDeltaBetweenFrames = 16.6f;
+
+                    Measurement setCommonSettings = {};
+                    Measurement getComputeDispatches = {};
+                    uint32_t dispatchNum = 0;
+
+                    // The first frames are warm-up
+                    const uint32_t warmupFrameNum = 16;
+                    for (uint32_t frameIndex = 0; frameIndex < warmupFrameNum + frameNum; frameIndex++) {
+                        bool isMeasured = frameIndex >= warmupFrameNum;
+
+                        SetCamera(commonSettings, frameIndex);
+                        commonSettings.accumulationMode = isMeasured ? (nrd::AccumulationMode)accumulationMode : nrd::AccumulationMode::CONTINUE;
+
+                        // SetCommonSettings
+                        uint64_t allocationNum = allocationCounter.allocationNum;
+                        uint64_t cacheMissNum = cacheMissCounter.Read();
+                        auto t0 = std::chrono::high_resolution_clock::now();
+
+                        nrd::SetCommonSettings(*instance, commonSettings);
+
+                        auto t1 = std::chrono::high_resolution_clock::now();
+                        uint64_t cacheMissNum1 = cacheMissCounter.Read();
+
+                        if (isMeasured) {
+                            setCommonSettings.ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+                            setCommonSettings.allocationNum += double(allocationCounter.allocationNum - allocationNum);
+                            setCommonSettings.cacheMissNum += double(cacheMissNum1 - cacheMissNum);
+                        }
+
+                        // GetComputeDispatches
+                        const nrd::DispatchDesc* dispatchDescs = nullptr;
+                        uint32_t dispatchDescsNum = 0;
+
+                        allocationNum = allocationCounter.allocationNum;
+                        cacheMissNum = cacheMissCounter.Read();
+                        t0 = std::chrono::high_resolution_clock::now();
+
+                        nrd::GetComputeDispatches(*instance, identifiers.data(), (uint32_t)identifiers.size(), dispatchDescs, dispatchDescsNum);
+
+                        t1 = std::chrono::high_resolution_clock::now();
+                        cacheMissNum1 = cacheMissCounter.Read();
+
+                        if (isMeasured) {
+                            getComputeDispatches.ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+                            getComputeDispatches.allocationNum += double(allocationCounter.allocationNum - allocationNum);
+                            getComputeDispatches.cacheMissNum += double(cacheMissNum1 - cacheMissNum);
+                            dispatchNum += dispatchDescsNum;
+                        }
+                    }
+
+                    nrd::DestroyInstance(*instance);
+
+                    for (Measurement* m : {&setCommonSettings, &getComputeDispatches}) {
+                        m->ns /= frameNum;
+                        m->allocationNum /= frameNum;
+                        m->cacheMissNum /= frameNum;
+                    }
+
+                    // Report
+                    fprintf(out, "%s    {\n", isFirst ? "" : ",\n");
+                    fprintf(out, "      \"denoisers\": \"%s\",\n", denoiserSet.name);
+                    fprintf(out, "      \"resolution\": [%u, %u],\n", resolution.w, resolution.h);
+                    fprintf(out, "      \"accumulationMode\": \"%s\",\n", g_AccumulationModeNames[accumulationMode]);
+                    fprintf(out, "      \"settings\": \"%s\",\n", g_SettingsPermutationNames[permutation]);
+                    fprintf(out, "      \"dispatchesPerFrame\": %.1f,\n", double(dispatchNum) / frameNum);
+                    fprintf(out, "      \"calls\": {\n");
+                    PrintMeasurement(out, "SetCommonSettings", setCommonSettings, cacheMissCounter.IsAvailable(), false);
+                    PrintMeasurement(out, "GetComputeDispatches", getComputeDispatches, cacheMissCounter.IsAvailable(), true);
+                    fprintf(out, "      }\n    }");
+
+                    if (out != stdout)
+                        printf("%-40s %4ux%-4u %-18s %-18s SetCommonSettings %8.0f ns, GetComputeDispatches %8.0f ns\n", denoiserSet.name, resolution.w, resolution.h, g_AccumulationModeNames[accumulationMode], g_SettingsPermutationNames[permutation], setCommonSettings.ns, getComputeDispatches.ns);
+
+                    isFirst = false;
+                }
+            }
+        }
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout)
+        fclose(out);
+
+    return 0;
+}
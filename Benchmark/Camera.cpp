@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Per-frame cost of camera state processing for REFERENCE-only, SIGMA-only and REBLUR instances. Derived camera state is computed
+// lazily on first use, i.e. the cost is split between "SetCommonSettings" and "GetComputeDispatches", thus the sum is reported too
+// Usage: NRDBenchmarkCamera [frameNum]
+
+#include "NRD.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void SetCamera(nrd::CommonSettings& commonSettings, uint32_t frameIndex) {
+    // Column-major, D3D-style perspective projection
+    const float zNear = 0.1f;
+    const float zFar = 1000.0f;
+    const float yScale = 1.0f / tanf(0.5f * 1.0472f);
+    const float xScale = yScale * commonSettings.resourceSize[1] / commonSettings.resourceSize[0];
+
+    float viewToClip[16] = {
+        xScale, 0.0f, 0.0f, 0.0f,
+        0.0f, yScale, 0.0f, 0.0f,
+        0.0f, 0.0f, zFar / (zFar - zNear), 1.0f,
+        0.0f, 0.0f, -zNear * zFar / (zFar - zNear), 0.0f};
+
+    // Rotating and moving camera
+    float a = 0.001f * frameIndex;
+    float worldToView[16] = {
+        cosf(a), 0.0f, sinf(a), 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        -sinf(a), 0.0f, cosf(a), 0.0f,
+        0.01f * frameIndex, 0.0f, 0.0f, 1.0f};
+
+    memcpy(commonSettings.viewToClipMatrixPrev, commonSettings.viewToClipMatrix, sizeof(viewToClip));
+    memcpy(commonSettings.worldToViewMatrixPrev, commonSettings.worldToViewMatrix, sizeof(worldToView));
+    memcpy(commonSettings.viewToClipMatrix, viewToClip, sizeof(viewToClip));
+    memcpy(commonSettings.worldToViewMatrix, worldToView, sizeof(worldToView));
+
+    commonSettings.frameIndex = frameIndex;
+}
+
+int main(int argc, char** argv) {
+    uint32_t frameNum = argc > 1 ? (uint32_t)atoi(argv[1]) : 10000;
+    frameNum = frameNum ? frameNum : 1;
+
+    const nrd::Denoiser denoisers[] = {nrd::Denoiser::REFERENCE, nrd::Denoiser::SIGMA_SHADOW, nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR};
+
+    printf("%-26s %22s %25s %12s\n", "Denoiser", "SetCommonSettings (ns)", "GetComputeDispatches (ns)", "Total (ns)");
+
+    for (nrd::Denoiser denoiser : denoisers) {
+        const nrd::DenoiserDesc denoiserDesc = {0, denoiser};
+
+        nrd::InstanceCreationDesc instanceCreationDesc = {};
+        instanceCreationDesc.denoisers = &denoiserDesc;
+        instanceCreationDesc.denoisersNum = 1;
+
+        nrd::Instance* instance = nullptr;
+        if (nrd::CreateInstance(instanceCreationDesc, instance) != nrd::Result::SUCCESS) {
+            printf("CreateInstance() failed!\n");
+            return 1;
+        }
+
+        nrd::CommonSettings commonSettings = {};
+        commonSettings.resourceSize[0] = commonSettings.resourceSizePrev[0] = commonSettings.rectSize[0] = commonSettings.rectSizePrev[0] = 1920;
+        commonSettings.resourceSize[1] = commonSettings.resourceSizePrev[1] = commonSettings.rectSize[1] = commonSettings.rectSizePrev[1] = 1080;
+        commonSettings.timeDeltaBetweenFrames = 16.6f;
+
+        double setCommonSettingsTime = 0.0;
+        double getComputeDispatchesTime = 0.0;
+
+        for (uint32_t frameIndex = 0; frameIndex < frameNum; frameIndex++) {
+            SetCamera(commonSettings, frameIndex);
+
+            auto t0 = std::chrono::high_resolution_clock::now();
+
+            nrd::SetCommonSettings(*instance, commonSettings);
+
+            auto t1 = std::chrono::high_resolution_clock::now();
+
+            const nrd::DispatchDesc* dispatchDescs = nullptr;
+            uint32_t dispatchDescsNum = 0;
+            nrd::GetComputeDispatches(*instance, &denoiserDesc.identifier, 1, dispatchDescs, dispatchDescsNum);
+
+            auto t2 = std::chrono::high_resolution_clock::now();
+
+            setCommonSettingsTime += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            getComputeDispatchesTime += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        }
+
+        nrd::DestroyInstance(*instance);
+
+        setCommonSettingsTime /= frameNum;
+        getComputeDispatchesTime /= frameNum;
+
+        printf("%-26s %22.1f %25.1f %12.1f\n", nrd::GetDenoiserString(denoiser), setCommonSettingsTime, getComputeDispatchesTime, setCommonSettingsTime + getComputeDispatchesTime);
+    }
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// CPU tests of the per-frame logic of the core ("GetComputeDispatches"): restarts and freezing. No device is needed. Returns the number of failed checks
+// Usage: NRDCoreTests
+
+#include "NRD.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <set>
+
+static uint32_t g_FailedNum = 0;
+
+#define CHECK(expr) \
+    if (!(expr)) { \
+        printf("%s(%d): '%s' failed!\n", __FILE__, __LINE__, #expr); \
+        g_FailedNum++; \
+    }
+
+constexpr nrd::Identifier REBLUR = 0;
+constexpr nrd::Identifier RELAX = 1;
+
+static nrd::CommonSettings GetCommonSettings(uint32_t frameIndex) {
+    nrd::CommonSettings commonSettings = {};
+    commonSettings.resourceSize[0] = commonSettings.resourceSizePrev[0] = commonSettings.rectSize[0] = commonSettings.rectSizePrev[0] = 256;
+    commonSettings.resourceSize[1] = commonSettings.resourceSizePrev[1] = commonSettings.rectSize[1] = commonSettings.rectSizePrev[1] = 128;
+    commonSettings.timeDeltaBetweenFrames = 16.6f;
+    commonSettings.frameIndex = frameIndex;
+
+    return commonSettings;
+}
+
+// Resources of clear dispatches of a denoiser as "ResourceType << 16 | indexInPool"
+static std::set<uint32_t> GetClearedResources(nrd::Instance& instance, const nrd::DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, nrd::Identifier identifier) {
+    const nrd::InstanceDesc& instanceDesc = *nrd::GetInstanceDesc(instance);
+
+    std::set<uint32_t> resources;
+    for (uint32_t i = 0; i < dispatchDescsNum; i++) {
+        const nrd::DispatchDesc& dispatchDesc = dispatchDescs[i];
+        if (dispatchDesc.identifier != identifier || instanceDesc.pipelines[dispatchDesc.pipelineIndex].type != nrd::PipelineType::CLEAR)
+            continue;
+
+        for (uint32_t j = 0; j < dispatchDesc.resourcesNum; j++)
+            resources.insert((uint32_t(dispatchDesc.resources[j].type) << 16) | dispatchDesc.resources[j].indexInPool);
+    }
+
+    return resources;
+}
+
+//========================================================================================================================================
+// RestartDenoiser
+//========================================================================================================================================
+
+static void TestRestartDenoisers() {
+    const nrd::DenoiserDesc denoiserDescs[] = {
+        {REBLUR, nrd::Denoiser::REBLUR_DIFFUSE, false},
+        {RELAX, nrd::Denoiser::RELAX_DIFFUSE, false},
+    };
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs;
+    instanceCreationDesc.denoisersNum = 2;
+
+    nrd::Instance* instance = nullptr;
+    CHECK(nrd::CreateInstance(instanceCreationDesc, instance) == nrd::Result::SUCCESS);
+    if (!instance)
+        return;
+
+    const nrd::Identifier identifiers[] = {REBLUR, RELAX};
+    const nrd::DispatchDesc* dispatchDescs = nullptr;
+    uint32_t dispatchDescsNum = 0;
+    uint32_t frameIndex = 0;
+
+    // The first frame clears everything
+    nrd::SetCommonSettings(*instance, GetCommonSettings(frameIndex++));
+    nrd::GetComputeDispatches(*instance, identifiers, 2, dispatchDescs, dispatchDescsNum);
+
+    // Nothing to clear without a restart
+    nrd::SetCommonSettings(*instance, GetCommonSettings(frameIndex++));
+    nrd::GetComputeDispatches(*instance, identifiers, 2, dispatchDescs, dispatchDescsNum);
+    CHECK(GetClearedResources(*instance, dispatchDescs, dispatchDescsNum, REBLUR).empty());
+    CHECK(GetClearedResources(*instance, dispatchDescs, dispatchDescsNum, RELAX).empty());
+
+    // One restart per frame
+    CHECK(nrd::RestartDenoiser(*instance, REBLUR) == nrd::Result::SUCCESS);
+    nrd::SetCommonSettings(*instance, GetCommonSettings(frameIndex++));
+    nrd::GetComputeDispatches(*instance, identifiers, 2, dispatchDescs, dispatchDescsNum);
+    std::set<uint32_t> reblurResources = GetClearedResources(*instance, dispatchDescs, dispatchDescsNum, REBLUR);
+    CHECK(!reblurResources.empty());
+    CHECK(GetClearedResources(*instance, dispatchDescs, dispatchDescsNum, RELAX).empty());
+
+    CHECK(nrd::RestartDenoiser(*instance, RELAX) == nrd::Result::SUCCESS);
+    nrd::SetCommonSettings(*instance, GetCommonSettings(frameIndex++));
+    nrd::GetComputeDispatches(*instance, identifiers, 2, dispatchDescs, dispatchDescsNum);
+    std::set<uint32_t> relaxResources = GetClearedResources(*instance, dispatchDescs, dispatchDescsNum, RELAX);
+    CHECK(!relaxResources.empty());
+    CHECK(GetClearedResources(*instance, dispatchDescs, dispatchDescsNum, REBLUR).empty());
+
+    // Two restarts in one frame: clears of the first denoiser must keep pointing to its own textures
+    CHECK(nrd::RestartDenoiser(*instance, REBLUR) == nrd::Result::SUCCESS);
+    CHECK(nrd::RestartDenoiser(*instance, RELAX) == nrd::Result::SUCCESS);
+    nrd::SetCommonSettings(*instance, GetCommonSettings(frameIndex++));
+    nrd::GetComputeDispatches(*instance, identifiers, 2, dispatchDescs, dispatchDescsNum);
+    CHECK(GetClearedResources(*instance, dispatchDescs, dispatchDescsNum, REBLUR) == reblurResources);
+    CHECK(GetClearedResources(*instance, dispatchDescs, dispatchDescsNum, RELAX) == relaxResources);
+
+    nrd::DestroyInstance(*instance);
+}
+
+//========================================================================================================================================
+// CommonSettings::isSceneStatic
+//========================================================================================================================================
+
+static uint32_t GetDispatchNum(const nrd::DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, nrd::Identifier identifier) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < dispatchDescsNum; i++)
+        n += dispatchDescs[i].identifier == identifier ? 1 : 0;
+
+    return n;
+}
+
+static void TestFreeze() {
+    const nrd::DenoiserDesc denoiserDesc = {REBLUR, nrd::Denoiser::REBLUR_DIFFUSE, false};
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = &denoiserDesc;
+    instanceCreationDesc.denoisersNum = 1;
+
+    nrd::Instance* instance = nullptr;
+    CHECK(nrd::CreateInstance(instanceCreationDesc, instance) == nrd::Result::SUCCESS);
+    if (!instance)
+        return;
+
+    const nrd::DispatchDesc* dispatchDescs = nullptr;
+    uint32_t dispatchDescsNum = 0;
+    uint32_t frameIndex = 0;
+
+    // Converge
+    const uint32_t convergedFrameNum = nrd::ReblurSettings().maxAccumulatedFrameNum;
+    uint32_t frozenDispatchNum = 0;
+    for (uint32_t i = 0; i < convergedFrameNum + 3; i++) {
+        nrd::CommonSettings commonSettings = GetCommonSettings(frameIndex++);
+        commonSettings.isSceneStatic = true;
+
+        nrd::SetCommonSettings(*instance, commonSettings);
+        nrd::GetComputeDispatches(*instance, &REBLUR, 1, dispatchDescs, dispatchDescsNum);
+
+        frozenDispatchNum = GetDispatchNum(dispatchDescs, dispatchDescsNum, REBLUR);
+    }
+    CHECK(frozenDispatchNum == 1);
+
+    // The first frame with a moving camera is denoised
+    nrd::CommonSettings commonSettings = GetCommonSettings(frameIndex++);
+    commonSettings.isSceneStatic = true;
+    commonSettings.worldToViewMatrix[12] = 1.0f;
+
+    nrd::SetCommonSettings(*instance, commonSettings);
+    nrd::GetComputeDispatches(*instance, &REBLUR, 1, dispatchDescs, dispatchDescsNum);
+    CHECK(GetDispatchNum(dispatchDescs, dispatchDescsNum, REBLUR) > 1);
+
+    // A "RESTART" frame is denoised too
+    commonSettings = GetCommonSettings(frameIndex++);
+    commonSettings.isSceneStatic = true;
+    commonSettings.accumulationMode = nrd::AccumulationMode::RESTART;
+
+    nrd::SetCommonSettings(*instance, commonSettings);
+    nrd::GetComputeDispatches(*instance, &REBLUR, 1, dispatchDescs, dispatchDescsNum);
+    CHECK(GetDispatchNum(dispatchDescs, dispatchDescsNum, REBLUR) > 1);
+
+    nrd::DestroyInstance(*instance);
+}
+
+int main() {
+    TestRestartDenoisers();
+    TestFreeze();
+
+    if (g_FailedNum)
+        printf("%u check(s) failed!\n", g_FailedNum);
+    else
+        printf("All checks passed\n");
+
+    return (int)g_FailedNum;
+}
@@ -0,0 +1,96 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Times "CreateInstance" for each supported denoiser, each pair of supported denoisers and all of them at once
+// Usage: NRDBenchmarkCreateInstance [repeatNum]
+
+#include "NRD.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static double Measure(const nrd::DenoiserDesc* denoiserDescs, uint32_t denoiserDescsNum, uint32_t repeatNum, double& minTime) {
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs;
+    instanceCreationDesc.denoisersNum = denoiserDescsNum;
+
+    double sum = 0.0;
+    minTime = 1e30;
+
+    for (uint32_t i = 0; i < repeatNum; i++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+
+        nrd::Instance* instance = nullptr;
+        nrd::Result result = nrd::CreateInstance(instanceCreationDesc, instance);
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        if (result != nrd::Result::SUCCESS) {
+            printf("CreateInstance() failed!\n");
+            exit(1);
+        }
+
+        nrd::DestroyInstance(*instance);
+
+        double time = std::chrono::duration<double, std::micro>(end - begin).count();
+        minTime = std::min(minTime, time);
+        sum += time;
+    }
+
+    return sum / repeatNum;
+}
+
+static void Print(const char* name, double avgTime, double minTime) {
+    printf("%-80s %10.1f %10.1f\n", name, avgTime, minTime);
+}
+
+int main(int argc, char** argv) {
+    uint32_t repeatNum = argc > 1 ? (uint32_t)atoi(argv[1]) : 100;
+    repeatNum = std::max(repeatNum, 1u);
+
+    const nrd::LibraryDesc& libraryDesc = *nrd::GetLibraryDesc();
+    printf("NRD v%u.%u.%u, %u repeats, time in us\n\n", libraryDesc.versionMajor, libraryDesc.versionMinor, libraryDesc.versionBuild, repeatNum);
+    printf("%-80s %10s %10s\n", "Denoisers", "avg", "min");
+
+    std::vector<nrd::DenoiserDesc> denoiserDescs(libraryDesc.supportedDenoisersNum);
+    for (uint32_t i = 0; i < libraryDesc.supportedDenoisersNum; i++)
+        denoiserDescs[i] = {nrd::Identifier(i), libraryDesc.supportedDenoisers[i]};
+
+    char name[256];
+    double minTime = 0.0;
+
+    // Singles
+    for (uint32_t i = 0; i < libraryDesc.supportedDenoisersNum; i++) {
+        double avgTime = Measure(&denoiserDescs[i], 1, repeatNum, minTime);
+        Print(nrd::GetDenoiserString(denoiserDescs[i].denoiser), avgTime, minTime);
+    }
+
+    // Pairs
+    for (uint32_t i = 0; i < libraryDesc.supportedDenoisersNum; i++) {
+        for (uint32_t j = i + 1; j < libraryDesc.supportedDenoisersNum; j++) {
+            nrd::DenoiserDesc pair[2] = {denoiserDescs[i], denoiserDescs[j]};
+            double avgTime = Measure(pair, 2, repeatNum, minTime);
+
+            snprintf(name, sizeof(name), "%s + %s", nrd::GetDenoiserString(pair[0].denoiser), nrd::GetDenoiserString(pair[1].denoiser));
+            Print(name, avgTime, minTime);
+        }
+    }
+
+    // All
+    double avgTime = Measure(denoiserDescs.data(), (uint32_t)denoiserDescs.size(), repeatNum, minTime);
+
+    snprintf(name, sizeof(name), "ALL (%u)", (uint32_t)denoiserDescs.size());
+    Print(name, avgTime, minTime);
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Converts dispatch events, drained from "Integration::DrainDispatchEvents" and saved via "WriteDispatchEvents", into Chrome trace
+// JSON (chrome://tracing, Perfetto). One track per denoiser, timestamps are CPU-side (preparation), i.e. a duration is the distance
+// to the next dispatch of the same frame
+// Usage: NRDDispatchEventsToChromeTrace <events> <json>
+
+#include "NRD.h"
+#include "NRDIntegrationEvents.h"
+
+#include <cstdio>
+#include <set>
+#include <vector>
+
+static void WriteEscaped(FILE* file, const char* s) {
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            fputc('\\', file);
+        fputc(*s, file);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printf("Usage: NRDDispatchEventsToChromeTrace <events> <json>\n");
+        return 1;
+    }
+
+    // Load
+    FILE* file = fopen(argv[1], "rb");
+    if (!file) {
+        printf("Can't open '%s'!\n", argv[1]);
+        return 1;
+    }
+
+    nrd::DispatchEventsFileHeader header = {};
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.signature != NRD_DISPATCH_EVENTS_SIGNATURE) {
+        printf("Not an NRD dispatch events file!\n");
+        fclose(file);
+        return 1;
+    }
+
+    if (header.eventSize != sizeof(nrd::DispatchEvent)) {
+        printf("'DispatchEvent' size mismatch, the file is captured with another NRD version!\n");
+        fclose(file);
+        return 1;
+    }
+
+    std::vector<nrd::DispatchEvent> events;
+    nrd::DispatchEvent event;
+    while (fread(&event, sizeof(event), 1, file) == 1)
+        events.push_back(event);
+
+    fclose(file);
+
+    if (events.empty()) {
+        printf("No events!\n");
+        return 1;
+    }
+
+    // Convert
+    FILE* json = fopen(argv[2], "w");
+    if (!json) {
+        printf("Can't create '%s'!\n", argv[2]);
+        return 1;
+    }
+
+    fprintf(json, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    // Track names
+    std::set<nrd::Identifier> identifiers;
+    for (const nrd::DispatchEvent& e : events)
+        identifiers.insert(e.identifier);
+
+    for (nrd::Identifier identifier : identifiers)
+        fprintf(json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Identifier %u\"}},\n", identifier, identifier);
+
+    // Dispatches
+    const uint64_t origin = events[0].timestamp;
+
+    for (size_t i = 0; i < events.size(); i++) {
+        const nrd::DispatchEvent& e = events[i];
+
+        double ts = double(e.timestamp - origin) / 1000.0;
+        double dur = 1.0;
+        if (i + 1 < events.size() && events[i + 1].frameIndex == e.frameIndex && events[i + 1].timestamp > e.timestamp)
+            dur = double(events[i + 1].timestamp - e.timestamp) / 1000.0;
+
+        fprintf(json, "{\"name\":\"");
+        WriteEscaped(json, e.name);
+        fprintf(json, "\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{", (e.flags & nrd::DISPATCH_EVENT_BINDLESS) ? "bindless" : "descriptor set", e.identifier, ts, dur);
+        fprintf(json, "\"frame\":%u,\"pipeline\":%u,\"grid\":\"%ux%u\",\"barriers\":%u,\"createdDescriptors\":%u,\"constantBytes\":%u,\"persistentDescriptorSet\":%s,\"resources\":\"",
+            e.frameIndex, e.pipelineIndex, e.gridWidth, e.gridHeight, e.barrierNum, e.createdDescriptorNum, e.constantBytes, (e.flags & nrd::DISPATCH_EVENT_PERSISTENT_DESCRIPTOR_SET) ? "true" : "false");
+
+        uint32_t n = e.resourcesNum < nrd::DISPATCH_EVENT_RESOURCE_MAX_NUM ? e.resourcesNum : nrd::DISPATCH_EVENT_RESOURCE_MAX_NUM;
+        for (uint32_t j = 0; j < n; j++) {
+            nrd::ResourceType type = nrd::ResourceType(e.resources[j] >> 16);
+            uint32_t indexInPool = e.resources[j] & 0xFFFF;
+
+            if (type == nrd::ResourceType::PERMANENT_POOL)
+                fprintf(json, "%sP(%u)", j ? " " : "", indexInPool);
+            else if (type == nrd::ResourceType::TRANSIENT_POOL)
+                fprintf(json, "%sT(%u)", j ? " " : "", indexInPool);
+            else {
+                const char* typeName = nrd::GetResourceTypeString(type);
+                fprintf(json, "%s%s", j ? " " : "", typeName ? typeName : "?");
+            }
+        }
+
+        if (e.resourcesNum > n)
+            fprintf(json, " (+%u)", e.resourcesNum - n);
+
+        fprintf(json, "\"}}%s\n", i + 1 < events.size() ? "," : "");
+    }
+
+    fprintf(json, "]}\n");
+    fclose(json);
+
+    printf("%u events converted\n", (uint32_t)events.size());
+
+    return 0;
+}
@@ -0,0 +1,325 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// CPU tests of GAPI agnostic helpers of the integration layer: "RetirementQueue", "CalculatePlacement", "FillBindlessIndexTable",
+// "GetQueueOwnershipTransfers" and "DispatchEventRing". No device is needed (only NRI headers). Returns the number of failed checks
+// Usage: NRDIntegrationTests
+
+#include "NRI.h"
+#include "Extensions/NRIHelper.h"
+
+#include "NRD.h"
+#include "NRDIntegration.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+static uint32_t g_FailedNum = 0;
+
+#define CHECK(expr) \
+    if (!(expr)) { \
+        printf("%s(%d): '%s' failed!\n", __FILE__, __LINE__, #expr); \
+        g_FailedNum++; \
+    }
+
+//========================================================================================================================================
+// RetirementQueue
+//========================================================================================================================================
+
+// Counts released objects per type and remembers the release order
+struct CountingRelease {
+    uint32_t releasedNum[(size_t)nrd::RetiredObjectType::MEMORY + 1];
+    std::vector<void*> order;
+
+    void operator()(const nrd::RetiredObject& retiredObject) {
+        releasedNum[(size_t)retiredObject.type]++;
+        order.push_back(retiredObject.object);
+    }
+};
+
+static void TestRetirementQueue() {
+    uint8_t objects[8] = {};
+
+    nrd::RetirementQueue queue;
+    CountingRelease counter = {};
+    auto release = [&counter](const nrd::RetiredObject& retiredObject) { counter(retiredObject); };
+
+    // "nullptr" is ignored
+    queue.Retire(nrd::RetiredObjectType::TEXTURE, nullptr, 0);
+    CHECK(queue.GetSize() == 0);
+
+    // Frame 0: a texture and its memory, frame 1: a descriptor
+    queue.Retire(nrd::RetiredObjectType::TEXTURE, &objects[0], 0);
+    queue.Retire(nrd::RetiredObjectType::MEMORY, &objects[1], 0);
+    queue.Retire(nrd::RetiredObjectType::DESCRIPTOR, &objects[2], 1);
+    CHECK(queue.GetSize() == 3);
+
+    // 2 queued frames: nothing can be released in frame 1
+    CHECK(queue.Release(1, 2, release) == 0);
+    CHECK(queue.GetSize() == 3);
+
+    // Frame 2: objects of frame 0 are not referenced by the GPU anymore, released in retirement order
+    CHECK(queue.Release(2, 2, release) == 2);
+    CHECK(counter.releasedNum[(size_t)nrd::RetiredObjectType::TEXTURE] == 1);
+    CHECK(counter.releasedNum[(size_t)nrd::RetiredObjectType::MEMORY] == 1);
+    CHECK(counter.order.size() == 2 && counter.order[0] == &objects[0] && counter.order[1] == &objects[1]);
+    CHECK(queue.GetSize() == 1);
+
+    // Frame 3: the descriptor
+    CHECK(queue.Release(3, 2, release) == 1);
+    CHECK(counter.releasedNum[(size_t)nrd::RetiredObjectType::DESCRIPTOR] == 1);
+    CHECK(queue.GetSize() == 0);
+
+    // Frame index wrapping
+    queue.Retire(nrd::RetiredObjectType::BUFFER, &objects[3], 0xFFFFFFFF);
+    CHECK(queue.Release(0, 2, release) == 0);
+    CHECK(queue.Release(1, 2, release) == 1);
+    CHECK(counter.releasedNum[(size_t)nrd::RetiredObjectType::BUFFER] == 1);
+
+    // "ReleaseAll" ignores frame indices
+    queue.Retire(nrd::RetiredObjectType::PIPELINE, &objects[4], 100);
+    queue.Retire(nrd::RetiredObjectType::PIPELINE_LAYOUT, &objects[5], 100);
+    queue.Retire(nrd::RetiredObjectType::DESCRIPTOR_POOL, &objects[6], 100);
+    CHECK(queue.ReleaseAll(release) == 3);
+    CHECK(queue.GetSize() == 0);
+    CHECK(counter.releasedNum[(size_t)nrd::RetiredObjectType::PIPELINE] == 1);
+    CHECK(counter.releasedNum[(size_t)nrd::RetiredObjectType::PIPELINE_LAYOUT] == 1);
+    CHECK(counter.releasedNum[(size_t)nrd::RetiredObjectType::DESCRIPTOR_POOL] == 1);
+    CHECK(counter.order.size() == 7);
+}
+
+//========================================================================================================================================
+// CalculatePlacement
+//========================================================================================================================================
+
+static void TestCalculatePlacement() {
+    const nrd::PlacementRequirements requirements[] = {
+        {100, 256},
+        {10, 4096},
+        {1, 0}, // no alignment requirement
+        {64, 64},
+    };
+
+    uint64_t offsets[4] = {};
+    uint32_t heapAlignment = 0;
+    uint64_t heapSize = nrd::CalculatePlacement(requirements, 4, offsets, heapAlignment);
+
+    CHECK(offsets[0] == 0);
+    CHECK(offsets[1] == 4096);
+    CHECK(offsets[2] == 4106);
+    CHECK(offsets[3] == 4160);
+    CHECK(heapSize == 4224);
+    CHECK(heapAlignment == 4096);
+
+    // Deterministic: same requirements - same placement
+    uint64_t offsets2[4] = {};
+    uint32_t heapAlignment2 = 0;
+    uint64_t heapSize2 = nrd::CalculatePlacement(requirements, 4, offsets2, heapAlignment2);
+
+    CHECK(heapSize2 == heapSize);
+    CHECK(heapAlignment2 == heapAlignment);
+    for (uint32_t i = 0; i < 4; i++)
+        CHECK(offsets2[i] == offsets[i]);
+
+    // Empty
+    heapSize = nrd::CalculatePlacement(nullptr, 0, nullptr, heapAlignment);
+    CHECK(heapSize == 0);
+    CHECK(heapAlignment == 1);
+}
+
+//========================================================================================================================================
+// FillBindlessIndexTable
+//========================================================================================================================================
+
+static void TestFillBindlessIndexTable() {
+    const uint32_t UNTOUCHED = 0xFFFFFFFF;
+
+    const nrd::ResourceRangeDesc resourceRanges[] = {
+        {nrd::DescriptorType::TEXTURE, 3},
+        {nrd::DescriptorType::STORAGE_TEXTURE, 2},
+    };
+
+    nrd::PipelineDesc pipelineDesc = {};
+    pipelineDesc.resourceRanges = resourceRanges;
+    pipelineDesc.resourceRangesNum = 2;
+
+    nrd::DispatchDesc dispatchDesc = {};
+    dispatchDesc.resourcesNum = 5;
+
+    const uint32_t heapIndices[] = {10, 11, 12, 13, 14};
+
+    uint32_t table[nrd::BINDLESS_TABLE_SIZE];
+    for (uint32_t& entry : table)
+        entry = UNTOUCHED;
+
+    CHECK(nrd::FillBindlessIndexTable(pipelineDesc, dispatchDesc, heapIndices, table));
+    CHECK(table[0] == 10 && table[1] == 11 && table[2] == 12);
+    CHECK(table[3] == UNTOUCHED);
+    CHECK(table[nrd::BINDLESS_TEXTURES_MAX_NUM] == 13 && table[nrd::BINDLESS_TEXTURES_MAX_NUM + 1] == 14);
+    CHECK(table[nrd::BINDLESS_TEXTURES_MAX_NUM + 2] == UNTOUCHED);
+
+    // Resources and ranges mismatch
+    dispatchDesc.resourcesNum = 4;
+    CHECK(!nrd::FillBindlessIndexTable(pipelineDesc, dispatchDesc, heapIndices, table));
+
+    dispatchDesc.resourcesNum = 6;
+    CHECK(!nrd::FillBindlessIndexTable(pipelineDesc, dispatchDesc, heapIndices, table));
+
+    // Too many storage textures
+    const nrd::ResourceRangeDesc tooManyStorages[] = {
+        {nrd::DescriptorType::STORAGE_TEXTURE, nrd::BINDLESS_STORAGE_TEXTURES_MAX_NUM + 1},
+    };
+
+    pipelineDesc.resourceRanges = tooManyStorages;
+    pipelineDesc.resourceRangesNum = 1;
+    dispatchDesc.resourcesNum = nrd::BINDLESS_STORAGE_TEXTURES_MAX_NUM + 1;
+    CHECK(!nrd::FillBindlessIndexTable(pipelineDesc, dispatchDesc, heapIndices, table));
+}
+
+//========================================================================================================================================
+// GetQueueOwnershipTransfers
+//========================================================================================================================================
+
+static nrd::Resource MakeResource(nri::Texture* texture, const nri::AccessLayoutStage& state) {
+    nrd::Resource resource = {};
+    resource.nri.texture = texture;
+    resource.state = state;
+
+    return resource;
+}
+
+static void TestGetQueueOwnershipTransfers() {
+    // Fake handles: never dereferenced
+    uint8_t handles[4] = {};
+    nri::Texture* input = (nri::Texture*)&handles[0];
+    nri::Texture* output = (nri::Texture*)&handles[1];
+    nri::Queue* graphicsQueue = (nri::Queue*)&handles[2];
+    nri::Queue* computeQueue = (nri::Queue*)&handles[3];
+
+    const nri::AccessLayoutStage inputState = {nri::AccessBits::COPY_SOURCE, nri::Layout::SHADER_RESOURCE, nri::StageBits::COPY};
+    const nri::AccessLayoutStage outputState = {nri::AccessBits::SHADER_RESOURCE_STORAGE, nri::Layout::SHADER_RESOURCE_STORAGE, nri::StageBits::COMPUTE_SHADER};
+
+    nrd::ResourceSnapshot resourceSnapshot;
+    resourceSnapshot.SetResource(nrd::ResourceType::IN_MV, MakeResource(input, inputState));
+    resourceSnapshot.SetResource(nrd::ResourceType::IN_VIEWZ, MakeResource(input, inputState));
+    resourceSnapshot.SetResource(nrd::ResourceType::OUT_DIFF_RADIANCE_HITDIST, MakeResource(output, outputState));
+    CHECK(resourceSnapshot.uniqueNum == 2);
+
+    nri::TextureBarrierDesc barriers[2] = {};
+
+    // Same queue or same family: nothing to do
+    CHECK(nrd::GetQueueOwnershipTransfers(resourceSnapshot, {graphicsQueue, 0}, {graphicsQueue, 0}, true, barriers) == 0);
+    CHECK(nrd::GetQueueOwnershipTransfers(resourceSnapshot, {graphicsQueue, 0}, {computeQueue, 0}, true, barriers) == 0);
+
+    const nrd::QueueFamily graphics = {graphicsQueue, 0};
+    const nrd::QueueFamily compute = {computeQueue, 1};
+
+    // Release (graphics): from the real state, the state is preserved
+    CHECK(nrd::GetQueueOwnershipTransfers(resourceSnapshot, graphics, compute, true, barriers) == 2);
+    CHECK(barriers[0].texture == input && barriers[1].texture == output);
+    CHECK(barriers[0].before.access == inputState.access && barriers[0].before.stages == inputState.stages);
+    CHECK(barriers[0].after.access == nri::AccessBits::NONE && barriers[0].after.stages == nri::StageBits::NONE);
+    CHECK(barriers[0].after.layout == inputState.layout);
+    CHECK(barriers[0].srcQueue == graphicsQueue && barriers[0].dstQueue == computeQueue);
+    CHECK(resourceSnapshot.unique[0].state.access == inputState.access);
+
+    // Acquire (compute): into compute shaders, access matches the layout
+    CHECK(nrd::GetQueueOwnershipTransfers(resourceSnapshot, graphics, compute, false, barriers) == 2);
+    CHECK(barriers[0].before.access == nri::AccessBits::NONE && barriers[0].before.stages == nri::StageBits::NONE);
+    CHECK(barriers[0].after.access == nri::AccessBits::SHADER_RESOURCE && barriers[0].after.stages == nri::StageBits::COMPUTE_SHADER);
+    CHECK(barriers[1].after.access == nri::AccessBits::SHADER_RESOURCE_STORAGE && barriers[1].after.stages == nri::StageBits::COMPUTE_SHADER);
+    CHECK(barriers[0].after.layout == inputState.layout && barriers[1].after.layout == outputState.layout);
+    CHECK(resourceSnapshot.unique[0].state.stages == nri::StageBits::COMPUTE_SHADER);
+    CHECK(resourceSnapshot.unique[1].state.access == nri::AccessBits::SHADER_RESOURCE_STORAGE);
+
+    // Release (compute): from the acquired state
+    CHECK(nrd::GetQueueOwnershipTransfers(resourceSnapshot, compute, graphics, true, barriers) == 2);
+    CHECK(barriers[0].before.stages == nri::StageBits::COMPUTE_SHADER);
+    CHECK(barriers[0].srcQueue == computeQueue && barriers[0].dstQueue == graphicsQueue);
+
+    // Acquire of a non-shader layout: no access and no stages, i.e. a valid pair for any layout
+    const nri::AccessLayoutStage copyState = {nri::AccessBits::COPY_SOURCE, nri::Layout::COPY_SOURCE, nri::StageBits::COPY};
+
+    nrd::ResourceSnapshot copySnapshot;
+    copySnapshot.SetResource(nrd::ResourceType::IN_MV, MakeResource(input, copyState));
+    CHECK(copySnapshot.uniqueNum == 1);
+
+    CHECK(nrd::GetQueueOwnershipTransfers(copySnapshot, graphics, compute, false, barriers) == 1);
+    CHECK(barriers[0].after.access == nri::AccessBits::NONE && barriers[0].after.stages == nri::StageBits::NONE);
+    CHECK(barriers[0].after.layout == nri::Layout::COPY_SOURCE);
+    CHECK(copySnapshot.unique[0].state.access == nri::AccessBits::NONE && copySnapshot.unique[0].state.layout == nri::Layout::COPY_SOURCE);
+}
+
+//========================================================================================================================================
+// DispatchEventRing / WriteDispatchEvents
+//========================================================================================================================================
+
+static void TestDispatchEvents() {
+    CHECK(nrd::DispatchEventRing::GetAlignedCapacity(0) == 0);
+    CHECK(nrd::DispatchEventRing::GetAlignedCapacity(3) == 4);
+    CHECK(nrd::DispatchEventRing::GetAlignedCapacity(4) == 4);
+
+    nrd::DispatchEventRing ring;
+    ring.Resize(3);
+    CHECK(ring.GetCapacity() == 4);
+
+    for (uint32_t i = 0; i < 5; i++) {
+        nrd::DispatchEvent* event = ring.BeginPush();
+        if (event) {
+            event->frameIndex = i;
+            ring.EndPush();
+        }
+    }
+    CHECK(ring.GetDroppedNum() == 1);
+
+    nrd::DispatchEvent events[4] = {};
+    CHECK(ring.Drain(events, 2) == 2);
+    CHECK(events[0].frameIndex == 0 && events[1].frameIndex == 1);
+
+    // Header + events, the header is written once
+    FILE* file = tmpfile();
+    CHECK(file != nullptr);
+    if (!file)
+        return;
+
+    CHECK(nrd::WriteDispatchEvents(file, events, 2));
+    CHECK(ring.Drain(events, 4) == 2);
+    CHECK(nrd::WriteDispatchEvents(file, events, 2));
+    CHECK(ftell(file) == long(sizeof(nrd::DispatchEventsFileHeader) + 4 * sizeof(nrd::DispatchEvent)));
+
+    rewind(file);
+    nrd::DispatchEventsFileHeader header = {};
+    CHECK(fread(&header, sizeof(header), 1, file) == 1);
+    CHECK(header.signature == NRD_DISPATCH_EVENTS_SIGNATURE && header.eventSize == sizeof(nrd::DispatchEvent));
+
+    nrd::DispatchEvent event = {};
+    uint32_t n = 0;
+    while (fread(&event, sizeof(event), 1, file) == 1)
+        CHECK(event.frameIndex == n++);
+    CHECK(n == 4);
+
+    fclose(file);
+}
+
+int main() {
+    TestRetirementQueue();
+    TestCalculatePlacement();
+    TestFillBindlessIndexTable();
+    TestGetQueueOwnershipTransfers();
+    TestDispatchEvents();
+
+    if (g_FailedNum)
+        printf("%u check(s) failed!\n", g_FailedNum);
+    else
+        printf("All checks passed\n");
+
+    return (int)g_FailedNum;
+}
@@ -0,0 +1,308 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Re-drives fresh instances from a trace, captured via "SetTraceCallback", verifies that dispatches match and reports per-call timings
+// Usage: NRDBenchmarkReplay <trace>
+
+#include "NRD.h"
+#include "NRDTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <vector>
+
+struct Stats {
+    double sum;
+    double max;
+    uint32_t num;
+};
+
+struct ReplayInstance {
+    nrd::Instance* instance;
+    bool isDeterministic; // constants depend on the internal timer if "timeDeltaBetweenFrames = 0"
+};
+
+const char* g_RecordNames[] = {
+    "BEGIN",
+    "CreateInstance",
+    "CloneInstance",
+    "DestroyInstance",
+    "SetCommonSettings",
+    "SetDenoiserSettings",
+    "SetDenoiserFeedback",
+    "GetComputeDispatches",
+    "RestartDenoiser",
+};
+static_assert(sizeof(g_RecordNames) / sizeof(g_RecordNames[0]) == (size_t)nrd::TraceRecord::MAX_NUM);
+
+template <typename T>
+static T Read(const uint8_t*& payload) {
+    T value;
+    memcpy(&value, payload, sizeof(T));
+    payload += sizeof(T);
+
+    return value;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("Usage: NRDBenchmarkReplay <trace>\n");
+        return 1;
+    }
+
+    // Load
+    FILE* file = fopen(argv[1], "rb");
+    if (!file) {
+        printf("Can't open '%s'!\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<uint8_t> trace;
+    uint8_t chunk[65536];
+    size_t chunkSize = 0;
+    while ((chunkSize = fread(chunk, 1, sizeof(chunk), file)) != 0)
+        trace.insert(trace.end(), chunk, chunk + chunkSize);
+
+    fclose(file);
+
+    // Replay
+    std::map<uint64_t, ReplayInstance> instances;
+    Stats stats[(size_t)nrd::TraceRecord::MAX_NUM] = {};
+    uint32_t mismatchNum = 0;
+    uint32_t skippedNum = 0;
+
+    alignas(16) nrd::CommonSettings commonSettings = {};
+    alignas(16) uint8_t denoiserSettings[4096];
+    std::vector<nrd::DenoiserDesc> denoiserDescs;
+    std::vector<nrd::Identifier> identifiers;
+
+    size_t offset = 0;
+    while (offset + sizeof(nrd::TraceRecordHeader) <= trace.size()) {
+        nrd::TraceRecordHeader header;
+        memcpy(&header, trace.data() + offset, sizeof(header));
+        offset += sizeof(header);
+
+        if (offset + header.size > trace.size() || (uint32_t)header.type >= (uint32_t)nrd::TraceRecord::MAX_NUM) {
+            printf("Trace is truncated or corrupted!\n");
+            return 1;
+        }
+
+        const uint8_t* payload = trace.data() + offset;
+        offset += header.size;
+
+        // Instance
+        ReplayInstance* replayInstance = nullptr;
+        if (header.type != nrd::TraceRecord::BEGIN && header.type != nrd::TraceRecord::CREATE_INSTANCE && header.type != nrd::TraceRecord::CLONE_INSTANCE) {
+            auto it = instances.find(header.instance);
+            if (it == instances.end()) {
+                skippedNum++; // created before recording started
+                continue;
+            }
+
+            replayInstance = &it->second;
+        }
+
+        nrd::Result expectedResult = nrd::Result::SUCCESS;
+        if (header.type != nrd::TraceRecord::BEGIN && header.type != nrd::TraceRecord::DESTROY_INSTANCE)
+            expectedResult = Read<nrd::Result>(payload);
+
+        // Call
+        nrd::Result result = nrd::Result::SUCCESS;
+        auto begin = std::chrono::high_resolution_clock::now();
+        auto end = begin;
+
+        switch (header.type) {
+            case nrd::TraceRecord::BEGIN: {
+                nrd::TraceBegin traceBegin = Read<nrd::TraceBegin>(payload);
+                if (traceBegin.signature != NRD_TRACE_SIGNATURE) {
+                    printf("Not an NRD trace!\n");
+                    return 1;
+                }
+
+                const nrd::LibraryDesc& libraryDesc = *nrd::GetLibraryDesc();
+                if (traceBegin.versionMajor != libraryDesc.versionMajor || traceBegin.versionMinor != libraryDesc.versionMinor || traceBegin.versionBuild != libraryDesc.versionBuild)
+                    printf("WARNING: trace is captured with NRD v%u.%u.%u, replaying with v%u.%u.%u\n", traceBegin.versionMajor, traceBegin.versionMinor, traceBegin.versionBuild, libraryDesc.versionMajor, libraryDesc.versionMinor, libraryDesc.versionBuild);
+            } break;
+
+            case nrd::TraceRecord::CREATE_INSTANCE: {
+                uint32_t denoisersNum = Read<uint32_t>(payload);
+                uint32_t enableSharedTileClassification = Read<uint32_t>(payload);
+
+                if (header.size != sizeof(nrd::Result) + sizeof(uint32_t) * 2 + denoisersNum * sizeof(nrd::DenoiserDesc)) {
+                    printf("'DenoiserDesc' size mismatch, the trace is captured with another NRD version!\n");
+                    return 1;
+                }
+
+                denoiserDescs.resize(denoisersNum);
+                memcpy(denoiserDescs.data(), payload, denoisersNum * sizeof(nrd::DenoiserDesc));
+
+                nrd::InstanceCreationDesc instanceCreationDesc = {};
+                instanceCreationDesc.denoisers = denoiserDescs.data();
+                instanceCreationDesc.denoisersNum = denoisersNum;
+                instanceCreationDesc.enableSharedTileClassification = enableSharedTileClassification != 0;
+
+                begin = std::chrono::high_resolution_clock::now();
+
+                nrd::Instance* instance = nullptr;
+                result = nrd::CreateInstance(instanceCreationDesc, instance);
+
+                if (instance)
+                    instances[header.instance] = {instance, false};
+            } break;
+
+            case nrd::TraceRecord::CLONE_INSTANCE: {
+                auto it = instances.find(Read<uint64_t>(payload));
+                if (it == instances.end()) {
+                    skippedNum++;
+                    continue;
+                }
+
+                begin = std::chrono::high_resolution_clock::now();
+
+                nrd::Instance* clone = nullptr;
+                result = nrd::CloneInstance(*it->second.instance, clone);
+
+                if (clone)
+                    instances[header.instance] = {clone, false};
+            } break;
+
+            case nrd::TraceRecord::DESTROY_INSTANCE: {
+                nrd::DestroyInstance(*replayInstance->instance);
+                instances.erase(header.instance);
+            } break;
+
+            case nrd::TraceRecord::SET_COMMON_SETTINGS: {
+                if (header.size != sizeof(nrd::Result) + sizeof(commonSettings)) {
+                    printf("'CommonSettings' size mismatch, the trace is captured with another NRD version!\n");
+                    return 1;
+                }
+
+                memcpy(&commonSettings, payload, sizeof(commonSettings));
+                replayInstance->isDeterministic = commonSettings.timeDeltaBetweenFrames > 0.0f;
+
+                begin = std::chrono::high_resolution_clock::now();
+
+                result = nrd::SetCommonSettings(*replayInstance->instance, commonSettings);
+            } break;
+
+            case nrd::TraceRecord::SET_DENOISER_SETTINGS: {
+                nrd::Identifier identifier = Read<nrd::Identifier>(payload);
+
+                size_t settingsSize = header.size - sizeof(nrd::Result) - sizeof(identifier);
+                if (settingsSize > sizeof(denoiserSettings)) {
+                    printf("Unexpected denoiser settings size!\n");
+                    return 1;
+                }
+
+                memcpy(denoiserSettings, payload, settingsSize);
+
+                begin = std::chrono::high_resolution_clock::now();
+
+                result = nrd::SetDenoiserSettings(*replayInstance->instance, identifier, denoiserSettings);
+            } break;
+
+            case nrd::TraceRecord::SET_DENOISER_FEEDBACK: {
+                nrd::Identifier identifier = Read<nrd::Identifier>(payload);
+                uint32_t activeTileNum = Read<uint32_t>(payload);
+
+                begin = std::chrono::high_resolution_clock::now();
+
+                result = nrd::SetDenoiserFeedback(*replayInstance->instance, identifier, activeTileNum);
+            } break;
+
+            case nrd::TraceRecord::RESTART_DENOISER: {
+                nrd::Identifier identifier = Read<nrd::Identifier>(payload);
+
+                begin = std::chrono::high_resolution_clock::now();
+
+                result = nrd::RestartDenoiser(*replayInstance->instance, identifier);
+            } break;
+
+            case nrd::TraceRecord::GET_COMPUTE_DISPATCHES: {
+                uint32_t identifiersNum = Read<uint32_t>(payload);
+
+                identifiers.resize(identifiersNum);
+                memcpy(identifiers.data(), payload, identifiersNum * sizeof(nrd::Identifier));
+                payload += identifiersNum * sizeof(nrd::Identifier);
+
+                begin = std::chrono::high_resolution_clock::now();
+
+                const nrd::DispatchDesc* dispatchDescs = nullptr;
+                uint32_t dispatchDescsNum = 0;
+                result = nrd::GetComputeDispatches(*replayInstance->instance, identifiers.data(), identifiersNum, dispatchDescs, dispatchDescsNum);
+
+                end = std::chrono::high_resolution_clock::now(); // timing excludes verification
+
+                // Verify
+                uint32_t expectedDispatchDescsNum = Read<uint32_t>(payload);
+                if (result != nrd::Result::SUCCESS)
+                    dispatchDescsNum = 0;
+
+                if (dispatchDescsNum != expectedDispatchDescsNum) {
+                    printf("GetComputeDispatches #%u: %u dispatches instead of %u\n", stats[(size_t)header.type].num, dispatchDescsNum, expectedDispatchDescsNum);
+                    mismatchNum++;
+                } else {
+                    for (uint32_t i = 0; i < dispatchDescsNum; i++) {
+                        nrd::TraceDispatch expected = Read<nrd::TraceDispatch>(payload);
+                        nrd::TraceDispatch actual = nrd::GetTraceDispatch(dispatchDescs[i]);
+
+                        bool isMatched = actual.topologyHash == expected.topologyHash;
+                        if (replayInstance->isDeterministic)
+                            isMatched = isMatched && actual.constantsHash == expected.constantsHash;
+
+                        if (!isMatched) {
+                            printf("GetComputeDispatches #%u: dispatch %u ('%s') doesn't match\n", stats[(size_t)header.type].num, i, dispatchDescs[i].name ? dispatchDescs[i].name : "");
+                            mismatchNum++;
+                        }
+                    }
+                }
+            } break;
+
+            default:
+                break;
+        }
+
+        if (end == begin)
+            end = std::chrono::high_resolution_clock::now();
+
+        double time = std::chrono::duration<double, std::micro>(end - begin).count();
+
+        if (result != expectedResult) {
+            printf("%s #%u: result %u instead of %u\n", g_RecordNames[(size_t)header.type], stats[(size_t)header.type].num, (uint32_t)result, (uint32_t)expectedResult);
+            mismatchNum++;
+        }
+
+        Stats& s = stats[(size_t)header.type];
+        s.sum += time;
+        s.max = std::max(s.max, time);
+        s.num++;
+    }
+
+    for (auto& it : instances)
+        nrd::DestroyInstance(*it.second.instance);
+
+    // Report
+    printf("\n%-24s %10s %12s %12s\n", "Call", "num", "avg (us)", "max (us)");
+    for (size_t i = 1; i < (size_t)nrd::TraceRecord::MAX_NUM; i++) {
+        const Stats& s = stats[i];
+        if (s.num)
+            printf("%-24s %10u %12.2f %12.2f\n", g_RecordNames[i], s.num, s.sum / s.num, s.max);
+    }
+
+    if (skippedNum)
+        printf("\n%u records skipped (instances created before recording started)\n", skippedNum);
+
+    printf("\n%s: %u mismatches\n", mismatchNum ? "FAILED" : "PASSED", mismatchNum);
+
+    return mismatchNum ? 1 : 0;
+}
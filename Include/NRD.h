@@ -37,9 +37,9 @@ Special thanks:
 #include <cstddef>
 
 #define NRD_VERSION_MAJOR 4
-#define NRD_VERSION_MINOR 17
-#define NRD_VERSION_BUILD 4
-#define NRD_VERSION_DATE "17 August 2026"
+#define NRD_VERSION_MINOR 18
+#define NRD_VERSION_BUILD 0
+#define NRD_VERSION_DATE "18 October 2026"
 
 #if defined(_WIN32)
     #define NRD_CALL __stdcall
@@ -60,6 +60,11 @@ namespace nrd
     NRD_API Result NRD_CALL CreateInstance(const InstanceCreationDesc& instanceCreationDesc, Instance*& instance);
     NRD_API void NRD_CALL DestroyInstance(Instance& instance);
 
+    // (Optional) Creates an instance with the same denoisers, sharing immutable tables (pipelines, dispatches, pools) with "instance", which is much
+    // cheaper than "CreateInstance". Denoiser settings are inherited, the per-frame state is not. Textures are not shared, i.e. a clone needs its own pools.
+    // Instances can be destroyed in any order
+    NRD_API Result NRD_CALL CloneInstance(const Instance& instance, Instance*& clone);
+
     // Get
     NRD_API const LibraryDesc* NRD_CALL GetLibraryDesc();
     NRD_API const InstanceDesc* NRD_CALL GetInstanceDesc(const Instance& instance);
@@ -70,10 +75,24 @@ namespace nrd
     // Typically needs to be called at least once per denoiser (not necessarily on each frame)
     NRD_API Result NRD_CALL SetDenoiserSettings(Instance& instance, Identifier identifier, const void* denoiserSettings);
 
+    // (Optional) Reports the number of non-sky tiles found by the tile classification pass of a denoiser (REBLUR, RELAX and SIGMA only).
+    // Expected to be called once per frame, the data can be a few frames old (see "CommonSettings::emptyFrameNumToSkipDenoiser")
+    NRD_API Result NRD_CALL SetDenoiserFeedback(Instance& instance, Identifier identifier, uint32_t activeTileNum);
+
+    // (Optional) "AccumulationMode::CLEAR_AND_RESTART" for a single denoiser: history of the denoiser gets cleared by the next "GetComputeDispatches"
+    // call requesting it. Needed if history textures of the denoiser have been (re)created, while other denoisers keep accumulating
+    NRD_API Result NRD_CALL RestartDenoiser(Instance& instance, Identifier identifier);
+
     // Retrieves dispatches for the list of identifiers (if they are parts of the instance)
     // IMPORTANT: returned memory is owned by the "instance" and will be overwritten by the next "GetComputeDispatches" call
     NRD_API Result NRD_CALL GetComputeDispatches(Instance& instance, const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
 
+    // (Optional) Records API calls of all instances into a binary stream (see "NRDTrace.h"), which can be replayed offline by "NRDBenchmarkReplay".
+    // "nullptr" stops recording. Thread safe: records of concurrent calls don't interleave and the previous callback is not used once
+    // "SetTraceCallback" returns. The callback is called under a lock, i.e. it must not call NRD functions
+    typedef void (NRD_CALL *TraceWriteCallback)(void* userArg, const void* data, size_t size);
+    NRD_API void NRD_CALL SetTraceCallback(TraceWriteCallback callback, void* userArg);
+
     // Helpers
     NRD_API const char* GetResourceTypeString(ResourceType resourceType);
     NRD_API const char* GetDenoiserString(Denoiser denoiser);
@@ -11,7 +11,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #pragma once
 
 #define NRD_DESCS_VERSION_MAJOR 4
-#define NRD_DESCS_VERSION_MINOR 17
+#define NRD_DESCS_VERSION_MINOR 18
 
 static_assert(NRD_VERSION_MAJOR == NRD_DESCS_VERSION_MAJOR && NRD_VERSION_MINOR == NRD_DESCS_VERSION_MINOR, "Please, update all NRD SDK files");
 
@@ -373,6 +373,43 @@ namespace nrd
         MAX_NUM
     };
 
+    // Class of a pool texture, which can be used by the app to apply a per-class policy (i.e. precision)
+    enum class TextureClass : uint8_t
+    {
+        // Transient data and permanent textures, which must be kept "as is"
+        OTHER,
+
+        // Accumulated signal history
+        HISTORY,
+
+        // Fast (responsive) history
+        FAST_HISTORY,
+
+        // Previous frame geometry
+        PREV_VIEWZ,
+        PREV_NORMAL_ROUGHNESS,
+
+        // Internal data: accumulation speeds, history lengths, material IDs, hit distances for tracking...
+        INTERNAL_DATA,
+
+        MAX_NUM
+    };
+
+    // Type of a pipeline, which can be used by the app to identify passes needing special handling
+    enum class PipelineType : uint8_t
+    {
+        // Denoising
+        DEFAULT,
+
+        // History clear (see "AccumulationMode::CLEAR_AND_RESTART"), outputs are cleared textures
+        CLEAR,
+
+        // Tile classification, the only output is the tiles texture (see "SetDenoiserFeedback")
+        CLASSIFY_TILES,
+
+        MAX_NUM
+    };
+
     struct AllocationCallbacks
     {
         void* (NRD_CALL *Allocate)(void* userArg, size_t size, size_t alignment);
@@ -405,6 +442,12 @@ namespace nrd
     {
         Identifier identifier;
         Denoiser denoiser;
+
+        // (Optional) REBLUR_DIFFUSE only: temporal accumulation, history fix and blurs run at half resolution with half resolution history,
+        // followed by a depth and normal aware upsample into "OUT_DIFF_RADIANCE_HITDIST" (reduces memory and compute ~4x for low frequency
+        // diffuse signals). Inputs and outputs stay at full resolution. Not compatible with checkerboard, "IN_DIFF_CONFIDENCE",
+        // "IN_DISOCCLUSION_THRESHOLD_MIX" (ignored) and validation (skipped)
+        bool enableHalfResolution;
     };
 
     struct InstanceCreationDesc
@@ -412,12 +455,17 @@ namespace nrd
         AllocationCallbacks allocationCallbacks;
         const DenoiserDesc* denoisers;
         uint32_t denoisersNum;
+
+        // (Optional) REBLUR and RELAX denoisers of the instance share "viewZ"-based tile classification,
+        // i.e. it's done once per "GetComputeDispatches" call instead of once per denoiser
+        bool enableSharedTileClassification;
     };
 
     struct TextureDesc
     {
         Format format;
         uint16_t downsampleFactor;
+        TextureClass textureClass;
     };
 
     struct ResourceDesc
@@ -450,6 +498,9 @@ namespace nrd
         // Hint that pipeline has a constant buffer with shared parameters from "InstanceDesc"
         bool hasConstantData;
 
+        // Passes needing special handling are marked explicitly, i.e. parsing "shaderIdentifier" is not needed
+        PipelineType type;
+
         // Format: "fileName|macro1=value1|macro2=value2..." (useful for custom integrations)
         char shaderIdentifier[256];
     };
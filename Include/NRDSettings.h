@@ -11,7 +11,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #pragma once
 
 #define NRD_SETTINGS_VERSION_MAJOR 4
-#define NRD_SETTINGS_VERSION_MINOR 17
+#define NRD_SETTINGS_VERSION_MINOR 18
 
 static_assert(NRD_VERSION_MAJOR == NRD_SETTINGS_VERSION_MAJOR && NRD_VERSION_MINOR == NRD_SETTINGS_VERSION_MINOR, "Please, update all NRD SDK files");
 
@@ -192,6 +192,20 @@ namespace nrd
 
         // Enables REBLUR / RELAX debug overlay (see "ResourceType::OUT_VALIDATION")
         bool enableValidation = false;
+
+        // (Optional) (frames, 0 - disabled) a denoiser, which had no active tiles (see "SetDenoiserFeedback") for this number of consecutive
+        // frames, gets reduced to its tile classification pass ("probe"). Outputs are not written while skipped, history gets cleared on resume.
+        // Since the feedback is a few frames old, newly appeared content stays not denoised for these frames. Ignored if "enableValidation = true"
+        uint32_t emptyFrameNumToSkipDenoiser = 0;
+
+        // (App-driven freeze) Set to "true" only if the app knows that the signal doesn't change while the camera is static, i.e. no
+        // lighting, material, animation or object changes. NRD doesn't inspect signal inputs, the app must set it to "false" on any such
+        // change. If "true" a converged denoiser gets reduced to its tile classification pass ("probe") while the camera is static, i.e.
+        // "OUT_*" textures are not written and must be preserved by the app. Converged means being fed with static inputs for more than
+        // "max accumulated frame num" frames. Denoising also resumes on a change in "CommonSettings" (apart from "frameIndex", jitter and
+        // time delta), denoiser settings or in the number of active tiles (see "SetDenoiserFeedback"). Not applied to SIGMA if
+        // "SigmaSettings::maxStabilizedFrameNum = 0" and REFERENCE
+        bool isSceneStatic = false;
     };
 
     //====================================================================================================================================================
@@ -278,7 +292,8 @@ namespace nrd
         // [0; maxFastAccumulatedFrameNum) - number of reconstructed frames after history reset
         uint32_t historyFixFrameNum = 3;
 
-        // (> 0) - base stride between pixels in 5x5 history reconstruction kernel
+        // (> 0) - base stride between pixels in 5x5 history reconstruction kernel. Unlike RELAX, there is no mip-based alternative (see
+        // "RelaxSettings::enableMipBasedHistoryFix"): strides and weights depend on hit distance and material ID of each sample
         uint32_t historyFixBasePixelStride = 14;
         uint32_t historyFixAlternatePixelStride = 14; // see "historyFixAlternatePixelStrideMaterialID"
 
@@ -416,6 +431,13 @@ namespace nrd
         // [2; 8] - number of iterations for A-Trous wavelet transform
         uint32_t atrousIterationNum = 5;
 
+        // [1; 8] - number of A-Trous iterations always executed by converged tiles (see "atrousConvergenceThreshold")
+        uint32_t atrousConvergedIterationNum = 3;
+
+        // (>= 0) - relative standard deviation of luminance below which an 8x8 tile is considered converged after the first A-Trous iteration,
+        // converged tiles pass the signal through in later iterations (0 - disabled)
+        float atrousConvergenceThreshold = 0.0f;
+
         // [0; 1] - A-trous edge stopping Luminance weight minimum
         float diffuseMinLuminanceWeight = 0.0f;
         float specularMinLuminanceWeight = 0.0f;
@@ -450,6 +472,12 @@ namespace nrd
 
         // Roughness based rejection
         bool enableRoughnessEdgeStopping = true;
+
+        // (Optional) history reconstruction samples a small radiance / viewZ pyramid (downsampled by 2, 4, 8 and 16), built from the output of
+        // temporal accumulation, instead of wide strided 5x5 taps. The level is chosen from the history length. Fewer and coherent fetches,
+        // but no normal and material ID checks at the sample side. Radiance denoisers only: "SetDenoiserSettings" returns "INVALID_ARGUMENT"
+        // for SH denoisers (the pyramid doesn't carry SH data). REBLUR has no such mode (see "ReblurSettings::historyFixBasePixelStride")
+        bool enableMipBasedHistoryFix = false;
     };
 
     //====================================================================================================================================================
@@ -0,0 +1,123 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Binary trace format, produced by the recorder enabled via "SetTraceCallback" and consumed by "Benchmark/Replay.cpp"
+
+#pragma once
+
+#include "NRD.h"
+
+#define NRD_TRACE_SIGNATURE 0x5444524E // "NRDT"
+
+namespace nrd
+{
+    // A trace is a sequence of records: "TraceRecordHeader" followed by "size" bytes of payload
+    enum class TraceRecord : uint32_t
+    {
+        // TraceBegin
+        BEGIN,
+
+        // Result, uint32_t denoisersNum, uint32_t enableSharedTileClassification, DenoiserDesc[denoisersNum]
+        CREATE_INSTANCE,
+
+        // Result, uint64_t sourceInstance
+        CLONE_INSTANCE,
+
+        // (no payload)
+        DESTROY_INSTANCE,
+
+        // Result, CommonSettings
+        SET_COMMON_SETTINGS,
+
+        // Result, Identifier, settings (the rest of the payload)
+        SET_DENOISER_SETTINGS,
+
+        // Result, Identifier, uint32_t activeTileNum
+        SET_DENOISER_FEEDBACK,
+
+        // Result, uint32_t identifiersNum, Identifier[identifiersNum], uint32_t dispatchDescsNum, TraceDispatch[dispatchDescsNum]
+        GET_COMPUTE_DISPATCHES,
+
+        // Result, Identifier
+        RESTART_DENOISER,
+
+        MAX_NUM
+    };
+
+    struct TraceRecordHeader
+    {
+        TraceRecord type;
+        uint32_t size; // of the payload
+        uint64_t instance; // address of the instance at capture time, used only as a key
+    };
+
+    struct TraceBegin
+    {
+        uint32_t signature;
+        uint8_t versionMajor;
+        uint8_t versionMinor;
+        uint8_t versionBuild;
+        uint8_t padding;
+    };
+
+    struct TraceDispatch
+    {
+        uint64_t topologyHash; // name, identifier, pipeline, grid size and resources
+        uint64_t constantsHash; // constant buffer data (depends on the internal timer if "CommonSettings::timeDeltaBetweenFrames = 0")
+    };
+
+    // FNV-1a
+    inline uint64_t TraceHash(uint64_t hash, const void* data, size_t size)
+    {
+        const uint8_t* bytes = (const uint8_t*)data;
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+
+        return hash;
+    }
+
+    inline TraceDispatch GetTraceDispatch(const DispatchDesc& dispatchDesc)
+    {
+        const uint64_t offset = 14695981039346656037ull;
+
+        // Field by field to skip padding
+        uint64_t hash = offset;
+        if (dispatchDesc.name)
+        {
+            for (const char* s = dispatchDesc.name; *s; s++)
+                hash = TraceHash(hash, s, 1);
+        }
+        hash = TraceHash(hash, &dispatchDesc.identifier, sizeof(dispatchDesc.identifier));
+        hash = TraceHash(hash, &dispatchDesc.pipelineIndex, sizeof(dispatchDesc.pipelineIndex));
+        hash = TraceHash(hash, &dispatchDesc.gridWidth, sizeof(dispatchDesc.gridWidth));
+        hash = TraceHash(hash, &dispatchDesc.gridHeight, sizeof(dispatchDesc.gridHeight));
+        hash = TraceHash(hash, &dispatchDesc.resourcesNum, sizeof(dispatchDesc.resourcesNum));
+        for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++)
+        {
+            const ResourceDesc& resource = dispatchDesc.resources[i];
+            hash = TraceHash(hash, &resource.descriptorType, sizeof(resource.descriptorType));
+            hash = TraceHash(hash, &resource.type, sizeof(resource.type));
+            hash = TraceHash(hash, &resource.indexInPool, sizeof(resource.indexInPool));
+        }
+
+        TraceDispatch traceDispatch = {};
+        traceDispatch.topologyHash = hash;
+
+        hash = offset;
+        hash = TraceHash(hash, &dispatchDesc.constantBufferDataSize, sizeof(dispatchDesc.constantBufferDataSize));
+        hash = TraceHash(hash, &dispatchDesc.constantBufferDataMatchesPreviousDispatch, sizeof(dispatchDesc.constantBufferDataMatchesPreviousDispatch));
+        if (dispatchDesc.constantBufferData)
+            hash = TraceHash(hash, dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
+
+        traceDispatch.constantsHash = hash;
+
+        return traceDispatch;
+    }
+}
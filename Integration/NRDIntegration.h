@@ -27,6 +27,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #    error "Extensions/NRIHelper.h" is not included
 #endif
 
+#include "NRDIntegrationEvents.h"
+
 // Debugging
 #ifdef NRD_INTEGRATION_DEBUG_LOGGING
 #    include <stdio.h>
@@ -42,8 +44,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #endif
 
 // NRI-based NRD integration layer
-#define NRD_INTEGRATION_VERSION 22
-#define NRD_INTEGRATION_DATE "6 April 2026"
+#define NRD_INTEGRATION_VERSION 23
+#define NRD_INTEGRATION_DATE "18 October 2026"
 
 namespace nrd {
 
@@ -54,7 +56,7 @@ namespace nrd {
 // For "Recreate" and "Denoise"
 struct TextureNRI {
     nri::Texture* texture;
-    uint32_t dummy;
+    uint32_t dummy[2]; // zeroes optional members of other "Texture*" structs
 };
 
 // For "RecreateD3D11" and "DenoiseD3D11"
@@ -78,6 +80,8 @@ struct TextureD3D12 {
 struct TextureVK {
     VKNonDispatchableHandle image;
     VKEnum format;
+    uint16_t width; // (optional) real dimensions, 0 - "IntegrationCreationDesc::resourceWidth / resourceHeight"
+    uint16_t height;
 };
 #endif
 
@@ -170,6 +174,92 @@ struct ResourceSnapshot {
 // Integration instance
 //===================================================================================================
 
+// Precision policy for a texture class (see "TextureClass")
+enum class Precision : uint8_t {
+    // Keep the format requested by NRD ("demoteFloat32to16" and "promoteFloat16to32" still apply)
+    DEFAULT,
+
+    // FP32 => FP16, UNORM/SNORM 16-bit => 8-bit
+    DEMOTE,
+
+    // FP16 => FP32, UNORM/SNORM 8-bit => 16-bit
+    PROMOTE,
+};
+
+inline Format GetFormatWithPrecision(Format format, Precision precision) {
+    if (precision == Precision::DEMOTE) {
+        switch (format) {
+            case Format::R16_UNORM: return Format::R8_UNORM;
+            case Format::R16_SNORM: return Format::R8_SNORM;
+            case Format::RG16_UNORM: return Format::RG8_UNORM;
+            case Format::RG16_SNORM: return Format::RG8_SNORM;
+            case Format::RGBA16_UNORM: return Format::RGBA8_UNORM;
+            case Format::RGBA16_SNORM: return Format::RGBA8_SNORM;
+            case Format::R32_SFLOAT: return Format::R16_SFLOAT;
+            case Format::RG32_SFLOAT: return Format::RG16_SFLOAT;
+            case Format::RGBA32_SFLOAT: return Format::RGBA16_SFLOAT;
+            default: return format;
+        }
+    } else if (precision == Precision::PROMOTE) {
+        switch (format) {
+            case Format::R8_UNORM: return Format::R16_UNORM;
+            case Format::R8_SNORM: return Format::R16_SNORM;
+            case Format::RG8_UNORM: return Format::RG16_UNORM;
+            case Format::RG8_SNORM: return Format::RG16_SNORM;
+            case Format::RGBA8_UNORM: return Format::RGBA16_UNORM;
+            case Format::RGBA8_SNORM: return Format::RGBA16_SNORM;
+            case Format::R16_SFLOAT: return Format::R32_SFLOAT;
+            case Format::RG16_SFLOAT: return Format::RG32_SFLOAT;
+            case Format::RGBA16_SFLOAT: return Format::RGBA32_SFLOAT;
+            default: return format;
+        }
+    }
+
+    return format;
+}
+
+//===================================================================================================
+// Bindless
+//===================================================================================================
+
+// Must match "NRD_BINDLESS_*" in "NRD.hlsli"
+constexpr uint32_t BINDLESS_TABLE_REGISTER_INDEX = 1;
+constexpr uint32_t BINDLESS_TEXTURES_MAX_NUM = 32;
+constexpr uint32_t BINDLESS_STORAGE_TEXTURES_MAX_NUM = 16;
+constexpr uint32_t BINDLESS_TABLE_SIZE = BINDLESS_TEXTURES_MAX_NUM + BINDLESS_STORAGE_TEXTURES_MAX_NUM;
+
+// The per-dispatch table of descriptor heap indices replaces descriptor sets: "NRD_INPUT( ..., bindingIndex )" reads
+// "table[bindingIndex]", "NRD_OUTPUT( ..., bindingIndex )" reads "table[BINDLESS_TEXTURES_MAX_NUM + bindingIndex]".
+// "heapIndices" must have an entry for each "dispatchDesc.resources" entry. Unused table entries are left untouched
+inline bool FillBindlessIndexTable(const PipelineDesc& pipelineDesc, const DispatchDesc& dispatchDesc, const uint32_t* heapIndices, uint32_t* table) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < pipelineDesc.resourceRangesNum; i++) {
+        const ResourceRangeDesc& resourceRange = pipelineDesc.resourceRanges[i];
+        const bool isStorage = resourceRange.descriptorType == DescriptorType::STORAGE_TEXTURE;
+
+        uint32_t baseSlot = isStorage ? BINDLESS_TEXTURES_MAX_NUM : 0;
+        uint32_t slotMaxNum = isStorage ? BINDLESS_STORAGE_TEXTURES_MAX_NUM : BINDLESS_TEXTURES_MAX_NUM;
+        if (resourceRange.descriptorsNum > slotMaxNum || n + resourceRange.descriptorsNum > dispatchDesc.resourcesNum)
+            return false;
+
+        for (uint32_t j = 0; j < resourceRange.descriptorsNum; j++)
+            table[baseSlot + j] = heapIndices[n++];
+    }
+
+    return n == dispatchDesc.resourcesNum;
+}
+
+// The app owns the descriptor heap (must be bound via "CmdSetDescriptorPool" before "Denoise")
+struct BindlessDesc {
+    // Returns an index of a texture view (SRV if "isStorage = false", UAV otherwise) in the app's descriptor heap
+    uint32_t (*GetDescriptorHeapIndex)(void* userArg, nri::Texture& texture, bool isStorage);
+
+    // Provides a compute shader compiled with "NRD_BINDLESS" defined (SM 6.6+) for "pipelineDesc.shaderIdentifier"
+    bool (*GetBindlessShader)(void* userArg, const PipelineDesc& pipelineDesc, nri::ShaderDesc& shaderDesc);
+
+    void* userArg;
+};
+
 struct IntegrationCreationDesc {
     // Not so long name
     char name[64] = "";
@@ -196,6 +286,11 @@ struct IntegrationCreationDesc {
     // Wait for idle on GRAPHICS/COMPUTE queues in mandatory places (for lazy people)
     bool autoWaitForIdle = true;
 
+    // true - "Recreate" (on the same device), "RecreatePipelines" and "DestroyCachedDescriptors" don't wait for idle:
+    //        old objects get retired and destroyed "queuedFrameNum" frames later (i.e. "NewFrame" must keep being called),
+    //        while new objects are created alongside. "Destroy" still waits for idle (if "autoWaitForIdle = true")
+    bool enableDeferredDestruction = false;
+
     // Demote FP32 to FP16 (slightly improves performance in exchange of precision loss)
     // (FP32 is used only for viewZ under the hood, all denoisers are FP16 compatible)
     bool demoteFloat32to16 = false;
@@ -203,8 +298,322 @@ struct IntegrationCreationDesc {
     // Promote FP16 to FP32 (overkill, kills performance)
     bool promoteFloat16to32 = false;
 
-    // TODO: there can be an option for UNORM/SNORM 8/16-bit promotion/demotion, but only for resources
-    // marked as history (i.e. not normal-roughness and internal data resources)
+    // Per texture class precision policy, indexed by "TextureClass" (overrides the options above for non-"DEFAULT" entries):
+    //  - "TextureClass::OTHER" must be "DEFAULT"
+    //  - demoting "HISTORY" and "FAST_HISTORY" saves memory and bandwidth in exchange of some banding in dark areas
+    //  - demoting "PREV_NORMAL_ROUGHNESS" and "INTERNAL_DATA" is unrecommended
+    Precision precisionPolicy[(size_t)TextureClass::MAX_NUM] = {};
+
+    // false - all pool textures are created in "Recreate"
+    // true - pool textures are created on first use in "Denoise", i.e. denoisers, which are never requested, don't
+    //        consume memory. History of a denoiser, which textures get (re)created, is cleared under the hood (see "RestartDenoiser").
+    //        If a texture can't be created, dispatches of the denoiser get skipped (creation is retried on the next "Denoise")
+    bool enableLazyResourceAllocation = false;
+
+    // (Optional) if "enableLazyResourceAllocation = true", textures of denoisers not requested for the specified
+    // number of frames get released (0 - never). Released textures are destroyed "queuedFrameNum" frames later
+    uint32_t unusedResourceReleaseFrameNum = 0;
+
+    // true - transient pool textures are placed into a single heap at deterministic offsets, i.e. the heap can be
+    //        aliased by the app outside of "Denoise" (see "GetTransientPoolHeapDesc"). Not compatible with "enableLazyResourceAllocation"
+    bool placeTransientPoolInHeap = false;
+
+    // true - (needs "placeTransientPoolInHeap = true") the heap is not allocated by the integration: the app must provide
+    //        memory via "BindTransientPoolMemory" after each "Recreate" and before the first "Denoise"
+    bool isTransientPoolMemoryExternal = false;
+
+    // true - descriptor sets of dispatches referencing only pool textures are built once (per ping-pong parity) and reused
+    //        across frames, i.e. only dispatches with "IN_*" / "OUT_*" resources allocate and update descriptor sets each frame
+    bool enablePersistentDescriptorSets = false;
+
+    // true - no descriptor sets: textures are fetched by shaders from the app's descriptor heap using per-dispatch index tables
+    //        streamed via the constant buffer (see "BindlessDesc"). Shaders must be compiled by the app
+    bool enableBindless = false;
+    BindlessDesc bindlessDesc = {};
+
+    // true - tiles produced by tile classification passes get read back and reported via "SetDenoiserFeedback" "queuedFrameNum"
+    //        frames later, i.e. "CommonSettings::emptyFrameNumToSkipDenoiser" can be used (costs a tiny copy per denoiser per frame)
+    bool enableTileFeedback = false;
+
+    // true - "resourceWidth / resourceHeight" are upper bounds: pools get allocated at this size once, while "CommonSettings::resourceSize"
+    //        becomes a runtime sub-region, which can change (window resize, upscaler mode switch) without "Recreate". History is kept and
+    //        resampled, since under the hood a sub-region change is a "rectSize" change. IMPORTANT: all "IN_*" / "OUT_*" textures must
+    //        be allocated at the upper bound too, only the top-left "resourceSize" region is used. It's validated in "PrepareDenoise",
+    //        denoising gets skipped if a texture is smaller. For "DenoiseVK" provide real dimensions in "TextureVK"
+    bool enableDynamicResourceSize = false;
+
+    // (Optional) capacity of the preallocated per-dispatch event ring (0 - disabled, rounded up to a power of 2). Events
+    // ("DispatchEvent") are recorded in any build config and must be drained via "DrainDispatchEvents", otherwise new ones get dropped.
+    // The ring and not drained events survive "Recreate" with the same (rounded) capacity. A different capacity reallocates the ring,
+    // i.e. draining must be stopped during such "Recreate". Use "WriteDispatchEvents" to save drained events for offline tools
+    uint32_t dispatchEventRingSize = 0;
+};
+
+//===================================================================================================
+// Placement
+//===================================================================================================
+
+struct PlacementRequirements {
+    uint64_t size;
+    uint32_t alignment; // power of 2
+};
+
+// Deterministic placement into a single heap: resources are placed in order, each at an offset aligned to its alignment.
+// Returns the heap size, "heapAlignment" is the strictest alignment (i.e. the heap base offset must be aligned to it)
+inline uint64_t CalculatePlacement(const PlacementRequirements* requirements, uint32_t requirementsNum, uint64_t* offsets, uint32_t& heapAlignment) {
+    uint64_t heapSize = 0;
+    heapAlignment = 1;
+
+    for (uint32_t i = 0; i < requirementsNum; i++) {
+        uint32_t alignment = requirements[i].alignment ? requirements[i].alignment : 1;
+
+        heapSize = (heapSize + alignment - 1) / alignment * alignment;
+        offsets[i] = heapSize;
+
+        heapSize += requirements[i].size;
+        heapAlignment = alignment > heapAlignment ? alignment : heapAlignment;
+    }
+
+    return heapSize;
+}
+
+// Transient pool heap
+struct TransientPoolHeapDesc {
+    nri::Memory* memory;        // "nullptr" until memory is bound
+    uint64_t offset;            // offset of the transient pool in "memory"
+    uint64_t size;              // requested size (at "offset")
+    uint32_t alignment;         // required alignment of "offset"
+    nri::MemoryType memoryType; // needed for external allocations
+};
+
+//===================================================================================================
+// Descriptor set signature
+//===================================================================================================
+
+// A descriptor set, which references only pool textures, is fully described by the resource layout of the pipeline and
+// pool indices (after ping-pong swaps). Returns signature size ("pipelineDesc.resourceRangesNum + dispatchDesc.resourcesNum")
+// or 0 if a resource provided by the app is referenced
+inline uint32_t GetDescriptorSetSignature(const PipelineDesc& pipelineDesc, const DispatchDesc& dispatchDesc, uint32_t* signature) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < pipelineDesc.resourceRangesNum; i++) {
+        const ResourceRangeDesc& resourceRange = pipelineDesc.resourceRanges[i];
+        signature[n++] = (uint32_t(resourceRange.descriptorType) << 16) | resourceRange.descriptorsNum;
+    }
+
+    for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++) {
+        const ResourceDesc& resourceDesc = dispatchDesc.resources[i];
+        if (resourceDesc.type != ResourceType::PERMANENT_POOL && resourceDesc.type != ResourceType::TRANSIENT_POOL)
+            return 0;
+
+        signature[n++] = (resourceDesc.type == ResourceType::PERMANENT_POOL ? 0x80000000 : 0) | resourceDesc.indexInPool;
+    }
+
+    return n;
+}
+
+// FNV-1a
+inline uint64_t HashDescriptorSetSignature(const uint32_t* signature, uint32_t signatureSize) {
+    uint64_t hash = 14695981039346656037ull;
+    for (uint32_t i = 0; i < signatureSize; i++) {
+        hash ^= signature[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+//===================================================================================================
+// Multithreaded recording
+//===================================================================================================
+
+// A contiguous range of dispatches, which can be recorded into a separate (secondary) command buffer.
+// "transitions" are the barriers of the first dispatch of the chunk, i.e. the ones stitching it with the previous chunk
+// (read-only, for diagnostics: they are always recorded by "RecordDenoiseChunk", i.e. recording them again is redundant)
+struct DenoiseChunkDesc {
+    const nri::TextureBarrierDesc* transitions;
+    uint32_t transitionNum;
+    uint32_t dispatchOffset;
+    uint32_t dispatchNum;
+};
+
+// Splits dispatches into up to "chunkMaxNum" chunks of roughly equal size. Splits happen at denoiser boundaries
+// if there are enough denoisers, otherwise at any dispatch boundary. "chunkOffsets" must have "chunkMaxNum + 1" entries,
+// chunk "i" covers [chunkOffsets[i]; chunkOffsets[i + 1]). Returns the number of chunks
+inline uint32_t PartitionDispatches(const DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, uint32_t chunkMaxNum, uint32_t* chunkOffsets) {
+    chunkMaxNum = chunkMaxNum ? chunkMaxNum : 1;
+
+    uint32_t denoiserNum = 0;
+    for (uint32_t i = 0; i < dispatchDescsNum; i++) {
+        if (i == 0 || dispatchDescs[i].identifier != dispatchDescs[i - 1].identifier)
+            denoiserNum++;
+    }
+
+    bool splitAnywhere = denoiserNum < chunkMaxNum;
+    uint32_t chunkSize = (dispatchDescsNum + chunkMaxNum - 1) / chunkMaxNum;
+
+    uint32_t chunkNum = 0;
+    uint32_t chunkOffset = 0;
+    chunkOffsets[0] = 0;
+
+    for (uint32_t i = 1; i < dispatchDescsNum && chunkNum + 1 < chunkMaxNum; i++) {
+        bool isSplitAllowed = splitAnywhere || dispatchDescs[i].identifier != dispatchDescs[i - 1].identifier;
+        if (isSplitAllowed && i - chunkOffset >= chunkSize) {
+            chunkOffsets[++chunkNum] = i;
+            chunkOffset = i;
+        }
+    }
+
+    chunkOffsets[++chunkNum] = dispatchDescsNum;
+
+    return chunkNum;
+}
+
+//===================================================================================================
+// Queue ownership transfers
+//===================================================================================================
+
+// A queue and the index of its family. Ownership transfers are needed only between different families:
+//  - VK: "queueFamilyIndex" the queue has been created with
+//  - D3D: any value unique per "nri::QueueType"
+struct QueueFamily {
+    nri::Queue* queue;
+    uint32_t familyIndex;
+};
+
+// Needed if "Denoise" is recorded on a dedicated compute queue and app resources ("IN_*" and "OUT_*" slots) are created
+// in "exclusive" sharing mode. Resources in "concurrent" sharing mode or queues of the same family don't need a hand-off.
+// Pool textures never leave the queue "Denoise" is recorded on. Sequence:
+//  - graphics queue: release (graphics -> compute)
+//  - compute queue: acquire (graphics -> compute), "Denoise", release (compute -> graphics)
+//  - graphics queue: acquire (compute -> graphics)
+// Layouts are preserved. A release happens from the current state of a resource, an acquire makes a resource available
+// for compute shaders if the layout allows, i.e. after an acquire snapshot resources are in "{SHADER_RESOURCE(_STORAGE), layout,
+// COMPUTE_SHADER}" state for shader layouts and in "{NONE, layout, NONE}" state otherwise (for example, "COLOR_ATTACHMENT" or
+// "UNDEFINED"). It's a valid "before" state for next barriers on both queues ("restoreInitialState" must be "false" in "Denoise").
+// Reports resources, which must be handed off, as barriers ("resourceSnapshot.uniqueNum" max). Returns the number of barriers
+inline uint32_t GetQueueOwnershipTransfers(ResourceSnapshot& resourceSnapshot, const QueueFamily& src, const QueueFamily& dst, bool isRelease, nri::TextureBarrierDesc* barriers) {
+    if (src.queue == dst.queue || src.familyIndex == dst.familyIndex)
+        return 0;
+
+    uint32_t barrierNum = 0;
+    for (size_t i = 0; i < resourceSnapshot.uniqueNum; i++) {
+        Resource& resource = resourceSnapshot.unique[i];
+        if (!resource.nri.texture)
+            continue;
+
+        // The other half of the transfer: stages and access are ignored
+        nri::AccessLayoutStage handoff = {nri::AccessBits::NONE, resource.state.layout, nri::StageBits::NONE};
+
+        // Access must match the layout, non-shader layouts get transitioned later by "Denoise"
+        nri::AccessLayoutStage acquired = handoff;
+        if (resource.state.layout == nri::Layout::SHADER_RESOURCE)
+            acquired = {nri::AccessBits::SHADER_RESOURCE, resource.state.layout, nri::StageBits::COMPUTE_SHADER};
+        else if (resource.state.layout == nri::Layout::SHADER_RESOURCE_STORAGE)
+            acquired = {nri::AccessBits::SHADER_RESOURCE_STORAGE, resource.state.layout, nri::StageBits::COMPUTE_SHADER};
+
+        nri::TextureBarrierDesc& barrier = barriers[barrierNum++];
+        barrier = {};
+        barrier.texture = resource.nri.texture;
+        barrier.before = isRelease ? resource.state : handoff;
+        barrier.after = isRelease ? handoff : acquired;
+        barrier.srcQueue = src.queue;
+        barrier.dstQueue = dst.queue;
+
+        // After a release the resource is not owned by this queue, the state is going to be overwritten by the acquire
+        if (!isRelease)
+            resource.state = acquired;
+    }
+
+    return barrierNum;
+}
+
+//===================================================================================================
+// Tile feedback
+//===================================================================================================
+
+// Tile classification passes mark "sky" tiles with 1 (255 in UNORM8). The flag lives in the only channel of REBLUR and RELAX
+// tiles ("R8_UNORM") and in ".z" of SIGMA tiles ("RGBA8_UNORM"). Counts non-sky tiles in a readback of "width x height" tiles
+inline uint32_t CountActiveTiles(const uint8_t* data, uint32_t width, uint32_t height, uint32_t rowPitch, nri::Format format) {
+    uint32_t texelSize = format == nri::Format::RGBA8_UNORM ? 4 : 1;
+    uint32_t skyChannel = format == nri::Format::RGBA8_UNORM ? 2 : 0;
+
+    uint32_t activeTileNum = 0;
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t* row = data + rowPitch * y + skyChannel;
+
+        for (uint32_t x = 0; x < width; x++)
+            activeTileNum += row[x * texelSize] != 255 ? 1 : 0;
+    }
+
+    return activeTileNum;
+}
+
+//===================================================================================================
+// Retirement queue
+//===================================================================================================
+
+// Objects are released in retirement order, i.e. dependent objects must be retired first
+enum class RetiredObjectType : uint8_t {
+    DESCRIPTOR,
+    PIPELINE,
+    PIPELINE_LAYOUT,
+    DESCRIPTOR_POOL,
+    TEXTURE,
+    BUFFER,
+    MEMORY,
+};
+
+struct RetiredObject {
+    void* object;
+    uint32_t frameIndex; // the last frame, which can reference the object on the GPU
+    RetiredObjectType type;
+};
+
+// Deferred destruction: an object retired in frame "N" gets released in frame "N + queuedFrameNum" or later.
+// GAPI agnostic: the actual destruction is done by "release(const RetiredObject&)", objects are released in retirement order.
+// A mock "release" counting live objects per type is enough to validate the retirement logic without a device
+struct RetirementQueue {
+    inline void Retire(RetiredObjectType type, void* object, uint32_t frameIndex) {
+        if (object)
+            m_Objects.push_back({object, frameIndex, type});
+    }
+
+    template <typename ReleaseFunc>
+    inline uint32_t Release(uint32_t frameIndex, uint32_t queuedFrameNum, ReleaseFunc release) {
+        size_t n = 0;
+        for (size_t i = 0; i < m_Objects.size(); i++) {
+            const RetiredObject& retiredObject = m_Objects[i];
+
+            // "uint32_t" wrapping is fine here
+            if (frameIndex - retiredObject.frameIndex >= queuedFrameNum)
+                release(retiredObject);
+            else
+                m_Objects[n++] = retiredObject;
+        }
+
+        uint32_t releasedNum = uint32_t(m_Objects.size() - n);
+        m_Objects.resize(n);
+
+        return releasedNum;
+    }
+
+    template <typename ReleaseFunc>
+    inline uint32_t ReleaseAll(ReleaseFunc release) {
+        for (const RetiredObject& retiredObject : m_Objects)
+            release(retiredObject);
+
+        uint32_t releasedNum = (uint32_t)m_Objects.size();
+        m_Objects.clear();
+
+        return releasedNum;
+    }
+
+    inline size_t GetSize() const {
+        return m_Objects.size();
+    }
+
+private:
+    std::vector<RetiredObject> m_Objects;
 };
 
 // Threadsafe: no
@@ -251,6 +660,25 @@ struct Integration {
     void DenoiseVK(const Identifier* denoisers, uint32_t denoisersNum, const nri::CommandBufferVKDesc& commandBufferVKDesc, ResourceSnapshot& resourceSnapshot);
 #endif
 
+    // (Optional) Multithreaded alternative to "Denoise" (NRI only):
+    //  - "PrepareDenoise" does all CPU work affecting the state (descriptors, constants, resource transitions) and
+    //    splits dispatches into up to "chunkMaxNum" chunks. Returns the number of chunks
+    //  - "RecordDenoiseChunk" doesn't modify the state, i.e. chunks can be recorded from different threads into
+    //    different command buffers, which must be submitted in chunk order
+    //  - "FinishDenoise" must be recorded after the last chunk (restores initial state if requested)
+    // "resourceSnapshot" gets "final" states in "PrepareDenoise", results are valid until the next "PrepareDenoise" or "Denoise"
+    uint32_t PrepareDenoise(const Identifier* denoisers, uint32_t denoisersNum, ResourceSnapshot& resourceSnapshot, uint32_t chunkMaxNum);
+    void RecordDenoiseChunk(uint32_t chunkIndex, nri::CommandBuffer& commandBuffer) const;
+    void FinishDenoise(nri::CommandBuffer& commandBuffer) const;
+
+    inline const DenoiseChunkDesc& GetDenoiseChunkDesc(uint32_t chunkIndex) const {
+        return m_DenoiseChunks[chunkIndex];
+    }
+
+    // (Optional) Async compute (NRI only): records release ("isRelease = true", on "srcQueue") or acquire (on "dstQueue")
+    // queue ownership transfers for all resources in "resourceSnapshot" (see "GetQueueOwnershipTransfers")
+    void RecordQueueOwnershipTransfer(nri::CommandBuffer& commandBuffer, ResourceSnapshot& resourceSnapshot, const QueueFamily& src, const QueueFamily& dst, bool isRelease) const;
+
     // Destroy.
     // Device should have no NRD work in flight if "autoWaitForIdle = false"!
     void Destroy();
@@ -263,6 +691,16 @@ struct Integration {
     // Device should have no NRD work in flight if "autoWaitForIdle = false"!
     bool RecreatePipelines();
 
+    // (Optional) If "placeTransientPoolInHeap = true", transient pool textures can alias with app resources placed into the same memory range,
+    // but only outside of "Denoise" (transient pool textures are treated as "UNDEFINED" on entry, i.e. contents are discarded)
+    inline const TransientPoolHeapDesc& GetTransientPoolHeapDesc() const {
+        return m_TransientPoolHeapDesc;
+    }
+
+    // Needed only if "isTransientPoolMemoryExternal = true". "offset" must be aligned to "TransientPoolHeapDesc::alignment", "memory"
+    // must be of type "TransientPoolHeapDesc::memoryType" and have at least "TransientPoolHeapDesc::size" bytes after "offset"
+    Result BindTransientPoolMemory(nri::Memory& memory, uint64_t offset);
+
     // (Optional) Statistics
     inline double GetTotalMemoryUsageInMb() const {
         return double(m_PermanentPoolSize + m_TransientPoolSize) / (1024.0 * 1024.0);
@@ -276,21 +714,123 @@ struct Integration {
         return double(m_TransientPoolSize) / (1024.0 * 1024.0);
     }
 
+    inline size_t GetRetiredObjectNum() const {
+        return m_RetirementQueue.GetSize();
+    }
+
+    // Dispatches in the last "Denoise" call, including clears injected by "AccumulationMode::CLEAR_AND_RESTART"
+    inline uint32_t GetDispatchNum() const {
+        return m_DispatchNum;
+    }
+
+    inline uint32_t GetClearDispatchNum() const {
+        return m_ClearDispatchNum;
+    }
+
+    // Threadsafe: yes, if called from a single thread (can be different from the "Denoise" thread), but not concurrently with "Recreate"
+    // changing "dispatchEventRingSize". Returns the number of copied events
+    inline uint32_t DrainDispatchEvents(DispatchEvent* events, uint32_t eventsMaxNum) {
+        return m_DispatchEventRing.Drain(events, eventsMaxNum);
+    }
+
+    // Events lost because the ring was full
+    inline uint64_t GetDroppedDispatchEventNum() const {
+        return m_DispatchEventRing.GetDroppedNum();
+    }
+
 private:
+    // Pool texture bookkeeping (mostly needed for "enableLazyResourceAllocation")
+    struct PoolTexture {
+        std::vector<nri::Memory*> memoryAllocations; // "enableLazyResourceAllocation = true" only
+        std::vector<uint32_t> owners;                // indices in "m_DenoiserUsages"
+        uint64_t size;
+        uint64_t heapOffset; // "placeTransientPoolInHeap = true" only
+        uint32_t alignment;
+        nri::MemoryType memoryType;
+    };
+
+    struct DenoiserUsage {
+        Identifier identifier;
+        uint32_t lastUseFrameIndex;
+        bool isRestartNeeded;    // history textures are missing (not created yet or released)
+        bool isAllocationFailed; // in the current "Denoise"
+    };
+
+    struct PersistentDescriptorSet {
+        std::vector<uint32_t> signature;
+        nri::DescriptorSet* descriptorSet;
+    };
+
+    struct TileFeedback {
+        Identifier identifier;
+        uint32_t width;
+        uint32_t height;
+        nri::Format format;
+    };
+
+    struct PreparedDispatch {
+        const char* name;
+        nri::Pipeline* pipeline;
+        nri::DescriptorPool* descriptorPool;
+        nri::DescriptorSet* descriptorSet;
+        nri::Texture* feedbackTexture; // tiles to read back ("enableTileFeedback = true" only)
+        uint32_t feedbackSlot;         // in "m_TileFeedbacks"
+        uint32_t constantBufferOffset;
+        uint32_t bindlessTableOffset;
+        uint32_t transitionOffset; // in "m_PreparedTransitions"
+        uint32_t transitionNum;
+        uint32_t gridWidth;
+        uint32_t gridHeight;
+    };
+
     Integration(const Integration&) = delete;
 
     bool _CreateResources();
-    void _Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPool& descriptorPool, const DispatchDesc& dispatchDesc, ResourceSnapshot& resourceSnapshot);
+    bool _CreateTexture(uint32_t poolIndex);
+    bool _PlaceTransientPool();
+    void _RestartLazyDenoisers(const Identifier* denoisers, uint32_t denoisersNum);
+    bool _AllocateLazyResources(const Identifier* denoisers, uint32_t denoisersNum, const DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum);
+    void _ReleaseUnusedResources();
+    void _RetireTexture(uint32_t poolIndex);
+    void _ReleaseRetiredObject(const RetiredObject& retiredObject);
+    void _RetireAll();
+    void _RetireDescriptors();
+    void _RetirePersistentDescriptorSets();
+    nri::DescriptorSet* _AllocatePersistentDescriptorSet(uint64_t hash, const uint32_t* signature, uint32_t signatureSize);
+    void _PrepareDispatch(nri::DescriptorPool& descriptorPool, const DispatchDesc& dispatchDesc, ResourceSnapshot& resourceSnapshot);
+    void _PrepareDispatchBindless(const DispatchDesc& dispatchDesc, ResourceSnapshot& resourceSnapshot);
+    void _PrepareTileFeedback(const DispatchDesc& dispatchDesc);
+    void _ReportTileFeedback();
+    void _PushDispatchEvent(const DispatchDesc& dispatchDesc, const PreparedDispatch& preparedDispatch, uint32_t createdDescriptorNum, uint32_t constantBytes, uint16_t flags);
+    void _RecordDispatch(nri::CommandBuffer& commandBuffer, const PreparedDispatch& preparedDispatch, nri::DescriptorPool*& boundDescriptorPool) const;
+    Resource* _TransitionResource(const ResourceDesc& resourceDesc, ResourceSnapshot& resourceSnapshot);
+    uint32_t _UploadConstants(const void* data, uint32_t size);
     void _WaitForIdle();
 
     std::vector<Resource> m_TexturePool;
+    std::vector<PoolTexture> m_PoolTextures;
+    std::vector<DenoiserUsage> m_DenoiserUsages;
+    RetirementQueue m_RetirementQueue;
+    DispatchEventRing m_DispatchEventRing;
+    TransientPoolHeapDesc m_TransientPoolHeapDesc = {};
     std::vector<nri::Pipeline*> m_Pipelines;
     std::vector<nri::Memory*> m_MemoryAllocations;
     std::vector<nri::DescriptorPool*> m_DescriptorPools = {};
     std::vector<std::vector<nri::Descriptor*>> m_DescriptorsInFlight;
     std::map<uint64_t, nri::Descriptor*> m_CachedDescriptors;
+    std::map<uint64_t, PersistentDescriptorSet> m_PersistentDescriptorSets;
+    std::map<uint64_t, nri::Descriptor*> m_PersistentDescriptors;
+    std::vector<DispatchDesc> m_AllocatedDispatches; // dispatches of denoisers with successfully created textures (lazy allocation only)
+    std::vector<PreparedDispatch> m_PreparedDispatches;
+    std::vector<nri::TextureBarrierDesc> m_PreparedTransitions;
+    std::vector<nri::TextureBarrierDesc> m_FinalTransitions;
+    std::vector<DenoiseChunkDesc> m_DenoiseChunks;
+    std::vector<uint32_t> m_DenoiseChunkOffsets;
+    std::vector<TileFeedback> m_TileFeedbacks; // [queuedFrameNum][denoisersNum]
+    std::vector<uint32_t> m_TileFeedbackNum; // [queuedFrameNum]
     IntegrationCreationDesc m_Desc = {};
     nri::CoreInterface m_iCore = {};
+    nri::HelperInterface m_iHelper = {};
 #ifdef NRI_WRAPPER_D3D11_H
     nri::WrapperD3D11Interface m_iWrapperD3D11 = {};
 #endif
@@ -303,7 +843,9 @@ private:
     nri::Device* m_Device = nullptr;
     nri::Buffer* m_ConstantBuffer = nullptr;
     nri::Descriptor* m_ConstantBufferView = nullptr;
+    nri::Buffer* m_TileFeedbackBuffer = nullptr;
     nri::PipelineLayout* m_PipelineLayout = nullptr;
+    nri::DescriptorPool* m_PersistentDescriptorPool = nullptr;
 #ifdef NRD_INTEGRATION_DEBUG_LOGGING
     FILE* m_Log = nullptr;
 #endif
@@ -311,12 +853,18 @@ private:
     uint64_t m_PermanentPoolSize = 0;
     uint64_t m_TransientPoolSize = 0;
     uint64_t m_ConstantBufferSize = 0;
+    uint64_t m_TileFeedbackSlotSize = 0;
     uint32_t m_ConstantBufferViewSize = 0;
     uint32_t m_ConstantBufferOffset = 0;
     uint32_t m_ConstantBufferOffsetPrev = 0;
+    uint32_t m_TileFeedbackRowPitch = 0;
     uint32_t m_DescriptorPoolIndex = 0;
+    uint32_t m_DispatchNum = 0;
+    uint32_t m_ClearDispatchNum = 0;
     uint32_t m_FrameIndex = uint32_t(-1); // 0 needed after 1st "NewFrame"
     uint32_t m_PrevFrameIndexFromSettings = 0;
+    uint16_t m_RectSize[2] = {};
+    const void* m_WrappedNativeDevice = nullptr;
     nri::GraphicsAPI m_Wrapped = nri::GraphicsAPI::NONE;
     bool m_SkipDestroy = false;
 };
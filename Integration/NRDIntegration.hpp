@@ -10,6 +10,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #include "NRDIntegration.h"
 
+#include <chrono>
+
 #ifdef _WIN32
 #    include <malloc.h>
 #else
@@ -98,9 +100,18 @@ constexpr T Align(const T& size, A alignment) {
 Result Integration::Recreate(const IntegrationCreationDesc& integrationDesc, const InstanceCreationDesc& instanceDesc, nri::Device* device) {
     NRD_INTEGRATION_ASSERT(!integrationDesc.promoteFloat16to32 || !integrationDesc.demoteFloat32to16, "Can't be 'true' for both");
     NRD_INTEGRATION_ASSERT(integrationDesc.queuedFrameNum, "Can't be 0");
+    NRD_INTEGRATION_ASSERT(integrationDesc.precisionPolicy[(size_t)TextureClass::OTHER] == Precision::DEFAULT, "'TextureClass::OTHER' must be 'Precision::DEFAULT'");
+    NRD_INTEGRATION_ASSERT(!integrationDesc.enableBindless || (integrationDesc.bindlessDesc.GetDescriptorHeapIndex && integrationDesc.bindlessDesc.GetBindlessShader), "'bindlessDesc' is not provided");
+    NRD_INTEGRATION_ASSERT(!integrationDesc.placeTransientPoolInHeap || !integrationDesc.enableLazyResourceAllocation, "Can't be 'true' for both");
+    NRD_INTEGRATION_ASSERT(integrationDesc.placeTransientPoolInHeap || !integrationDesc.isTransientPoolMemoryExternal, "'isTransientPoolMemoryExternal' needs 'placeTransientPoolInHeap'");
+
+    // Deferred destruction is possible only on the same device, since retired objects belong to it
+    bool isDeferred = integrationDesc.enableDeferredDestruction && m_Instance && m_Device == device;
 
     if (m_SkipDestroy)
         m_SkipDestroy = false;
+    else if (isDeferred)
+        _RetireAll();
     else
         Destroy();
 
@@ -117,6 +128,11 @@ Result Integration::Recreate(const IntegrationCreationDesc& integrationDesc, con
         return Result::FAILURE;
     }
 
+    if (nri::nriGetInterface(*device, NRI_INTERFACE(nri::HelperInterface), &m_iHelper) != nri::Result::SUCCESS) {
+        NRD_INTEGRATION_ASSERT(false, "'nriGetInterface(HelperInterface)' failed!");
+        return Result::FAILURE;
+    }
+
     const nri::DeviceDesc& deviceDesc = m_iCore.GetDeviceDesc(*device);
     if (deviceDesc.nriVersion != NRI_VERSION) {
         NRD_INTEGRATION_ASSERT(false, "NRI version mismatch detected!");
@@ -132,6 +148,13 @@ Result Integration::Recreate(const IntegrationCreationDesc& integrationDesc, con
     m_Desc = integrationDesc;
     m_Device = device;
 
+    // The ring survives "Recreate" (it can be drained concurrently), only a capacity change reallocates it
+    if (m_DispatchEventRing.GetCapacity() != DispatchEventRing::GetAlignedCapacity(integrationDesc.dispatchEventRingSize))
+        m_DispatchEventRing.Resize(integrationDesc.dispatchEventRingSize);
+
+    for (uint32_t i = 0; i < instanceDesc.denoisersNum; i++)
+        m_DenoiserUsages.push_back({instanceDesc.denoisers[i].identifier, 0, true, false});
+
     Result result = CreateInstance(instanceDesc, m_Instance);
     if (result == Result::SUCCESS) {
         result = _CreateResources() ? Result::SUCCESS : Result::FAILURE;
@@ -147,6 +170,10 @@ Result Integration::Recreate(const IntegrationCreationDesc& integrationDesc, con
 
 #ifdef NRI_WRAPPER_D3D11_H
 Result Integration::RecreateD3D11(const IntegrationCreationDesc& nrdIntegrationDesc, const InstanceCreationDesc& instanceCreationDesc, const nri::DeviceCreationD3D11Desc& deviceCreationD3D11Desc) {
+    // Reuse the wrapped device to keep retired objects valid
+    if (nrdIntegrationDesc.enableDeferredDestruction && m_Wrapped == nri::GraphicsAPI::D3D11 && m_WrappedNativeDevice == (const void*)deviceCreationD3D11Desc.d3d11Device)
+        return Recreate(nrdIntegrationDesc, instanceCreationDesc, m_Device);
+
     Destroy();
 
     if (nri::nriCreateDeviceFromD3D11Device(deviceCreationD3D11Desc, m_Device) != nri::Result::SUCCESS)
@@ -155,6 +182,7 @@ Result Integration::RecreateD3D11(const IntegrationCreationDesc& nrdIntegrationD
     if (nri::nriGetInterface(*m_Device, NRI_INTERFACE(nri::WrapperD3D11Interface), &m_iWrapperD3D11) != nri::Result::SUCCESS)
         return Result::FAILURE;
 
+    m_WrappedNativeDevice = (const void*)deviceCreationD3D11Desc.d3d11Device;
     m_Wrapped = nri::GraphicsAPI::D3D11;
     m_SkipDestroy = true;
 
@@ -164,6 +192,10 @@ Result Integration::RecreateD3D11(const IntegrationCreationDesc& nrdIntegrationD
 
 #ifdef NRI_WRAPPER_D3D12_H
 Result Integration::RecreateD3D12(const IntegrationCreationDesc& nrdIntegrationDesc, const InstanceCreationDesc& instanceCreationDesc, const nri::DeviceCreationD3D12Desc& deviceCreationD3D12Desc) {
+    // Reuse the wrapped device to keep retired objects valid
+    if (nrdIntegrationDesc.enableDeferredDestruction && m_Wrapped == nri::GraphicsAPI::D3D12 && m_WrappedNativeDevice == (const void*)deviceCreationD3D12Desc.d3d12Device)
+        return Recreate(nrdIntegrationDesc, instanceCreationDesc, m_Device);
+
     Destroy();
 
     if (nri::nriCreateDeviceFromD3D12Device(deviceCreationD3D12Desc, m_Device) != nri::Result::SUCCESS)
@@ -172,6 +204,7 @@ Result Integration::RecreateD3D12(const IntegrationCreationDesc& nrdIntegrationD
     if (nri::nriGetInterface(*m_Device, NRI_INTERFACE(nri::WrapperD3D12Interface), &m_iWrapperD3D12) != nri::Result::SUCCESS)
         return Result::FAILURE;
 
+    m_WrappedNativeDevice = (const void*)deviceCreationD3D12Desc.d3d12Device;
     m_Wrapped = nri::GraphicsAPI::D3D12;
     m_SkipDestroy = true;
 
@@ -181,6 +214,10 @@ Result Integration::RecreateD3D12(const IntegrationCreationDesc& nrdIntegrationD
 
 #ifdef NRI_WRAPPER_VK_H
 Result Integration::RecreateVK(const IntegrationCreationDesc& nrdIntegrationDesc, const InstanceCreationDesc& instanceCreationDesc, const nri::DeviceCreationVKDesc& deviceCreationVKDesc) {
+    // Reuse the wrapped device to keep retired objects valid
+    if (nrdIntegrationDesc.enableDeferredDestruction && m_Wrapped == nri::GraphicsAPI::VK && m_WrappedNativeDevice == (const void*)deviceCreationVKDesc.vkDevice)
+        return Recreate(nrdIntegrationDesc, instanceCreationDesc, m_Device);
+
     Destroy();
 
     if (nri::nriCreateDeviceFromVKDevice(deviceCreationVKDesc, m_Device) != nri::Result::SUCCESS)
@@ -189,6 +226,7 @@ Result Integration::RecreateVK(const IntegrationCreationDesc& nrdIntegrationDesc
     if (nri::nriGetInterface(*m_Device, NRI_INTERFACE(nri::WrapperVKInterface), &m_iWrapperVK) != nri::Result::SUCCESS)
         return Result::FAILURE;
 
+    m_WrappedNativeDevice = (const void*)deviceCreationVKDesc.vkDevice;
     m_Wrapped = nri::GraphicsAPI::VK;
     m_SkipDestroy = true;
 
@@ -197,11 +235,16 @@ Result Integration::RecreateVK(const IntegrationCreationDesc& nrdIntegrationDesc
 #endif
 
 bool Integration::RecreatePipelines() {
-    _WaitForIdle();
-
     // Destroy old
-    for (nri::Pipeline* pipeline : m_Pipelines)
-        m_iCore.DestroyPipeline(pipeline);
+    if (m_Desc.enableDeferredDestruction) {
+        for (nri::Pipeline* pipeline : m_Pipelines)
+            m_RetirementQueue.Retire(RetiredObjectType::PIPELINE, pipeline, m_FrameIndex);
+    } else {
+        _WaitForIdle();
+
+        for (nri::Pipeline* pipeline : m_Pipelines)
+            m_iCore.DestroyPipeline(pipeline);
+    }
     m_Pipelines.clear();
 
     // Create new
@@ -226,6 +269,12 @@ bool Integration::RecreatePipelines() {
         computeShader.entryPointName = instanceDesc.shaderEntryPoint;
         computeShader.stage = nri::StageBits::COMPUTE_SHADER;
 
+        // Bindless shaders are compiled by the app
+        if (m_Desc.enableBindless && !m_Desc.bindlessDesc.GetBindlessShader(m_Desc.bindlessDesc.userArg, nrdPipelineDesc, computeShader)) {
+            NRD_INTEGRATION_ASSERT(false, "'GetBindlessShader' failed!");
+            return false;
+        }
+
         nri::ComputePipelineDesc pipelineDesc = {};
         pipelineDesc.pipelineLayout = m_PipelineLayout;
         pipelineDesc.shader = computeShader;
@@ -246,80 +295,33 @@ bool Integration::_CreateResources() {
     { // Texture pool
         // No reallocation, please!
         m_TexturePool.resize(poolSize);
+        m_PoolTextures.resize(poolSize);
 
-        for (uint32_t i = 0; i < poolSize; i++) {
-            // Create NRI texture
-            char name[128];
-            nri::Texture* texture = nullptr;
-            const TextureDesc& nrdTextureDesc = (i < instanceDesc.permanentPoolSize) ? instanceDesc.permanentPool[i] : instanceDesc.transientPool[i - instanceDesc.permanentPoolSize];
-            {
-                nri::Format format = GetNriFormat(nrdTextureDesc.format);
-                if (m_Desc.promoteFloat16to32) {
-                    if (format == nri::Format::R16_SFLOAT)
-                        format = nri::Format::R32_SFLOAT;
-                    else if (format == nri::Format::RG16_SFLOAT)
-                        format = nri::Format::RG32_SFLOAT;
-                    else if (format == nri::Format::RGBA16_SFLOAT)
-                        format = nri::Format::RGBA32_SFLOAT;
-                } else if (m_Desc.demoteFloat32to16) {
-                    if (format == nri::Format::R32_SFLOAT)
-                        format = nri::Format::R16_SFLOAT;
-                    else if (format == nri::Format::RG32_SFLOAT)
-                        format = nri::Format::RG16_SFLOAT;
-                    else if (format == nri::Format::RGBA32_SFLOAT)
-                        format = nri::Format::RGBA16_SFLOAT;
-                }
-
-                uint16_t w = DivideUp(m_Desc.resourceWidth, nrdTextureDesc.downsampleFactor);
-                uint16_t h = DivideUp(m_Desc.resourceHeight, nrdTextureDesc.downsampleFactor);
-
-                nri::TextureDesc textureDesc = {};
-                textureDesc.type = nri::TextureType::TEXTURE_2D;
-                textureDesc.usage = nri::TextureUsageBits::SHADER_RESOURCE | nri::TextureUsageBits::SHADER_RESOURCE_STORAGE;
-                textureDesc.format = format;
-                textureDesc.width = w;
-                textureDesc.height = h;
-
-                NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(m_iCore.CreateTexture(*m_Device, textureDesc, texture));
-
-                if (i < instanceDesc.permanentPoolSize)
-                    snprintf(name, sizeof(name), "%s::P(%u)", m_Desc.name, i);
-                else
-                    snprintf(name, sizeof(name), "%s::T(%u)", m_Desc.name, i - instanceDesc.permanentPoolSize);
-                m_iCore.SetDebugName(texture, name);
+        // Lazy allocation postpones creation until the first use
+        if (!m_Desc.enableLazyResourceAllocation) {
+            for (uint32_t i = 0; i < poolSize; i++) {
+                if (!_CreateTexture(i))
+                    return false;
             }
-
-            { // Construct NRD texture
-                Resource& resource = m_TexturePool[i];
-                resource.nri.texture = texture;
-                resource.state = {nri::AccessBits::NONE, nri::Layout::UNDEFINED};
-            }
-
-            { // Adjust memory usage
-                nri::MemoryDesc memoryDesc = {};
-                m_iCore.GetTextureMemoryDesc(*texture, nri::MemoryLocation::DEVICE, memoryDesc);
-
-                if (i < instanceDesc.permanentPoolSize)
-                    m_PermanentPoolSize += memoryDesc.size;
-                else
-                    m_TransientPoolSize += memoryDesc.size;
-            }
-
-#ifdef NRD_INTEGRATION_DEBUG_LOGGING
-            if (m_Log)
-                fprintf(m_Log, "%s\n\tformat=%u downsampleFactor=%u\n", name, nrdTextureDesc.format, nrdTextureDesc.downsampleFactor);
         }
 
+#ifdef NRD_INTEGRATION_DEBUG_LOGGING
         if (m_Log)
             fprintf(m_Log, "%.1f Mb (permanent), %.1f Mb (transient)\n\n", double(m_PermanentPoolSize) / (1024.0f * 1024.0f), double(m_TransientPoolSize) / (1024.0f * 1024.0f));
-#else
-        }
 #endif
     }
 
     { // Constant buffer
-        m_ConstantBufferViewSize = Align(instanceDesc.constantBufferMaxDataSize, deviceDesc.memoryAlignment.constantBufferOffset);
-        m_ConstantBufferSize = uint64_t(m_ConstantBufferViewSize) * instanceDesc.descriptorPoolDesc.setsMaxNum * m_Desc.queuedFrameNum;
+        // Bindless: each dispatch also streams its index table
+        uint32_t constantBufferMaxDataSize = instanceDesc.constantBufferMaxDataSize;
+        uint32_t dataNumPerDispatch = 1;
+        if (m_Desc.enableBindless) {
+            constantBufferMaxDataSize = std::max(constantBufferMaxDataSize, BINDLESS_TABLE_SIZE * (uint32_t)sizeof(uint32_t));
+            dataNumPerDispatch = 2;
+        }
+
+        m_ConstantBufferViewSize = Align(constantBufferMaxDataSize, deviceDesc.memoryAlignment.constantBufferOffset);
+        m_ConstantBufferSize = uint64_t(m_ConstantBufferViewSize) * instanceDesc.descriptorPoolDesc.setsMaxNum * dataNumPerDispatch * m_Desc.queuedFrameNum;
 
         nri::BufferDesc bufferDesc = {};
         bufferDesc.size = m_ConstantBufferSize;
@@ -327,24 +329,46 @@ bool Integration::_CreateResources() {
         NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(m_iCore.CreateBuffer(*m_Device, bufferDesc, m_ConstantBuffer));
     }
 
-    { // Bind resources to memory
-        nri::HelperInterface iHelper = {};
-        NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(nri::nriGetInterface(*m_Device, NRI_INTERFACE(nri::HelperInterface), &iHelper));
+    if (m_Desc.enableTileFeedback) { // Tile feedback (a slot per denoiser per queued frame)
+        uint32_t tileWidth = DivideUp(m_Desc.resourceWidth, 16);
+        uint32_t tileHeight = DivideUp(m_Desc.resourceHeight, 16);
 
-        std::vector<nri::Texture*> textures(m_TexturePool.size(), nullptr);
-        for (size_t i = 0; i < m_TexturePool.size(); i++)
-            textures[i] = m_TexturePool[i].nri.texture;
+        m_TileFeedbackRowPitch = Align(tileWidth * 4, deviceDesc.memoryAlignment.uploadBufferTextureRow); // up to "RGBA8_UNORM" (SIGMA)
+        m_TileFeedbackSlotSize = Align(uint64_t(m_TileFeedbackRowPitch) * tileHeight, deviceDesc.memoryAlignment.uploadBufferTextureSlice);
+        m_TileFeedbacks.resize(m_DenoiserUsages.size() * m_Desc.queuedFrameNum);
+        m_TileFeedbackNum.resize(m_Desc.queuedFrameNum, 0);
 
+        nri::BufferDesc bufferDesc = {};
+        bufferDesc.size = m_TileFeedbackSlotSize * m_TileFeedbacks.size();
+        NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(m_iCore.CreateBuffer(*m_Device, bufferDesc, m_TileFeedbackBuffer));
+    }
+
+    { // Bind resources to memory
         nri::ResourceGroupDesc resourceGroupDesc = {};
-        resourceGroupDesc.memoryLocation = nri::MemoryLocation::DEVICE;
-        resourceGroupDesc.textureNum = (uint32_t)textures.size();
-        resourceGroupDesc.textures = textures.data();
-        resourceGroupDesc.residencyPriority = m_Desc.residencyPriority;
+        size_t baseAllocation = 0;
+
+        // Transient textures can be placed into a heap separately
+        const bool placeTransientPoolInHeap = m_Desc.placeTransientPoolInHeap && !m_Desc.enableLazyResourceAllocation;
+        const uint32_t textureNum = placeTransientPoolInHeap ? instanceDesc.permanentPoolSize : poolSize;
+
+        if (!m_Desc.enableLazyResourceAllocation && textureNum) {
+            std::vector<nri::Texture*> textures(textureNum, nullptr);
+            for (size_t i = 0; i < textureNum; i++)
+                textures[i] = m_TexturePool[i].nri.texture;
+
+            resourceGroupDesc.memoryLocation = nri::MemoryLocation::DEVICE;
+            resourceGroupDesc.textureNum = (uint32_t)textures.size();
+            resourceGroupDesc.textures = textures.data();
+            resourceGroupDesc.residencyPriority = m_Desc.residencyPriority;
+
+            baseAllocation = m_MemoryAllocations.size();
+            size_t allocationNum = m_iHelper.CalculateAllocationNumber(*m_Device, resourceGroupDesc);
+            m_MemoryAllocations.resize(baseAllocation + allocationNum, nullptr);
+            NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(m_iHelper.AllocateAndBindMemory(*m_Device, resourceGroupDesc, m_MemoryAllocations.data() + baseAllocation));
+        }
 
-        size_t baseAllocation = m_MemoryAllocations.size();
-        size_t allocationNum = iHelper.CalculateAllocationNumber(*m_Device, resourceGroupDesc);
-        m_MemoryAllocations.resize(baseAllocation + allocationNum, nullptr);
-        NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(iHelper.AllocateAndBindMemory(*m_Device, resourceGroupDesc, m_MemoryAllocations.data() + baseAllocation));
+        if (placeTransientPoolInHeap && !_PlaceTransientPool())
+            return false;
 
         resourceGroupDesc = {};
         resourceGroupDesc.memoryLocation = nri::MemoryLocation::DEVICE_UPLOAD; // soft fallback to "HOST_UPLOAD"
@@ -353,7 +377,18 @@ bool Integration::_CreateResources() {
 
         baseAllocation = m_MemoryAllocations.size();
         m_MemoryAllocations.resize(baseAllocation + 1, nullptr);
-        NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(iHelper.AllocateAndBindMemory(*m_Device, resourceGroupDesc, m_MemoryAllocations.data() + baseAllocation));
+        NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(m_iHelper.AllocateAndBindMemory(*m_Device, resourceGroupDesc, m_MemoryAllocations.data() + baseAllocation));
+
+        if (m_TileFeedbackBuffer) {
+            resourceGroupDesc = {};
+            resourceGroupDesc.memoryLocation = nri::MemoryLocation::HOST_READBACK;
+            resourceGroupDesc.bufferNum = 1;
+            resourceGroupDesc.buffers = &m_TileFeedbackBuffer;
+
+            baseAllocation = m_MemoryAllocations.size();
+            m_MemoryAllocations.resize(baseAllocation + 1, nullptr);
+            NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(m_iHelper.AllocateAndBindMemory(*m_Device, resourceGroupDesc, m_MemoryAllocations.data() + baseAllocation));
+        }
     }
 
     { // Constant buffer view
@@ -410,19 +445,28 @@ bool Integration::_CreateResources() {
         resources.ranges = descriptorRanges;
         resources.rangeNum = 2;
 
-        nri::RootDescriptorDesc constantBuffer = {};
-        constantBuffer.registerIndex = constantBufferOffset + instanceDesc.constantBufferRegisterIndex;
-        constantBuffer.descriptorType = nri::DescriptorType::CONSTANT_BUFFER;
-        constantBuffer.shaderStages = nri::StageBits::COMPUTE_SHADER;
+        // Bindless: no descriptor sets, but the index table goes after the constant buffer
+        nri::RootDescriptorDesc rootDescriptors[2] = {};
+        {
+            nri::RootDescriptorDesc& constantBuffer = rootDescriptors[0];
+            constantBuffer.registerIndex = constantBufferOffset + instanceDesc.constantBufferRegisterIndex;
+            constantBuffer.descriptorType = nri::DescriptorType::CONSTANT_BUFFER;
+            constantBuffer.shaderStages = nri::StageBits::COMPUTE_SHADER;
+
+            nri::RootDescriptorDesc& bindlessTable = rootDescriptors[1];
+            bindlessTable.registerIndex = constantBufferOffset + BINDLESS_TABLE_REGISTER_INDEX;
+            bindlessTable.descriptorType = nri::DescriptorType::CONSTANT_BUFFER;
+            bindlessTable.shaderStages = nri::StageBits::COMPUTE_SHADER;
+        }
 
         nri::PipelineLayoutDesc pipelineLayoutDesc = {};
         pipelineLayoutDesc.rootRegisterSpace = instanceDesc.constantBufferAndSamplersSpaceIndex;
-        pipelineLayoutDesc.rootDescriptors = &constantBuffer;
-        pipelineLayoutDesc.rootDescriptorNum = 1;
+        pipelineLayoutDesc.rootDescriptors = rootDescriptors;
+        pipelineLayoutDesc.rootDescriptorNum = m_Desc.enableBindless ? 2 : 1;
         pipelineLayoutDesc.rootSamplers = rootSamplers.data();
         pipelineLayoutDesc.rootSamplerNum = instanceDesc.samplersNum;
-        pipelineLayoutDesc.descriptorSets = &resources;
-        pipelineLayoutDesc.descriptorSetNum = 1;
+        pipelineLayoutDesc.descriptorSets = m_Desc.enableBindless ? nullptr : &resources;
+        pipelineLayoutDesc.descriptorSetNum = m_Desc.enableBindless ? 0 : 1;
         pipelineLayoutDesc.shaderStages = nri::StageBits::COMPUTE_SHADER;
         pipelineLayoutDesc.flags = nri::PipelineLayoutBits::IGNORE_GLOBAL_SPIRV_OFFSETS;
 
@@ -438,9 +482,12 @@ bool Integration::_CreateResources() {
         descriptorPoolDesc.storageTextureMaxNum = setMaxNum * descriptorRanges[RANGE_STORAGES].descriptorNum;
 
         for (uint32_t i = 0; i < m_Desc.queuedFrameNum; i++) {
-            nri::DescriptorPool* descriptorPool = nullptr;
-            NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(m_iCore.CreateDescriptorPool(*m_Device, descriptorPoolDesc, descriptorPool));
-            m_DescriptorPools.push_back(descriptorPool);
+            // Bindless: descriptors live in the app's descriptor heap
+            if (!m_Desc.enableBindless) {
+                nri::DescriptorPool* descriptorPool = nullptr;
+                NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(m_iCore.CreateDescriptorPool(*m_Device, descriptorPoolDesc, descriptorPool));
+                m_DescriptorPools.push_back(descriptorPool);
+            }
 
             m_DescriptorsInFlight.push_back({});
         }
@@ -454,6 +501,496 @@ bool Integration::_CreateResources() {
     return true;
 }
 
+bool Integration::_CreateTexture(uint32_t poolIndex) {
+    const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
+    const bool isPermanent = poolIndex < instanceDesc.permanentPoolSize;
+    const TextureDesc& nrdTextureDesc = isPermanent ? instanceDesc.permanentPool[poolIndex] : instanceDesc.transientPool[poolIndex - instanceDesc.permanentPoolSize];
+
+    // Create NRI texture
+    char name[128];
+    nri::Texture* texture = nullptr;
+    {
+        Precision precision = m_Desc.precisionPolicy[(size_t)nrdTextureDesc.textureClass];
+        nri::Format format = GetNriFormat(GetFormatWithPrecision(nrdTextureDesc.format, precision));
+        // The class policy has priority
+        if (precision == Precision::DEFAULT && m_Desc.promoteFloat16to32) {
+            if (format == nri::Format::R16_SFLOAT)
+                format = nri::Format::R32_SFLOAT;
+            else if (format == nri::Format::RG16_SFLOAT)
+                format = nri::Format::RG32_SFLOAT;
+            else if (format == nri::Format::RGBA16_SFLOAT)
+                format = nri::Format::RGBA32_SFLOAT;
+        } else if (precision == Precision::DEFAULT && m_Desc.demoteFloat32to16) {
+            if (format == nri::Format::R32_SFLOAT)
+                format = nri::Format::R16_SFLOAT;
+            else if (format == nri::Format::RG32_SFLOAT)
+                format = nri::Format::RG16_SFLOAT;
+            else if (format == nri::Format::RGBA32_SFLOAT)
+                format = nri::Format::RGBA16_SFLOAT;
+        }
+
+        uint16_t w = DivideUp(m_Desc.resourceWidth, nrdTextureDesc.downsampleFactor);
+        uint16_t h = DivideUp(m_Desc.resourceHeight, nrdTextureDesc.downsampleFactor);
+
+        nri::TextureDesc textureDesc = {};
+        textureDesc.type = nri::TextureType::TEXTURE_2D;
+        textureDesc.usage = nri::TextureUsageBits::SHADER_RESOURCE | nri::TextureUsageBits::SHADER_RESOURCE_STORAGE;
+        textureDesc.format = format;
+        textureDesc.width = w;
+        textureDesc.height = h;
+
+        NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(m_iCore.CreateTexture(*m_Device, textureDesc, texture));
+
+        if (isPermanent)
+            snprintf(name, sizeof(name), "%s::P(%u)", m_Desc.name, poolIndex);
+        else
+            snprintf(name, sizeof(name), "%s::T(%u)", m_Desc.name, poolIndex - instanceDesc.permanentPoolSize);
+        m_iCore.SetDebugName(texture, name);
+    }
+
+    { // Construct NRD texture
+        Resource& resource = m_TexturePool[poolIndex];
+        resource.nri.texture = texture;
+        resource.state = {nri::AccessBits::NONE, nri::Layout::UNDEFINED};
+    }
+
+    { // Adjust memory usage
+        nri::MemoryDesc memoryDesc = {};
+        m_iCore.GetTextureMemoryDesc(*texture, nri::MemoryLocation::DEVICE, memoryDesc);
+
+        PoolTexture& poolTexture = m_PoolTextures[poolIndex];
+        poolTexture.size = memoryDesc.size;
+        poolTexture.alignment = memoryDesc.alignment;
+        poolTexture.memoryType = memoryDesc.type;
+
+        if (isPermanent)
+            m_PermanentPoolSize += memoryDesc.size;
+        else
+            m_TransientPoolSize += memoryDesc.size;
+    }
+
+#ifdef NRD_INTEGRATION_DEBUG_LOGGING
+    if (m_Log)
+        fprintf(m_Log, "%s\n\tformat=%u downsampleFactor=%u\n", name, nrdTextureDesc.format, nrdTextureDesc.downsampleFactor);
+#endif
+
+    return true;
+}
+
+bool Integration::_PlaceTransientPool() {
+    const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
+    const uint32_t textureNum = instanceDesc.transientPoolSize;
+
+    m_TransientPoolHeapDesc = {};
+    if (!textureNum)
+        return true;
+
+    // Calculate placement
+    std::vector<PlacementRequirements> requirements(textureNum);
+    std::vector<uint64_t> offsets(textureNum);
+
+    for (uint32_t i = 0; i < textureNum; i++) {
+        const PoolTexture& poolTexture = m_PoolTextures[instanceDesc.permanentPoolSize + i];
+        requirements[i] = {poolTexture.size, poolTexture.alignment};
+
+        if (i == 0)
+            m_TransientPoolHeapDesc.memoryType = poolTexture.memoryType;
+        else if (poolTexture.memoryType != m_TransientPoolHeapDesc.memoryType) {
+            NRD_INTEGRATION_ASSERT(false, "Transient pool textures have different memory types and can't be placed into a single heap!");
+            return false;
+        }
+    }
+
+    m_TransientPoolHeapDesc.size = CalculatePlacement(requirements.data(), textureNum, offsets.data(), m_TransientPoolHeapDesc.alignment);
+
+    for (uint32_t i = 0; i < textureNum; i++)
+        m_PoolTextures[instanceDesc.permanentPoolSize + i].heapOffset = offsets[i];
+
+    // The heap is the actual memory footprint (including padding)
+    m_TransientPoolSize = m_TransientPoolHeapDesc.size;
+
+#ifdef NRD_INTEGRATION_DEBUG_LOGGING
+    if (m_Log)
+        fprintf(m_Log, "Transient pool heap: %.1f Mb, alignment = %u\n", double(m_TransientPoolHeapDesc.size) / (1024.0f * 1024.0f), m_TransientPoolHeapDesc.alignment);
+#endif
+
+    if (m_Desc.isTransientPoolMemoryExternal)
+        return true;
+
+    // Allocate and bind
+    nri::AllocateMemoryDesc allocateMemoryDesc = {};
+    allocateMemoryDesc.size = m_TransientPoolHeapDesc.size;
+    allocateMemoryDesc.type = m_TransientPoolHeapDesc.memoryType;
+    allocateMemoryDesc.priority = m_Desc.residencyPriority;
+
+    nri::Memory* memory = nullptr;
+    NRD_INTEGRATION_RETURN_FALSE_ON_FAILURE(m_iCore.AllocateMemory(*m_Device, allocateMemoryDesc, memory));
+    m_MemoryAllocations.push_back(memory);
+
+    return BindTransientPoolMemory(*memory, 0) == Result::SUCCESS;
+}
+
+Result Integration::BindTransientPoolMemory(nri::Memory& memory, uint64_t offset) {
+    NRD_INTEGRATION_ASSERT(m_Instance, "Uninitialized! Did you forget to call 'Recreate'?");
+    NRD_INTEGRATION_ASSERT(m_Desc.placeTransientPoolInHeap, "'placeTransientPoolInHeap' must be 'true'");
+    NRD_INTEGRATION_ASSERT(!m_TransientPoolHeapDesc.memory, "Transient pool memory is already bound");
+    NRD_INTEGRATION_ASSERT(offset % m_TransientPoolHeapDesc.alignment == 0, "'offset' must be aligned to 'TransientPoolHeapDesc::alignment'");
+
+    const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
+    const uint32_t textureNum = instanceDesc.transientPoolSize;
+
+    std::vector<nri::TextureMemoryBindingDesc> bindingDescs(textureNum);
+    for (uint32_t i = 0; i < textureNum; i++) {
+        const uint32_t poolIndex = instanceDesc.permanentPoolSize + i;
+
+        nri::TextureMemoryBindingDesc& bindingDesc = bindingDescs[i];
+        bindingDesc = {};
+        bindingDesc.texture = m_TexturePool[poolIndex].nri.texture;
+        bindingDesc.memory = &memory;
+        bindingDesc.offset = offset + m_PoolTextures[poolIndex].heapOffset;
+    }
+
+    if (textureNum && m_iCore.BindTextureMemory(*m_Device, bindingDescs.data(), textureNum) != nri::Result::SUCCESS)
+        return Result::FAILURE;
+
+    m_TransientPoolHeapDesc.memory = &memory;
+    m_TransientPoolHeapDesc.offset = offset;
+
+    return Result::SUCCESS;
+}
+
+void Integration::_RestartLazyDenoisers(const Identifier* denoisers, uint32_t denoisersNum) {
+    // History textures are going to be created on this frame, their contents must not leak into the output
+    for (uint32_t i = 0; i < denoisersNum; i++) {
+        for (DenoiserUsage& denoiserUsage : m_DenoiserUsages) {
+            if (denoiserUsage.identifier == denoisers[i] && denoiserUsage.isRestartNeeded) {
+                Result result = RestartDenoiser(*m_Instance, denoiserUsage.identifier);
+                NRD_INTEGRATION_ASSERT(result == Result::SUCCESS, "RestartDenoiser() failed!");
+                (void)result;
+
+                denoiserUsage.isRestartNeeded = false;
+            }
+        }
+    }
+}
+
+bool Integration::_AllocateLazyResources(const Identifier* denoisers, uint32_t denoisersNum, const DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum) {
+    const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
+
+    // Mark requested denoisers as used
+    for (uint32_t i = 0; i < denoisersNum; i++) {
+        for (DenoiserUsage& denoiserUsage : m_DenoiserUsages) {
+            if (denoiserUsage.identifier == denoisers[i])
+                denoiserUsage.lastUseFrameIndex = m_FrameIndex;
+        }
+    }
+
+    for (DenoiserUsage& denoiserUsage : m_DenoiserUsages)
+        denoiserUsage.isAllocationFailed = false;
+
+    // Create missing textures, referenced by dispatches
+    bool isAllocated = true;
+    for (uint32_t i = 0; i < dispatchDescsNum; i++) {
+        const DispatchDesc& dispatchDesc = dispatchDescs[i];
+
+        uint32_t owner = 0;
+        for (; owner < (uint32_t)m_DenoiserUsages.size(); owner++) {
+            if (m_DenoiserUsages[owner].identifier == dispatchDesc.identifier)
+                break;
+        }
+
+        for (uint32_t j = 0; j < dispatchDesc.resourcesNum; j++) {
+            const ResourceDesc& resourceDesc = dispatchDesc.resources[j];
+
+            uint32_t poolIndex = resourceDesc.indexInPool;
+            if (resourceDesc.type == ResourceType::TRANSIENT_POOL)
+                poolIndex += instanceDesc.permanentPoolSize;
+            else if (resourceDesc.type != ResourceType::PERMANENT_POOL)
+                continue;
+
+            // Register the owner (a transient texture can be shared between denoisers)
+            PoolTexture& poolTexture = m_PoolTextures[poolIndex];
+
+            size_t k = 0;
+            for (; k < poolTexture.owners.size(); k++) {
+                if (poolTexture.owners[k] == owner)
+                    break;
+            }
+
+            if (k == poolTexture.owners.size())
+                poolTexture.owners.push_back(owner);
+
+            // Create on first use (a dedicated allocation per texture is needed to be able to release it individually)
+            Resource& resource = m_TexturePool[poolIndex];
+            if (!resource.nri.texture && _CreateTexture(poolIndex)) {
+                nri::ResourceGroupDesc resourceGroupDesc = {};
+                resourceGroupDesc.memoryLocation = nri::MemoryLocation::DEVICE;
+                resourceGroupDesc.textureNum = 1;
+                resourceGroupDesc.textures = &resource.nri.texture;
+                resourceGroupDesc.residencyPriority = m_Desc.residencyPriority;
+
+                size_t allocationNum = m_iHelper.CalculateAllocationNumber(*m_Device, resourceGroupDesc);
+                poolTexture.memoryAllocations.resize(allocationNum, nullptr);
+
+                // Never referenced by the GPU, but retirement is the simplest way to release the texture and its partial allocations
+                if (m_iHelper.AllocateAndBindMemory(*m_Device, resourceGroupDesc, poolTexture.memoryAllocations.data()) != nri::Result::SUCCESS)
+                    _RetireTexture(poolIndex);
+            }
+
+            // Dispatches of the denoiser can't be recorded
+            if (!resource.nri.texture) {
+                NRD_INTEGRATION_ASSERT(false, "Texture creation failed!");
+
+                if (owner < (uint32_t)m_DenoiserUsages.size()) {
+                    DenoiserUsage& denoiserUsage = m_DenoiserUsages[owner];
+                    denoiserUsage.isAllocationFailed = true;
+                    denoiserUsage.isRestartNeeded = true;
+                }
+
+                isAllocated = false;
+            }
+        }
+    }
+
+    return isAllocated;
+}
+
+void Integration::_ReleaseUnusedResources() {
+    for (uint32_t i = 0; i < (uint32_t)m_TexturePool.size(); i++) {
+        if (!m_TexturePool[i].nri.texture)
+            continue;
+
+        // A texture is in use while at least one of its owners has been requested recently
+        bool isUsed = false;
+        for (uint32_t owner : m_PoolTextures[i].owners) {
+            if (m_FrameIndex - m_DenoiserUsages[owner].lastUseFrameIndex <= m_Desc.unusedResourceReleaseFrameNum)
+                isUsed = true;
+        }
+
+        if (!isUsed)
+            _RetireTexture(i);
+    }
+}
+
+void Integration::_RetireTexture(uint32_t poolIndex) {
+    const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
+    Resource& resource = m_TexturePool[poolIndex];
+    PoolTexture& poolTexture = m_PoolTextures[poolIndex];
+
+    // Forget cached descriptors (if not cached for the whole lifetime, they are destroyed along with "m_DescriptorsInFlight" entries)
+    uint64_t nativeObject = m_iCore.GetTextureNativeObject(resource.nri.texture);
+    for (uint32_t isStorage = 0; isStorage < 2; isStorage++) {
+        const auto& entry = m_CachedDescriptors.find(CreateDescriptorKey(nativeObject, isStorage != 0));
+        if (entry == m_CachedDescriptors.end())
+            continue;
+
+        nri::Descriptor* descriptor = entry->second;
+        m_CachedDescriptors.erase(entry);
+
+        if (m_Desc.enableWholeLifetimeDescriptorCaching) {
+            for (auto& descriptors : m_DescriptorsInFlight) {
+                for (size_t j = 0; j < descriptors.size(); j++) {
+                    if (descriptors[j] == descriptor) {
+                        descriptors[j] = descriptors.back();
+                        descriptors.pop_back();
+                        break;
+                    }
+                }
+            }
+
+            m_RetirementQueue.Retire(RetiredObjectType::DESCRIPTOR, descriptor, m_FrameIndex);
+        }
+    }
+
+    // Persistent descriptor sets can reference the texture
+    _RetirePersistentDescriptorSets();
+
+    // History of the owners is lost (transient textures don't survive between frames anyway)
+    if (poolIndex < instanceDesc.permanentPoolSize) {
+        for (uint32_t owner : poolTexture.owners) {
+            if (owner < (uint32_t)m_DenoiserUsages.size())
+                m_DenoiserUsages[owner].isRestartNeeded = true;
+        }
+    }
+
+    // Retire the texture and its memory
+    m_RetirementQueue.Retire(RetiredObjectType::TEXTURE, resource.nri.texture, m_FrameIndex);
+
+    for (nri::Memory* memory : poolTexture.memoryAllocations)
+        m_RetirementQueue.Retire(RetiredObjectType::MEMORY, memory, m_FrameIndex);
+    poolTexture.memoryAllocations.clear();
+
+    if (poolIndex < instanceDesc.permanentPoolSize)
+        m_PermanentPoolSize -= poolTexture.size;
+    else
+        m_TransientPoolSize -= poolTexture.size;
+
+#ifdef NRD_INTEGRATION_DEBUG_LOGGING
+    if (m_Log)
+        fprintf(m_Log, "Released unused texture #%u (%.1f Mb)\n", poolIndex, double(poolTexture.size) / (1024.0f * 1024.0f));
+#endif
+
+    poolTexture.size = 0;
+
+    resource.nri.texture = nullptr;
+    resource.state = {nri::AccessBits::NONE, nri::Layout::UNDEFINED};
+}
+
+void Integration::_ReleaseRetiredObject(const RetiredObject& retiredObject) {
+    switch (retiredObject.type) {
+        case RetiredObjectType::DESCRIPTOR:
+            m_iCore.DestroyDescriptor((nri::Descriptor*)retiredObject.object);
+            break;
+        case RetiredObjectType::PIPELINE:
+            m_iCore.DestroyPipeline((nri::Pipeline*)retiredObject.object);
+            break;
+        case RetiredObjectType::PIPELINE_LAYOUT:
+            m_iCore.DestroyPipelineLayout((nri::PipelineLayout*)retiredObject.object);
+            break;
+        case RetiredObjectType::DESCRIPTOR_POOL:
+            m_iCore.DestroyDescriptorPool((nri::DescriptorPool*)retiredObject.object);
+            break;
+        case RetiredObjectType::TEXTURE:
+            m_iCore.DestroyTexture((nri::Texture*)retiredObject.object);
+            break;
+        case RetiredObjectType::BUFFER:
+            m_iCore.DestroyBuffer((nri::Buffer*)retiredObject.object);
+            break;
+        case RetiredObjectType::MEMORY:
+            m_iCore.FreeMemory((nri::Memory*)retiredObject.object);
+            break;
+    }
+}
+
+void Integration::_RetireDescriptors() {
+    for (auto& descriptors : m_DescriptorsInFlight) {
+        for (const auto& descriptor : descriptors)
+            m_RetirementQueue.Retire(RetiredObjectType::DESCRIPTOR, descriptor, m_FrameIndex);
+
+        descriptors.clear();
+    }
+
+    m_CachedDescriptors.clear();
+}
+
+void Integration::_RetirePersistentDescriptorSets() {
+    for (const auto& entry : m_PersistentDescriptors)
+        m_RetirementQueue.Retire(RetiredObjectType::DESCRIPTOR, entry.second, m_FrameIndex);
+
+    m_RetirementQueue.Retire(RetiredObjectType::DESCRIPTOR_POOL, m_PersistentDescriptorPool, m_FrameIndex);
+
+    m_PersistentDescriptors.clear();
+    m_PersistentDescriptorSets.clear();
+    m_PersistentDescriptorPool = nullptr;
+}
+
+nri::DescriptorSet* Integration::_AllocatePersistentDescriptorSet(uint64_t hash, const uint32_t* signature, uint32_t signatureSize) {
+    // Created on demand, big enough for both ping-pong parities of all dispatches
+    if (!m_PersistentDescriptorPool) {
+        const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
+        uint32_t setMaxNum = instanceDesc.descriptorPoolDesc.setsMaxNum * 2;
+
+        nri::DescriptorPoolDesc descriptorPoolDesc = {};
+        descriptorPoolDesc.descriptorSetMaxNum = setMaxNum;
+        descriptorPoolDesc.textureMaxNum = setMaxNum * instanceDesc.descriptorPoolDesc.perSetTexturesMaxNum;
+        descriptorPoolDesc.storageTextureMaxNum = setMaxNum * instanceDesc.descriptorPoolDesc.perSetStorageTexturesMaxNum;
+
+        if (m_iCore.CreateDescriptorPool(*m_Device, descriptorPoolDesc, m_PersistentDescriptorPool) != nri::Result::SUCCESS)
+            return nullptr;
+    }
+
+    // If allocation fails, a per-frame descriptor set gets used instead
+    nri::DescriptorSet* descriptorSet = nullptr;
+    if (m_iCore.AllocateDescriptorSets(*m_PersistentDescriptorPool, *m_PipelineLayout, 0, &descriptorSet, 1, 0) != nri::Result::SUCCESS)
+        return nullptr;
+
+    PersistentDescriptorSet& persistentDescriptorSet = m_PersistentDescriptorSets[hash];
+    persistentDescriptorSet.signature.assign(signature, signature + signatureSize);
+    persistentDescriptorSet.descriptorSet = descriptorSet;
+
+#ifdef NRD_INTEGRATION_DEBUG_LOGGING
+    if (m_Log)
+        fprintf(m_Log, "Added persistent descriptor set (totalNum = %u)\n", (uint32_t)m_PersistentDescriptorSets.size());
+#endif
+
+    return descriptorSet;
+}
+
+void Integration::_RetireAll() {
+    // Objects can be referenced by the GPU in the current frame
+    _RetireDescriptors();
+    _RetirePersistentDescriptorSets();
+    m_RetirementQueue.Retire(RetiredObjectType::DESCRIPTOR, m_ConstantBufferView, m_FrameIndex);
+
+    for (nri::Pipeline* pipeline : m_Pipelines)
+        m_RetirementQueue.Retire(RetiredObjectType::PIPELINE, pipeline, m_FrameIndex);
+
+    m_RetirementQueue.Retire(RetiredObjectType::PIPELINE_LAYOUT, m_PipelineLayout, m_FrameIndex);
+
+    for (nri::DescriptorPool* descriptorPool : m_DescriptorPools)
+        m_RetirementQueue.Retire(RetiredObjectType::DESCRIPTOR_POOL, descriptorPool, m_FrameIndex);
+
+    for (const Resource& resource : m_TexturePool)
+        m_RetirementQueue.Retire(RetiredObjectType::TEXTURE, resource.nri.texture, m_FrameIndex);
+
+    m_RetirementQueue.Retire(RetiredObjectType::BUFFER, m_ConstantBuffer, m_FrameIndex);
+
+    if (m_TileFeedbackBuffer)
+        m_RetirementQueue.Retire(RetiredObjectType::BUFFER, m_TileFeedbackBuffer, m_FrameIndex);
+
+    for (const PoolTexture& poolTexture : m_PoolTextures) {
+        for (nri::Memory* memory : poolTexture.memoryAllocations)
+            m_RetirementQueue.Retire(RetiredObjectType::MEMORY, memory, m_FrameIndex);
+    }
+
+    for (nri::Memory* memory : m_MemoryAllocations)
+        m_RetirementQueue.Retire(RetiredObjectType::MEMORY, memory, m_FrameIndex);
+
+    // NRD instance is CPU-only
+    if (m_Instance)
+        DestroyInstance(*m_Instance);
+
+#ifdef NRD_INTEGRATION_DEBUG_LOGGING
+    if (m_Log) {
+        fprintf(m_Log, "Retired %u objects\n", (uint32_t)m_RetirementQueue.GetSize());
+        fclose(m_Log);
+        m_Log = nullptr;
+    }
+#endif
+
+    // Better keep in sync with the default values used by constructor (frame tracking and the device are preserved)
+    m_TexturePool.clear();
+    m_PoolTextures.clear();
+    m_DenoiserUsages.clear();
+    m_Pipelines.clear();
+    m_MemoryAllocations.clear();
+    m_DescriptorPools.clear();
+    m_DescriptorsInFlight.clear();
+    m_CachedDescriptors.clear();
+    m_ConstantBuffer = nullptr;
+    m_ConstantBufferView = nullptr;
+    m_PipelineLayout = nullptr;
+    m_Instance = nullptr;
+    m_PermanentPoolSize = 0;
+    m_TransientPoolSize = 0;
+    m_ConstantBufferSize = 0;
+    m_ConstantBufferViewSize = 0;
+    m_ConstantBufferOffset = 0;
+    m_ConstantBufferOffsetPrev = 0;
+    m_TransientPoolHeapDesc = {};
+    m_AllocatedDispatches.clear();
+    m_PreparedDispatches.clear();
+    m_PreparedTransitions.clear();
+    m_FinalTransitions.clear();
+    m_DenoiseChunks.clear();
+    m_DenoiseChunkOffsets.clear();
+    m_TileFeedbacks.clear();
+    m_TileFeedbackNum.clear();
+    m_TileFeedbackBuffer = nullptr;
+    m_TileFeedbackSlotSize = 0;
+    m_TileFeedbackRowPitch = 0;
+}
+
 void Integration::NewFrame() {
     NRD_INTEGRATION_ASSERT(m_Instance, "Uninitialized! Did you forget to call 'Recreate'?");
 
@@ -470,9 +1007,15 @@ void Integration::NewFrame() {
     // Current descriptor pool index
     m_DescriptorPoolIndex = m_FrameIndex % m_Desc.queuedFrameNum;
 
+    // Tile feedback written "queuedFrameNum" frames ago is not in-flight anymore
+    if (m_TileFeedbackBuffer)
+        _ReportTileFeedback();
+
     // Reset descriptor pool and samplers (since they are allocated from it)
-    nri::DescriptorPool* descriptorPool = m_DescriptorPools[m_DescriptorPoolIndex];
-    m_iCore.ResetDescriptorPool(*descriptorPool);
+    if (!m_Desc.enableBindless) {
+        nri::DescriptorPool* descriptorPool = m_DescriptorPools[m_DescriptorPoolIndex];
+        m_iCore.ResetDescriptorPool(*descriptorPool);
+    }
 
     // Referenced by the GPU descriptors can't be destroyed...
     if (!m_Desc.enableWholeLifetimeDescriptorCaching) {
@@ -489,19 +1032,53 @@ void Integration::NewFrame() {
         descriptors.clear();
     }
 
+    // Release retired objects, which are not in-flight anymore
+    [[maybe_unused]] uint32_t releasedNum = m_RetirementQueue.Release(m_FrameIndex, m_Desc.queuedFrameNum, [this](const RetiredObject& retiredObject) {
+        _ReleaseRetiredObject(retiredObject);
+    });
+
+#ifdef NRD_INTEGRATION_DEBUG_LOGGING
+    if (m_Log && releasedNum)
+        fprintf(m_Log, "Released %u retired objects (%u left)\n", releasedNum, (uint32_t)m_RetirementQueue.GetSize());
+#endif
+
+    // Retire textures of denoisers, which haven't been requested for a while
+    if (m_Desc.enableLazyResourceAllocation && m_Desc.unusedResourceReleaseFrameNum)
+        _ReleaseUnusedResources();
+
     m_PrevFrameIndexFromSettings++;
 }
 
 Result Integration::SetCommonSettings(const CommonSettings& commonSettings) {
     NRD_INTEGRATION_ASSERT(m_Instance, "Uninitialized! Did you forget to call 'Recreate'?");
-    NRD_INTEGRATION_ASSERT(commonSettings.resourceSize[0] == commonSettings.resourceSizePrev[0]
-            && commonSettings.resourceSize[1] == commonSettings.resourceSizePrev[1]
-            && commonSettings.resourceSize[0] == m_Desc.resourceWidth && commonSettings.resourceSize[1] == m_Desc.resourceHeight,
-        "NRD integration preallocates resources statically: DRS is only supported via 'rectSize / rectSizePrev'");
 
-    Result result = nrd::SetCommonSettings(*m_Instance, commonSettings);
+    CommonSettings modifiedCommonSettings = commonSettings;
+    if (m_Desc.enableDynamicResourceSize) {
+        NRD_INTEGRATION_ASSERT(commonSettings.resourceSize[0] <= m_Desc.resourceWidth && commonSettings.resourceSize[1] <= m_Desc.resourceHeight
+                && commonSettings.resourceSizePrev[0] <= m_Desc.resourceWidth && commonSettings.resourceSizePrev[1] <= m_Desc.resourceHeight,
+            "'resourceSize' and 'resourceSizePrev' can't exceed the upper bound, provided in 'Recreate'");
+
+        // The sub-region is a part of the viewport, since all textures have upper bound dimensions
+        for (uint32_t i = 0; i < 2; i++) {
+            modifiedCommonSettings.rectSize[i] = std::min(commonSettings.rectSize[i], commonSettings.resourceSize[i]);
+            modifiedCommonSettings.rectSizePrev[i] = std::min(commonSettings.rectSizePrev[i], commonSettings.resourceSizePrev[i]);
+        }
+
+        modifiedCommonSettings.resourceSize[0] = modifiedCommonSettings.resourceSizePrev[0] = m_Desc.resourceWidth;
+        modifiedCommonSettings.resourceSize[1] = modifiedCommonSettings.resourceSizePrev[1] = m_Desc.resourceHeight;
+    } else {
+        NRD_INTEGRATION_ASSERT(commonSettings.resourceSize[0] == commonSettings.resourceSizePrev[0]
+                && commonSettings.resourceSize[1] == commonSettings.resourceSizePrev[1]
+                && commonSettings.resourceSize[0] == m_Desc.resourceWidth && commonSettings.resourceSize[1] == m_Desc.resourceHeight,
+            "NRD integration preallocates resources statically: DRS is only supported via 'rectSize / rectSizePrev' (or 'enableDynamicResourceSize = true')");
+    }
+
+    Result result = nrd::SetCommonSettings(*m_Instance, modifiedCommonSettings);
     NRD_INTEGRATION_ASSERT(result == Result::SUCCESS, "SetCommonSettings() failed!");
 
+    m_RectSize[0] = modifiedCommonSettings.rectSize[0];
+    m_RectSize[1] = modifiedCommonSettings.rectSize[1];
+
     if (m_FrameIndex == 0 || commonSettings.accumulationMode != AccumulationMode::CONTINUE)
         m_PrevFrameIndexFromSettings = commonSettings.frameIndex;
     else
@@ -520,7 +1097,19 @@ Result Integration::SetDenoiserSettings(Identifier denoiser, const void* denoise
 }
 
 void Integration::Denoise(const Identifier* denoisers, uint32_t denoisersNum, nri::CommandBuffer& commandBuffer, ResourceSnapshot& resourceSnapshot) {
+    PrepareDenoise(denoisers, denoisersNum, resourceSnapshot, 1);
+    RecordDenoiseChunk(0, commandBuffer);
+    FinishDenoise(commandBuffer);
+}
+
+uint32_t Integration::PrepareDenoise(const Identifier* denoisers, uint32_t denoisersNum, ResourceSnapshot& resourceSnapshot, uint32_t chunkMaxNum) {
     NRD_INTEGRATION_ASSERT(m_Instance, "Uninitialized! Did you forget to call 'Recreate'?");
+    NRD_INTEGRATION_ASSERT(chunkMaxNum, "Can't be 0");
+
+    m_PreparedDispatches.clear();
+    m_PreparedTransitions.clear();
+    m_FinalTransitions.clear();
+    m_DenoiseChunks.clear();
 
     // Save initial state
     nri::AccessLayoutStage* initialStates = (nri::AccessLayoutStage*)alloca(sizeof(nri::AccessLayoutStage) * resourceSnapshot.uniqueNum);
@@ -557,39 +1146,94 @@ void Integration::Denoise(const Identifier* denoisers, uint32_t denoisersNum, nr
         NRD_INTEGRATION_ASSERT(isNormalRoughnessFormatValid, "IN_NORMAL_ROUGHNESS format doesn't match NRD normal encoding");
     }
 
+    // Dynamic resource size: NRD addresses app textures as upper bound sized, a smaller texture would be read and written out of bounds
+    if (m_Desc.enableDynamicResourceSize) {
+        bool isResourceSizeValid = true;
+        for (size_t i = 0; i < resourceSnapshot.uniqueNum; i++) {
+            const nri::Texture* texture = resourceSnapshot.unique[i].nri.texture;
+            if (texture) {
+                const nri::TextureDesc& textureDesc = m_iCore.GetTextureDesc(*texture);
+                if (textureDesc.width < m_Desc.resourceWidth || textureDesc.height < m_Desc.resourceHeight)
+                    isResourceSizeValid = false;
+            }
+        }
+
+        NRD_INTEGRATION_ASSERT(isResourceSizeValid, "'enableDynamicResourceSize = true': all 'IN_*' / 'OUT_*' textures must have upper bound dimensions");
+
+        // Skip denoising, but keep "RecordDenoiseChunk(0)" valid
+        if (!isResourceSizeValid) {
+            m_DispatchNum = 0;
+            m_ClearDispatchNum = 0;
+            m_DenoiseChunks.push_back({});
+
+            return 1;
+        }
+    }
+
+    // Denoisers, which textures are going to be (re)created, need a history reset
+    if (m_Desc.enableLazyResourceAllocation)
+        _RestartLazyDenoisers(denoisers, denoisersNum);
+
     // Retrieve dispatches
     const DispatchDesc* dispatchDescs = nullptr;
     uint32_t dispatchDescsNum = 0;
     GetComputeDispatches(*m_Instance, denoisers, denoisersNum, dispatchDescs, dispatchDescsNum);
 
+    // Create textures needed for the requested denoisers. Dispatches of denoisers with missing textures get skipped
+    if (m_Desc.enableLazyResourceAllocation && !_AllocateLazyResources(denoisers, denoisersNum, dispatchDescs, dispatchDescsNum)) {
+        m_AllocatedDispatches.clear();
+        for (uint32_t i = 0; i < dispatchDescsNum; i++) {
+            bool isAllocationFailed = false;
+            for (const DenoiserUsage& denoiserUsage : m_DenoiserUsages) {
+                if (denoiserUsage.identifier == dispatchDescs[i].identifier)
+                    isAllocationFailed = denoiserUsage.isAllocationFailed;
+            }
+
+            if (!isAllocationFailed)
+                m_AllocatedDispatches.push_back(dispatchDescs[i]);
+        }
+
+        dispatchDescs = m_AllocatedDispatches.data();
+        dispatchDescsNum = (uint32_t)m_AllocatedDispatches.size();
+    }
+
+    // The transient pool heap can be aliased by the app between "Denoise" calls
+    if (m_Desc.placeTransientPoolInHeap) {
+        NRD_INTEGRATION_ASSERT(m_TransientPoolHeapDesc.memory || !m_TransientPoolHeapDesc.size, "Transient pool memory is not bound! Did you forget to call 'BindTransientPoolMemory'?");
+
+        const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
+        for (uint32_t i = 0; i < instanceDesc.transientPoolSize; i++)
+            m_TexturePool[instanceDesc.permanentPoolSize + i].state = {nri::AccessBits::NONE, nri::Layout::UNDEFINED};
+    }
+
     // Even if descriptor caching is disabled it's better to cache descriptors inside a single "Denoise" call
     if (!m_Desc.enableWholeLifetimeDescriptorCaching)
         m_CachedDescriptors.clear();
 
-    // Set descriptor pool
-    nri::DescriptorPool* descriptorPool = m_DescriptorPools[m_DescriptorPoolIndex];
-    m_iCore.CmdSetDescriptorPool(commandBuffer, *descriptorPool);
-
-    // Invoke dispatches
-    constexpr uint32_t lawnGreen = 0xFF7CFC00;
-    constexpr uint32_t limeGreen = 0xFF32CD32;
+    // Prepare dispatches: descriptor sets, descriptors, constants and transitions. Recording doesn't modify the state
+    const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
 
-    m_iCore.CmdSetPipelineLayout(commandBuffer, nri::BindPoint::COMPUTE, *m_PipelineLayout);
+    m_DispatchNum = dispatchDescsNum;
+    m_ClearDispatchNum = 0;
 
     for (uint32_t i = 0; i < dispatchDescsNum; i++) {
         const DispatchDesc& dispatchDesc = dispatchDescs[i];
-        m_iCore.CmdBeginAnnotation(commandBuffer, dispatchDesc.name, (i & 0x1) ? lawnGreen : limeGreen);
 
-        _Dispatch(commandBuffer, *descriptorPool, dispatchDesc, resourceSnapshot);
+        const PipelineDesc& pipelineDesc = instanceDesc.pipelines[dispatchDesc.pipelineIndex];
+        if (pipelineDesc.type == PipelineType::CLEAR)
+            m_ClearDispatchNum++;
 
-        m_iCore.CmdEndAnnotation(commandBuffer);
+        if (m_Desc.enableBindless)
+            _PrepareDispatchBindless(dispatchDesc, resourceSnapshot);
+        else
+            _PrepareDispatch(*m_DescriptorPools[m_DescriptorPoolIndex], dispatchDesc, resourceSnapshot);
+
+        if (m_TileFeedbackBuffer && pipelineDesc.type == PipelineType::CLASSIFY_TILES)
+            _PrepareTileFeedback(dispatchDesc);
     }
 
     // Restore state
     if (resourceSnapshot.restoreInitialState) {
-        nri::TextureBarrierDesc* textureBarriers = (nri::TextureBarrierDesc*)alloca(sizeof(nri::TextureBarrierDesc) * resourceSnapshot.uniqueNum);
-        uint32_t textureBarrierNum = 0;
-
         for (size_t i = 0; i < resourceSnapshot.uniqueNum; i++) {
             Resource& resource = resourceSnapshot.unique[i];
             const nri::AccessLayoutStage& initialState = initialStates[i];
@@ -598,7 +1242,7 @@ void Integration::Denoise(const Identifier* denoisers, uint32_t denoisersNum, nr
             bool isUnknown = initialState.access == nri::AccessBits::NONE || initialState.layout == nri::Layout::UNDEFINED;
 
             if (resource.nri.texture && isDifferent && !isUnknown) {
-                nri::TextureBarrierDesc& barrier = textureBarriers[textureBarrierNum++];
+                nri::TextureBarrierDesc& barrier = m_FinalTransitions.emplace_back();
 
                 barrier = {};
                 barrier.texture = resource.nri.texture;
@@ -608,15 +1252,82 @@ void Integration::Denoise(const Identifier* denoisers, uint32_t denoisersNum, nr
                 resource.state = initialState;
             }
         }
+    }
 
-        if (textureBarrierNum) {
-            nri::BarrierDesc transitionBarriers = {};
-            transitionBarriers.textures = textureBarriers;
-            transitionBarriers.textureNum = textureBarrierNum;
-
-            m_iCore.CmdBarrier(commandBuffer, transitionBarriers);
+    // Split into chunks
+    m_DenoiseChunkOffsets.resize(chunkMaxNum + 1);
+    uint32_t chunkNum = PartitionDispatches(dispatchDescs, dispatchDescsNum, chunkMaxNum, m_DenoiseChunkOffsets.data());
+
+    for (uint32_t i = 0; i < chunkNum; i++) {
+        DenoiseChunkDesc& denoiseChunkDesc = m_DenoiseChunks.emplace_back();
+        denoiseChunkDesc = {};
+        denoiseChunkDesc.dispatchOffset = m_DenoiseChunkOffsets[i];
+        denoiseChunkDesc.dispatchNum = m_DenoiseChunkOffsets[i + 1] - m_DenoiseChunkOffsets[i];
+
+        // Transitions of the first dispatch stitch the chunk with the previous one
+        if (denoiseChunkDesc.dispatchNum) {
+            const PreparedDispatch& preparedDispatch = m_PreparedDispatches[denoiseChunkDesc.dispatchOffset];
+            denoiseChunkDesc.transitions = m_PreparedTransitions.data() + preparedDispatch.transitionOffset;
+            denoiseChunkDesc.transitionNum = preparedDispatch.transitionNum;
         }
     }
+
+    return chunkNum;
+}
+
+void Integration::RecordDenoiseChunk(uint32_t chunkIndex, nri::CommandBuffer& commandBuffer) const {
+    NRD_INTEGRATION_ASSERT(chunkIndex < m_DenoiseChunks.size(), "Out of bounds! Did you forget to call 'PrepareDenoise'?");
+
+    const DenoiseChunkDesc& denoiseChunkDesc = m_DenoiseChunks[chunkIndex];
+
+    // Set descriptor pool (bindless: the app must set its own descriptor pool)
+    nri::DescriptorPool* boundDescriptorPool = nullptr;
+    if (!m_Desc.enableBindless) {
+        boundDescriptorPool = m_DescriptorPools[m_DescriptorPoolIndex];
+        m_iCore.CmdSetDescriptorPool(commandBuffer, *boundDescriptorPool);
+    }
+
+    // Invoke dispatches
+    constexpr uint32_t lawnGreen = 0xFF7CFC00;
+    constexpr uint32_t limeGreen = 0xFF32CD32;
+
+    m_iCore.CmdSetPipelineLayout(commandBuffer, nri::BindPoint::COMPUTE, *m_PipelineLayout);
+
+    for (uint32_t i = denoiseChunkDesc.dispatchOffset; i < denoiseChunkDesc.dispatchOffset + denoiseChunkDesc.dispatchNum; i++) {
+        const PreparedDispatch& preparedDispatch = m_PreparedDispatches[i];
+        m_iCore.CmdBeginAnnotation(commandBuffer, preparedDispatch.name, (i & 0x1) ? lawnGreen : limeGreen);
+
+        _RecordDispatch(commandBuffer, preparedDispatch, boundDescriptorPool);
+
+        m_iCore.CmdEndAnnotation(commandBuffer);
+    }
+}
+
+void Integration::RecordQueueOwnershipTransfer(nri::CommandBuffer& commandBuffer, ResourceSnapshot& resourceSnapshot, const QueueFamily& src, const QueueFamily& dst, bool isRelease) const {
+    NRD_INTEGRATION_ASSERT(m_Instance, "Uninitialized! Did you forget to call 'Recreate'?");
+    NRD_INTEGRATION_ASSERT(!resourceSnapshot.restoreInitialState, "Initial states can be invalid on a different queue!");
+
+    nri::TextureBarrierDesc* textureBarriers = (nri::TextureBarrierDesc*)alloca(sizeof(nri::TextureBarrierDesc) * resourceSnapshot.uniqueNum);
+    uint32_t textureBarrierNum = GetQueueOwnershipTransfers(resourceSnapshot, src, dst, isRelease, textureBarriers);
+
+    if (textureBarrierNum) {
+        nri::BarrierDesc transitionBarriers = {};
+        transitionBarriers.textures = textureBarriers;
+        transitionBarriers.textureNum = textureBarrierNum;
+
+        m_iCore.CmdBarrier(commandBuffer, transitionBarriers);
+    }
+}
+
+void Integration::FinishDenoise(nri::CommandBuffer& commandBuffer) const {
+    if (m_FinalTransitions.empty())
+        return;
+
+    nri::BarrierDesc transitionBarriers = {};
+    transitionBarriers.textures = m_FinalTransitions.data();
+    transitionBarriers.textureNum = (uint32_t)m_FinalTransitions.size();
+
+    m_iCore.CmdBarrier(commandBuffer, transitionBarriers);
 }
 
 #ifdef NRI_WRAPPER_D3D11_H
@@ -694,8 +1405,8 @@ void Integration::DenoiseVK(const Identifier* denoisers, uint32_t denoisersNum,
         textureDesc.vkFormat = resource.vk.format;
         textureDesc.vkImageType = 1; // VK_IMAGE_TYPE_2D
         textureDesc.vkImageUsageFlags = 0x00000004 | 0x00000008; // VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT
-        textureDesc.width = m_Desc.resourceWidth;
-        textureDesc.height = m_Desc.resourceHeight;
+        textureDesc.width = resource.vk.width ? resource.vk.width : m_Desc.resourceWidth;
+        textureDesc.height = resource.vk.height ? resource.vk.height : m_Desc.resourceHeight;
         textureDesc.depth = 1;
         textureDesc.mipNum = 1;
         textureDesc.layerNum = 1;
@@ -720,22 +1431,52 @@ void Integration::DenoiseVK(const Identifier* denoisers, uint32_t denoisersNum,
 }
 #endif
 
-void Integration::_Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPool& descriptorPool, const DispatchDesc& dispatchDesc, ResourceSnapshot& resourceSnapshot) {
+void Integration::_PrepareDispatch(nri::DescriptorPool& descriptorPool, const DispatchDesc& dispatchDesc, ResourceSnapshot& resourceSnapshot) {
     const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
     const PipelineDesc& pipelineDesc = instanceDesc.pipelines[dispatchDesc.pipelineIndex];
 
     nri::Descriptor** descriptors = (nri::Descriptor**)alloca(sizeof(nri::Descriptor*) * dispatchDesc.resourcesNum);
-    nri::TextureBarrierDesc* transitions = (nri::TextureBarrierDesc*)alloca(sizeof(nri::TextureBarrierDesc) * dispatchDesc.resourcesNum);
-
-    nri::BarrierDesc transitionBarriers = {};
-    transitionBarriers.textures = transitions;
-
     uint32_t createdDescriptorNum = 0;
 
-    // Allocate descriptor sets
+    PreparedDispatch& preparedDispatch = m_PreparedDispatches.emplace_back();
+    preparedDispatch = {};
+    preparedDispatch.name = dispatchDesc.name;
+    preparedDispatch.transitionOffset = (uint32_t)m_PreparedTransitions.size();
+
+    // Find or allocate a persistent descriptor set (if only pool textures are referenced)
     nri::DescriptorSet* descriptorSet = nullptr;
-    nri::Result result = m_iCore.AllocateDescriptorSets(descriptorPool, *m_PipelineLayout, 0, &descriptorSet, 1, 0);
-    NRD_INTEGRATION_ASSERT(result == nri::Result::SUCCESS, "AllocateDescriptorSets() failed!");
+    nri::DescriptorPool* descriptorSetPool = &descriptorPool;
+    bool isDescriptorSetUpdateNeeded = true;
+    bool isPersistent = false;
+
+    if (m_Desc.enablePersistentDescriptorSets) {
+        uint32_t* signature = (uint32_t*)alloca(sizeof(uint32_t) * (pipelineDesc.resourceRangesNum + dispatchDesc.resourcesNum));
+        uint32_t signatureSize = GetDescriptorSetSignature(pipelineDesc, dispatchDesc, signature);
+
+        if (signatureSize) {
+            uint64_t hash = HashDescriptorSetSignature(signature, signatureSize);
+            const auto& entry = m_PersistentDescriptorSets.find(hash);
+
+            if (entry == m_PersistentDescriptorSets.end())
+                descriptorSet = _AllocatePersistentDescriptorSet(hash, signature, signatureSize);
+            else if (entry->second.signature.size() == signatureSize && !memcmp(entry->second.signature.data(), signature, sizeof(uint32_t) * signatureSize)) {
+                descriptorSet = entry->second.descriptorSet;
+                isDescriptorSetUpdateNeeded = false;
+            }
+
+            if (descriptorSet) {
+                descriptorSetPool = m_PersistentDescriptorPool;
+                isPersistent = true;
+            }
+        }
+    }
+
+    // Allocate a descriptor set for this frame
+    nri::Result result = nri::Result::SUCCESS;
+    if (!descriptorSet) {
+        result = m_iCore.AllocateDescriptorSets(descriptorPool, *m_PipelineLayout, 0, &descriptorSet, 1, 0);
+        NRD_INTEGRATION_ASSERT(result == nri::Result::SUCCESS, "AllocateDescriptorSets() failed!");
+    }
 
     // Fill descriptors and ranges
     std::array<nri::UpdateDescriptorRangeDesc, 2> descriptorRanges = {};
@@ -753,45 +1494,24 @@ void Integration::_Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPo
 
             for (uint32_t j = 0; j < resourceRange.descriptorsNum; j++) {
                 const ResourceDesc& resourceDesc = dispatchDesc.resources[n];
+                Resource* resource = _TransitionResource(resourceDesc, resourceSnapshot);
 
-                // Get resource
-                Resource* resource = nullptr;
-                if (resourceDesc.type == ResourceType::TRANSIENT_POOL)
-                    resource = &m_TexturePool[resourceDesc.indexInPool + instanceDesc.permanentPoolSize];
-                else if (resourceDesc.type == ResourceType::PERMANENT_POOL)
-                    resource = &m_TexturePool[resourceDesc.indexInPool];
-                else {
-                    resource = resourceSnapshot.slots[(uint32_t)resourceDesc.type];
-                    NRD_INTEGRATION_ASSERT(resource->nri.texture, "invalid entry!");
+                // Descriptors of a ready-to-use persistent descriptor set are not needed
+                if (!isDescriptorSetUpdateNeeded) {
+                    n++;
+                    continue;
                 }
 
-                // Prepare barrier
-                nri::AccessLayoutStage after = {};
-                if (resourceDesc.descriptorType == DescriptorType::TEXTURE)
-                    after = {nri::AccessBits::SHADER_RESOURCE, nri::Layout::SHADER_RESOURCE, nri::StageBits::COMPUTE_SHADER};
-                else
-                    after = {nri::AccessBits::SHADER_RESOURCE_STORAGE, nri::Layout::SHADER_RESOURCE_STORAGE, nri::StageBits::COMPUTE_SHADER};
-
-                bool isStateChanged = after.access != resource->state.access || after.layout != resource->state.layout;
-                bool isStorageBarrier = after.access == nri::AccessBits::SHADER_RESOURCE_STORAGE && resource->state.access == nri::AccessBits::SHADER_RESOURCE_STORAGE;
-                if (isStateChanged || isStorageBarrier) {
-                    nri::TextureBarrierDesc& barrier = transitions[transitionBarriers.textureNum++];
-
-                    barrier = {};
-                    barrier.texture = resource->nri.texture;
-                    barrier.before = resource->state;
-                    barrier.after = after;
-                }
-
-                resource->state = after;
+                // Persistent descriptor sets need persistent descriptors
+                std::map<uint64_t, nri::Descriptor*>& cachedDescriptors = isPersistent ? m_PersistentDescriptors : m_CachedDescriptors;
 
                 // Create descriptor
                 uint64_t nativeObject = m_iCore.GetTextureNativeObject(resource->nri.texture);
                 uint64_t key = CreateDescriptorKey(nativeObject, isStorage);
-                const auto& entry = m_CachedDescriptors.find(key);
+                const auto& entry = cachedDescriptors.find(key);
 
                 nri::Descriptor* descriptor = nullptr;
-                if (entry == m_CachedDescriptors.end()) {
+                if (entry == cachedDescriptors.end()) {
                     const nri::TextureDesc& textureDesc = m_iCore.GetTextureDesc(*resource->nri.texture);
 
                     nri::TextureViewDesc desc = {
@@ -807,8 +1527,9 @@ void Integration::_Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPo
                     result = m_iCore.CreateTextureView(desc, descriptor);
                     NRD_INTEGRATION_ASSERT(result == nri::Result::SUCCESS, "CreateTextureView() failed!");
 
-                    m_CachedDescriptors.insert(std::make_pair(key, descriptor));
-                    m_DescriptorsInFlight[m_DescriptorPoolIndex].push_back(descriptor);
+                    cachedDescriptors.insert(std::make_pair(key, descriptor));
+                    if (!isPersistent)
+                        m_DescriptorsInFlight[m_DescriptorPoolIndex].push_back(descriptor);
 
                     createdDescriptorNum++;
                 } else
@@ -825,19 +1546,7 @@ void Integration::_Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPo
     {
         // Stream data only if needed
         if (dispatchDesc.constantBufferDataSize && !dispatchDesc.constantBufferDataMatchesPreviousDispatch) {
-            // Ring-buffer logic
-            if (m_ConstantBufferOffset + m_ConstantBufferViewSize > m_ConstantBufferSize)
-                m_ConstantBufferOffset = 0;
-
-            dynamicConstantBufferOffset = m_ConstantBufferOffset;
-            m_ConstantBufferOffset += m_ConstantBufferViewSize;
-
-            // Upload CB data
-            void* data = m_iCore.MapBuffer(*m_ConstantBuffer, dynamicConstantBufferOffset, dispatchDesc.constantBufferDataSize);
-            if (data) {
-                memcpy(data, dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
-                m_iCore.UnmapBuffer(*m_ConstantBuffer);
-            }
+            dynamicConstantBufferOffset = _UploadConstants(dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
 
             // Save previous offset for potential CB data reuse
             m_ConstantBufferOffsetPrev = dynamicConstantBufferOffset;
@@ -848,80 +1557,277 @@ void Integration::_Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPo
     uint32_t baseRange = pipelineDesc.resourceRangesNum == 1 ? RANGE_STORAGES : RANGE_TEXTURES;
     uint32_t rangeNum = pipelineDesc.resourceRangesNum;
 
-    m_iCore.UpdateDescriptorRanges(&descriptorRanges[baseRange], rangeNum);
+    if (isDescriptorSetUpdateNeeded)
+        m_iCore.UpdateDescriptorRanges(&descriptorRanges[baseRange], rangeNum);
+
+    // Everything needed for recording
+    preparedDispatch.pipeline = m_Pipelines[dispatchDesc.pipelineIndex];
+    preparedDispatch.descriptorPool = descriptorSetPool;
+    preparedDispatch.descriptorSet = descriptorSet;
+    preparedDispatch.constantBufferOffset = dynamicConstantBufferOffset;
+    preparedDispatch.transitionNum = (uint32_t)m_PreparedTransitions.size() - preparedDispatch.transitionOffset;
+    preparedDispatch.gridWidth = dispatchDesc.gridWidth;
+    preparedDispatch.gridHeight = dispatchDesc.gridHeight;
+
+    // Per-dispatch events
+    if (m_DispatchEventRing.IsEnabled()) {
+        uint32_t constantBytes = dispatchDesc.constantBufferDataMatchesPreviousDispatch ? 0 : dispatchDesc.constantBufferDataSize;
+        _PushDispatchEvent(dispatchDesc, preparedDispatch, createdDescriptorNum, constantBytes, isPersistent ? DISPATCH_EVENT_PERSISTENT_DESCRIPTOR_SET : 0);
+    }
+}
+
+void Integration::_PrepareDispatchBindless(const DispatchDesc& dispatchDesc, ResourceSnapshot& resourceSnapshot) {
+    const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
+    const PipelineDesc& pipelineDesc = instanceDesc.pipelines[dispatchDesc.pipelineIndex];
+
+    uint32_t* heapIndices = (uint32_t*)alloca(sizeof(uint32_t) * dispatchDesc.resourcesNum);
+
+    PreparedDispatch& preparedDispatch = m_PreparedDispatches.emplace_back();
+    preparedDispatch = {};
+    preparedDispatch.name = dispatchDesc.name;
+    preparedDispatch.transitionOffset = (uint32_t)m_PreparedTransitions.size();
+
+    // Gather heap indices
+    for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++) {
+        const ResourceDesc& resourceDesc = dispatchDesc.resources[i];
+        Resource* resource = _TransitionResource(resourceDesc, resourceSnapshot);
+
+        bool isStorage = resourceDesc.descriptorType == DescriptorType::STORAGE_TEXTURE;
+        heapIndices[i] = m_Desc.bindlessDesc.GetDescriptorHeapIndex(m_Desc.bindlessDesc.userArg, *resource->nri.texture, isStorage);
+    }
+
+    // Update constants
+    uint32_t dynamicConstantBufferOffset = m_ConstantBufferOffsetPrev;
+    if (dispatchDesc.constantBufferDataSize && !dispatchDesc.constantBufferDataMatchesPreviousDispatch) {
+        dynamicConstantBufferOffset = _UploadConstants(dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
+        m_ConstantBufferOffsetPrev = dynamicConstantBufferOffset;
+    }
+
+    // Update index table
+    uint32_t table[BINDLESS_TABLE_SIZE] = {};
+    bool isTableValid = FillBindlessIndexTable(pipelineDesc, dispatchDesc, heapIndices, table);
+    NRD_INTEGRATION_ASSERT(isTableValid, "The dispatch doesn't fit into the bindless index table!");
+    (void)isTableValid;
+
+    // Everything needed for recording
+    preparedDispatch.pipeline = m_Pipelines[dispatchDesc.pipelineIndex];
+    preparedDispatch.constantBufferOffset = dynamicConstantBufferOffset;
+    preparedDispatch.bindlessTableOffset = _UploadConstants(table, sizeof(table));
+    preparedDispatch.transitionNum = (uint32_t)m_PreparedTransitions.size() - preparedDispatch.transitionOffset;
+    preparedDispatch.gridWidth = dispatchDesc.gridWidth;
+    preparedDispatch.gridHeight = dispatchDesc.gridHeight;
+
+    // Per-dispatch events (the index table is always uploaded)
+    if (m_DispatchEventRing.IsEnabled()) {
+        uint32_t constantBytes = dispatchDesc.constantBufferDataMatchesPreviousDispatch ? 0 : dispatchDesc.constantBufferDataSize;
+        _PushDispatchEvent(dispatchDesc, preparedDispatch, 0, constantBytes + (uint32_t)sizeof(table), DISPATCH_EVENT_BINDLESS);
+    }
+}
+
+void Integration::_PushDispatchEvent(const DispatchDesc& dispatchDesc, const PreparedDispatch& preparedDispatch, uint32_t createdDescriptorNum, uint32_t constantBytes, uint16_t flags) {
+    DispatchEvent* event = m_DispatchEventRing.BeginPush();
+    if (!event)
+        return;
 
-    // Rendering
-    nri::Pipeline* pipeline = m_Pipelines[dispatchDesc.pipelineIndex];
-    m_iCore.CmdSetPipeline(commandBuffer, *pipeline);
+    FillDispatchEvent(*event, dispatchDesc);
 
-    nri::SetDescriptorSetDesc resources = {0, descriptorSet};
-    m_iCore.CmdSetDescriptorSet(commandBuffer, resources);
+    event->timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    event->frameIndex = m_FrameIndex;
+    event->constantBytes = constantBytes;
+    event->barrierNum = (uint16_t)preparedDispatch.transitionNum;
+    event->createdDescriptorNum = (uint16_t)createdDescriptorNum;
+    event->flags = flags;
 
-    nri::SetRootDescriptorDesc constantBuffer = {0, m_ConstantBufferView, dynamicConstantBufferOffset};
+    m_DispatchEventRing.EndPush();
+}
+
+void Integration::_RecordDispatch(nri::CommandBuffer& commandBuffer, const PreparedDispatch& preparedDispatch, nri::DescriptorPool*& boundDescriptorPool) const {
+    m_iCore.CmdSetPipeline(commandBuffer, *preparedDispatch.pipeline);
+
+    // Persistent descriptor sets live in a different pool, which gets bound on demand
+    if (preparedDispatch.descriptorSet) {
+        if (preparedDispatch.descriptorPool != boundDescriptorPool) {
+            m_iCore.CmdSetDescriptorPool(commandBuffer, *preparedDispatch.descriptorPool);
+            boundDescriptorPool = preparedDispatch.descriptorPool;
+        }
+
+        nri::SetDescriptorSetDesc resources = {0, preparedDispatch.descriptorSet};
+        m_iCore.CmdSetDescriptorSet(commandBuffer, resources);
+    }
+
+    nri::SetRootDescriptorDesc constantBuffer = {0, m_ConstantBufferView, preparedDispatch.constantBufferOffset};
     m_iCore.CmdSetRootDescriptor(commandBuffer, constantBuffer);
 
+    if (m_Desc.enableBindless) {
+        nri::SetRootDescriptorDesc bindlessTable = {1, m_ConstantBufferView, preparedDispatch.bindlessTableOffset};
+        m_iCore.CmdSetRootDescriptor(commandBuffer, bindlessTable);
+    }
+
+    nri::BarrierDesc transitionBarriers = {};
+    transitionBarriers.textures = m_PreparedTransitions.data() + preparedDispatch.transitionOffset;
+    transitionBarriers.textureNum = preparedDispatch.transitionNum;
+
     m_iCore.CmdBarrier(commandBuffer, transitionBarriers);
-    m_iCore.CmdDispatch(commandBuffer, {dispatchDesc.gridWidth, dispatchDesc.gridHeight, 1});
+    m_iCore.CmdDispatch(commandBuffer, {preparedDispatch.gridWidth, preparedDispatch.gridHeight, 1});
 
-    // Debug logging
-#ifdef NRD_INTEGRATION_DEBUG_LOGGING
-    if (m_Log) {
-        if (createdDescriptorNum)
-            fprintf(m_Log, "Added %u cached descriptors (queued frame = %u, totalNum = %u)\n\n", createdDescriptorNum, m_DescriptorPoolIndex, (uint32_t)m_DescriptorsInFlight[m_DescriptorPoolIndex].size());
-
-        fprintf(m_Log, "%c Pipeline #%u : %s\n\t", dispatchDesc.constantBufferDataMatchesPreviousDispatch ? ' ' : '!', dispatchDesc.pipelineIndex, dispatchDesc.name);
-        for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++) {
-            const ResourceDesc& r = dispatchDesc.resources[i];
-
-            if (r.type == ResourceType::PERMANENT_POOL)
-                fprintf(m_Log, "P(%u) ", r.indexInPool);
-            else if (r.type == ResourceType::TRANSIENT_POOL)
-                fprintf(m_Log, "T(%u) ", r.indexInPool);
-            else {
-                const char* s = GetResourceTypeString(r.type);
-                fprintf(m_Log, "%s ", s);
-            }
-        }
-        fprintf(m_Log, "\n\n");
+    // Copy freshly classified tiles and return them to the tracked state
+    if (preparedDispatch.feedbackTexture) {
+        const TileFeedback& tileFeedback = m_TileFeedbacks[preparedDispatch.feedbackSlot];
+
+        nri::TextureBarrierDesc barrier = {};
+        barrier.texture = preparedDispatch.feedbackTexture;
+        barrier.before = {nri::AccessBits::SHADER_RESOURCE_STORAGE, nri::Layout::SHADER_RESOURCE_STORAGE, nri::StageBits::COMPUTE_SHADER};
+        barrier.after = {nri::AccessBits::COPY_SOURCE, nri::Layout::COPY_SOURCE, nri::StageBits::COPY};
+
+        nri::BarrierDesc feedbackBarriers = {};
+        feedbackBarriers.textures = &barrier;
+        feedbackBarriers.textureNum = 1;
+
+        m_iCore.CmdBarrier(commandBuffer, feedbackBarriers);
+
+        nri::TextureDataLayoutDesc dstDataLayout = {};
+        dstDataLayout.offset = m_TileFeedbackSlotSize * preparedDispatch.feedbackSlot;
+        dstDataLayout.rowPitch = m_TileFeedbackRowPitch;
+        dstDataLayout.slicePitch = (uint32_t)m_TileFeedbackSlotSize;
+
+        nri::TextureRegionDesc srcRegion = {};
+        srcRegion.width = (nri::Dim_t)tileFeedback.width;
+        srcRegion.height = (nri::Dim_t)tileFeedback.height;
+        srcRegion.depth = 1;
+
+        m_iCore.CmdReadbackTextureToBuffer(commandBuffer, *m_TileFeedbackBuffer, dstDataLayout, *preparedDispatch.feedbackTexture, srcRegion);
+
+        std::swap(barrier.before, barrier.after);
+        m_iCore.CmdBarrier(commandBuffer, feedbackBarriers);
     }
-#else
-    (void)createdDescriptorNum;
-#endif
 }
 
-void Integration::DestroyCachedDescriptors() {
-#ifdef NRD_INTEGRATION_DEBUG_LOGGING
-    if (m_Log)
-        fprintf(m_Log, "Destroy cached descriptors\n");
-#endif
+void Integration::_PrepareTileFeedback(const DispatchDesc& dispatchDesc) {
+    // The same denoiser can be denoised more than once per frame, the feedback is best-effort
+    uint32_t& feedbackNum = m_TileFeedbackNum[m_DescriptorPoolIndex];
+    if (feedbackNum == m_DenoiserUsages.size())
+        return;
 
-    if (!m_iCore.GetDeviceDesc)
+    // Tiles are the only output and always live in a pool
+    const ResourceDesc* tiles = nullptr;
+    for (uint32_t i = 0; i < dispatchDesc.resourcesNum && !tiles; i++) {
+        if (dispatchDesc.resources[i].descriptorType == DescriptorType::STORAGE_TEXTURE)
+            tiles = &dispatchDesc.resources[i];
+    }
+
+    NRD_INTEGRATION_ASSERT(tiles && (tiles->type == ResourceType::PERMANENT_POOL || tiles->type == ResourceType::TRANSIENT_POOL), "Unexpected tile classification output!");
+    if (!tiles)
         return;
 
-    _WaitForIdle();
+    const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
+    uint32_t poolIndex = tiles->indexInPool + (tiles->type == ResourceType::TRANSIENT_POOL ? instanceDesc.permanentPoolSize : 0);
+    nri::Texture* texture = m_TexturePool[poolIndex].nri.texture;
 
-    for (auto& descriptors : m_DescriptorsInFlight) {
-        for (const auto& descriptor : descriptors)
-            m_iCore.DestroyDescriptor(descriptor);
+    // Tile size is the downsample factor of the tiles texture (bigger for half resolution denoisers)
+    const TextureDesc& tilesDesc = tiles->type == ResourceType::TRANSIENT_POOL ? instanceDesc.transientPool[tiles->indexInPool] : instanceDesc.permanentPool[tiles->indexInPool];
 
-        descriptors.clear();
+    uint32_t slot = m_DescriptorPoolIndex * (uint32_t)m_DenoiserUsages.size() + feedbackNum++;
+
+    TileFeedback& tileFeedback = m_TileFeedbacks[slot];
+    tileFeedback.identifier = dispatchDesc.identifier;
+    tileFeedback.width = DivideUp(m_RectSize[0], tilesDesc.downsampleFactor);
+    tileFeedback.height = DivideUp(m_RectSize[1], tilesDesc.downsampleFactor);
+    tileFeedback.format = m_iCore.GetTextureDesc(*texture).format;
+
+    PreparedDispatch& preparedDispatch = m_PreparedDispatches.back();
+    preparedDispatch.feedbackTexture = texture;
+    preparedDispatch.feedbackSlot = slot;
+}
+
+void Integration::_ReportTileFeedback() {
+    uint32_t& feedbackNum = m_TileFeedbackNum[m_DescriptorPoolIndex];
+    if (!feedbackNum)
+        return;
+
+    uint32_t slotOffset = m_DescriptorPoolIndex * (uint32_t)m_DenoiserUsages.size();
+    const uint8_t* data = (const uint8_t*)m_iCore.MapBuffer(*m_TileFeedbackBuffer, m_TileFeedbackSlotSize * slotOffset, m_TileFeedbackSlotSize * feedbackNum);
+    if (data) {
+        for (uint32_t i = 0; i < feedbackNum; i++) {
+            const TileFeedback& tileFeedback = m_TileFeedbacks[slotOffset + i];
+            uint32_t activeTileNum = CountActiveTiles(data + m_TileFeedbackSlotSize * i, tileFeedback.width, tileFeedback.height, m_TileFeedbackRowPitch, tileFeedback.format);
+
+            SetDenoiserFeedback(*m_Instance, tileFeedback.identifier, activeTileNum);
+        }
+
+        m_iCore.UnmapBuffer(*m_TileFeedbackBuffer);
     }
 
-    m_CachedDescriptors.clear();
+    feedbackNum = 0;
 }
 
-void Integration::Destroy() {
+Resource* Integration::_TransitionResource(const ResourceDesc& resourceDesc, ResourceSnapshot& resourceSnapshot) {
+    const InstanceDesc& instanceDesc = *GetInstanceDesc(*m_Instance);
+
+    // Get resource
+    Resource* resource = nullptr;
+    if (resourceDesc.type == ResourceType::TRANSIENT_POOL)
+        resource = &m_TexturePool[resourceDesc.indexInPool + instanceDesc.permanentPoolSize];
+    else if (resourceDesc.type == ResourceType::PERMANENT_POOL)
+        resource = &m_TexturePool[resourceDesc.indexInPool];
+    else {
+        resource = resourceSnapshot.slots[(uint32_t)resourceDesc.type];
+        NRD_INTEGRATION_ASSERT(resource->nri.texture, "invalid entry!");
+    }
+
+    // Prepare barrier
+    nri::AccessLayoutStage after = {};
+    if (resourceDesc.descriptorType == DescriptorType::TEXTURE)
+        after = {nri::AccessBits::SHADER_RESOURCE, nri::Layout::SHADER_RESOURCE, nri::StageBits::COMPUTE_SHADER};
+    else
+        after = {nri::AccessBits::SHADER_RESOURCE_STORAGE, nri::Layout::SHADER_RESOURCE_STORAGE, nri::StageBits::COMPUTE_SHADER};
+
+    bool isStateChanged = after.access != resource->state.access || after.layout != resource->state.layout;
+    bool isStorageBarrier = after.access == nri::AccessBits::SHADER_RESOURCE_STORAGE && resource->state.access == nri::AccessBits::SHADER_RESOURCE_STORAGE;
+    if (isStateChanged || isStorageBarrier) {
+        nri::TextureBarrierDesc& barrier = m_PreparedTransitions.emplace_back();
+
+        barrier = {};
+        barrier.texture = resource->nri.texture;
+        barrier.before = resource->state;
+        barrier.after = after;
+    }
+
+    resource->state = after;
+
+    return resource;
+}
+
+uint32_t Integration::_UploadConstants(const void* data, uint32_t size) {
+    // Ring-buffer logic
+    if (m_ConstantBufferOffset + m_ConstantBufferViewSize > m_ConstantBufferSize)
+        m_ConstantBufferOffset = 0;
+
+    uint32_t offset = m_ConstantBufferOffset;
+    m_ConstantBufferOffset += m_ConstantBufferViewSize;
+
+    // Upload CB data
+    void* mappedData = m_iCore.MapBuffer(*m_ConstantBuffer, offset, size);
+    if (mappedData) {
+        memcpy(mappedData, data, size);
+        m_iCore.UnmapBuffer(*m_ConstantBuffer);
+    }
+
+    return offset;
+}
+
+void Integration::DestroyCachedDescriptors() {
 #ifdef NRD_INTEGRATION_DEBUG_LOGGING
     if (m_Log)
-        fprintf(m_Log, "Destroy\n");
+        fprintf(m_Log, "Destroy cached descriptors\n");
 #endif
 
-    if (m_iCore.GetDeviceDesc) {
-        _WaitForIdle();
+    if (!m_iCore.GetDeviceDesc)
+        return;
 
-        m_iCore.DestroyDescriptor(m_ConstantBufferView);
-        m_iCore.DestroyBuffer(m_ConstantBuffer);
-        m_iCore.DestroyPipelineLayout(m_PipelineLayout);
+    if (m_Desc.enableDeferredDestruction)
+        _RetireDescriptors();
+    else {
+        _WaitForIdle();
 
         for (auto& descriptors : m_DescriptorsInFlight) {
             for (const auto& descriptor : descriptors)
@@ -930,52 +1836,42 @@ void Integration::Destroy() {
             descriptors.clear();
         }
 
-        for (const Resource& resource : m_TexturePool)
-            m_iCore.DestroyTexture(resource.nri.texture);
+        m_CachedDescriptors.clear();
+    }
+}
 
-        for (nri::Pipeline* pipeline : m_Pipelines)
-            m_iCore.DestroyPipeline(pipeline);
+void Integration::Destroy() {
+#ifdef NRD_INTEGRATION_DEBUG_LOGGING
+    if (m_Log)
+        fprintf(m_Log, "Destroy\n");
+#endif
 
-        for (nri::Memory* memory : m_MemoryAllocations)
-            m_iCore.FreeMemory(memory);
+    // Everything (including previously retired objects) gets released immediately
+    if (m_iCore.GetDeviceDesc)
+        _WaitForIdle();
+
+    _RetireAll();
 
-        for (nri::DescriptorPool* descriptorPool : m_DescriptorPools)
-            m_iCore.DestroyDescriptorPool(descriptorPool);
+    if (m_iCore.GetDeviceDesc) {
+        m_RetirementQueue.ReleaseAll([this](const RetiredObject& retiredObject) {
+            _ReleaseRetiredObject(retiredObject);
+        });
 
         if (m_Wrapped != nri::GraphicsAPI::NONE)
             nri::nriDestroyDevice(m_Device);
     }
 
-    if (m_Instance)
-        DestroyInstance(*m_Instance);
-
     // Better keep in sync with the default values used by constructor
-    m_TexturePool.clear();
-    m_Pipelines.clear();
-    m_MemoryAllocations.clear();
-    m_DescriptorPools.clear();
-    m_DescriptorsInFlight.clear();
-    m_CachedDescriptors.clear();
     m_Desc = {};
     m_iCore = {};
+    m_iHelper = {};
     m_Device = nullptr;
-    m_Instance = nullptr;
-    m_PermanentPoolSize = 0;
-    m_TransientPoolSize = 0;
-    m_ConstantBufferSize = 0;
-    m_ConstantBufferViewSize = 0;
-    m_ConstantBufferOffset = 0;
-    m_ConstantBufferOffsetPrev = 0;
     m_DescriptorPoolIndex = 0;
     m_FrameIndex = uint32_t(-1);
     m_PrevFrameIndexFromSettings = 0;
+    m_WrappedNativeDevice = nullptr;
     m_Wrapped = nri::GraphicsAPI::NONE;
     m_SkipDestroy = false;
-
-#ifdef NRD_INTEGRATION_DEBUG_LOGGING
-    if (m_Log)
-        fclose(m_Log);
-#endif
 }
 
 void Integration::_WaitForIdle() {
@@ -0,0 +1,183 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Per-dispatch events, recorded by "Integration" if "IntegrationCreationDesc::dispatchEventRingSize != 0". Depends only on "NRD.h",
+// i.e. can be used by offline tools (see "Benchmark/DispatchEventsToChromeTrace.cpp")
+
+#pragma once
+
+// Dependencies
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#ifndef NRD_VERSION_MAJOR
+#    error "NRD.h" is not included
+#endif
+
+#define NRD_DISPATCH_EVENTS_SIGNATURE 0x4544524E // "NRDE"
+
+namespace nrd {
+
+//===================================================================================================
+// Event
+//===================================================================================================
+
+constexpr uint32_t DISPATCH_EVENT_NAME_MAX_SIZE = 48;
+constexpr uint32_t DISPATCH_EVENT_RESOURCE_MAX_NUM = 24;
+
+enum DispatchEventBits : uint16_t {
+    DISPATCH_EVENT_PERSISTENT_DESCRIPTOR_SET = 1 << 0,
+    DISPATCH_EVENT_BINDLESS = 1 << 1,
+};
+
+struct DispatchEvent {
+    uint64_t timestamp; // CPU time (ns, "steady_clock") of preparation, i.e. before recording
+    Identifier identifier;
+    uint32_t frameIndex; // "Integration::NewFrame" counter
+    uint32_t gridWidth;
+    uint32_t gridHeight;
+    uint32_t constantBytes; // uploaded to the constant buffer (0 if reused from the previous dispatch)
+    uint16_t pipelineIndex;
+    uint16_t barrierNum;
+    uint16_t createdDescriptorNum;
+    uint16_t flags; // DispatchEventBits
+    uint16_t resourcesNum; // can exceed "DISPATCH_EVENT_RESOURCE_MAX_NUM", the rest is not recorded
+    uint16_t padding;
+    uint32_t resources[DISPATCH_EVENT_RESOURCE_MAX_NUM]; // "ResourceType << 16 | indexInPool"
+    char name[DISPATCH_EVENT_NAME_MAX_SIZE]; // truncated, always null-terminated
+};
+
+// File layout expected by offline tools: "DispatchEventsFileHeader", followed by "DispatchEvent"s until the end of the file
+struct DispatchEventsFileHeader {
+    uint32_t signature; // NRD_DISPATCH_EVENTS_SIGNATURE
+    uint32_t eventSize; // sizeof(DispatchEvent)
+};
+
+// Appends drained events to a file opened in binary mode, the header is written first if the file is empty. Can be called for
+// every drained chunk. Returns "false" on a write error
+inline bool WriteDispatchEvents(FILE* file, const DispatchEvent* events, uint32_t eventsNum) {
+    if (ftell(file) == 0) {
+        DispatchEventsFileHeader header = {NRD_DISPATCH_EVENTS_SIGNATURE, (uint32_t)sizeof(DispatchEvent)};
+        if (fwrite(&header, sizeof(header), 1, file) != 1)
+            return false;
+    }
+
+    return fwrite(events, sizeof(DispatchEvent), eventsNum, file) == eventsNum;
+}
+
+inline void FillDispatchEvent(DispatchEvent& event, const DispatchDesc& dispatchDesc) {
+    event.identifier = dispatchDesc.identifier;
+    event.gridWidth = dispatchDesc.gridWidth;
+    event.gridHeight = dispatchDesc.gridHeight;
+    event.pipelineIndex = dispatchDesc.pipelineIndex;
+    event.resourcesNum = (uint16_t)dispatchDesc.resourcesNum;
+    event.padding = 0;
+
+    uint32_t n = dispatchDesc.resourcesNum < DISPATCH_EVENT_RESOURCE_MAX_NUM ? dispatchDesc.resourcesNum : DISPATCH_EVENT_RESOURCE_MAX_NUM;
+    for (uint32_t i = 0; i < n; i++) {
+        const ResourceDesc& resourceDesc = dispatchDesc.resources[i];
+        event.resources[i] = (uint32_t(resourceDesc.type) << 16) | resourceDesc.indexInPool;
+    }
+
+    const char* name = dispatchDesc.name ? dispatchDesc.name : "";
+    strncpy(event.name, name, DISPATCH_EVENT_NAME_MAX_SIZE - 1);
+    event.name[DISPATCH_EVENT_NAME_MAX_SIZE - 1] = '\0';
+}
+
+//===================================================================================================
+// Ring
+//===================================================================================================
+
+// Lock-free single-producer / single-consumer ring: "Integration" pushes while preparing dispatches, the app drains from
+// any (but only one) thread. Storage is preallocated in "Resize", if the ring is full new events are dropped and counted
+struct DispatchEventRing {
+    // "capacity" rounded up to a power of 2, 0 disables recording
+    static inline uint32_t GetAlignedCapacity(uint32_t capacity) {
+        uint32_t size = 0;
+        if (capacity) {
+            size = 1;
+            while (size < capacity)
+                size <<= 1;
+        }
+
+        return size;
+    }
+
+    inline uint32_t GetCapacity() const {
+        return (uint32_t)m_Events.size();
+    }
+
+    // Threadsafe: no, draining must be stopped. Not drained events are discarded
+    inline void Resize(uint32_t capacity) {
+        uint32_t size = GetAlignedCapacity(capacity);
+
+        m_Events.clear();
+        m_Events.shrink_to_fit();
+        m_Events.resize(size);
+        m_Mask = size ? size - 1 : 0;
+
+        m_Head.store(0, std::memory_order_relaxed);
+        m_Tail.store(0, std::memory_order_relaxed);
+        m_DroppedNum.store(0, std::memory_order_relaxed);
+    }
+
+    inline bool IsEnabled() const {
+        return !m_Events.empty();
+    }
+
+    // Producer: returns "nullptr" if full, otherwise the slot must be committed by "EndPush"
+    inline DispatchEvent* BeginPush() {
+        uint64_t head = m_Head.load(std::memory_order_relaxed);
+        uint64_t tail = m_Tail.load(std::memory_order_acquire);
+
+        if (head - tail >= m_Events.size()) {
+            m_DroppedNum.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        return &m_Events[head & m_Mask];
+    }
+
+    inline void EndPush() {
+        uint64_t head = m_Head.load(std::memory_order_relaxed);
+        m_Head.store(head + 1, std::memory_order_release);
+    }
+
+    // Consumer: copies up to "eventsMaxNum" oldest events, returns the number of copied events
+    inline uint32_t Drain(DispatchEvent* events, uint32_t eventsMaxNum) {
+        uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+        uint64_t head = m_Head.load(std::memory_order_acquire);
+
+        uint64_t available = head - tail;
+        uint32_t n = available < eventsMaxNum ? (uint32_t)available : eventsMaxNum;
+
+        for (uint32_t i = 0; i < n; i++)
+            events[i] = m_Events[(tail + i) & m_Mask];
+
+        m_Tail.store(tail + n, std::memory_order_release);
+
+        return n;
+    }
+
+    inline uint64_t GetDroppedNum() const {
+        return m_DroppedNum.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::vector<DispatchEvent> m_Events;
+    std::atomic<uint64_t> m_Head = {0}; // next slot to write
+    std::atomic<uint64_t> m_Tail = {0}; // next slot to read
+    std::atomic<uint64_t> m_DroppedNum = {0};
+    uint64_t m_Mask = 0;
+};
+
+} // namespace nrd
@@ -24,7 +24,7 @@ Versioning rules:
 */
 
 #define VERSION_MAJOR                   4
-#define VERSION_MINOR                   17
-#define VERSION_BUILD                   4
+#define VERSION_MINOR                   18
+#define VERSION_BUILD                   0
 
 #define VERSION_STRING STR(VERSION_MAJOR.VERSION_MINOR.VERSION_BUILD encoding=NRD_NORMAL_ENCODING.NRD_ROUGHNESS_ENCODING)
@@ -20,5 +20,16 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
 {
     NRD_CTA_ORDER_DEFAULT;
 
-    gOut[ pixelPos ] = 0;
+    #if( BATCH == 1 )
+        gOut0[ pixelPos ] = 0;
+        gOut1[ pixelPos ] = 0;
+        gOut2[ pixelPos ] = 0;
+        gOut3[ pixelPos ] = 0;
+        gOut4[ pixelPos ] = 0;
+        gOut5[ pixelPos ] = 0;
+        gOut6[ pixelPos ] = 0;
+        gOut7[ pixelPos ] = 0;
+    #else
+        gOut[ pixelPos ] = 0;
+    #endif
 }
@@ -15,11 +15,24 @@ NRD_CONSTANTS_START( Clear_Constants )
     NRD_CONSTANT( float, gDenoisingRange )
 NRD_CONSTANTS_END
 
+#if( FLOAT == 1 )
+    #define CLEAR_TYPE float4
+#else
+    #define CLEAR_TYPE uint4
+#endif
+
 NRD_OUTPUTS_START
-    #if( FLOAT == 1 )
-        NRD_OUTPUT( RWTexture2D, float4, gOut, u, 0 )
+    #if( BATCH == 1 )
+        NRD_OUTPUT( RWTexture2D, CLEAR_TYPE, gOut0, u, 0 )
+        NRD_OUTPUT( RWTexture2D, CLEAR_TYPE, gOut1, u, 1 )
+        NRD_OUTPUT( RWTexture2D, CLEAR_TYPE, gOut2, u, 2 )
+        NRD_OUTPUT( RWTexture2D, CLEAR_TYPE, gOut3, u, 3 )
+        NRD_OUTPUT( RWTexture2D, CLEAR_TYPE, gOut4, u, 4 )
+        NRD_OUTPUT( RWTexture2D, CLEAR_TYPE, gOut5, u, 5 )
+        NRD_OUTPUT( RWTexture2D, CLEAR_TYPE, gOut6, u, 6 )
+        NRD_OUTPUT( RWTexture2D, CLEAR_TYPE, gOut7, u, 7 )
     #else
-        NRD_OUTPUT( RWTexture2D, uint4, gOut, u, 0 )
+        NRD_OUTPUT( RWTexture2D, CLEAR_TYPE, gOut, u, 0 )
     #endif
 NRD_OUTPUTS_END
 
@@ -27,6 +40,9 @@ NRD_OUTPUTS_END
 #define ClearGroupX 16
 #define ClearGroupY 16
 
+// Number of outputs in "BATCH" permutation
+#define ClearBatchSize 8
+
 // Shader only
 #ifndef __cplusplus
 
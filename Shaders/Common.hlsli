@@ -50,6 +50,19 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
     #endif
 #endif
 
+#ifndef NRD_SUPPORTS_WAVE_INTRINSICS
+    #if( defined( NRD_COMPILER_DXC ) )
+        #define NRD_SUPPORTS_WAVE_INTRINSICS                    1
+    #else
+        #define NRD_SUPPORTS_WAVE_INTRINSICS                    0
+    #endif
+#else
+    #if( defined( NRD_COMPILER_FXC ) )
+        #undef NRD_SUPPORTS_WAVE_INTRINSICS
+        #define NRD_SUPPORTS_WAVE_INTRINSICS                    0
+    #endif
+#endif
+
 // Switches ( default 1 )
 #define NRD_USE_TILE_CHECK                                      1 // significantly improves performance by skipping computations in "empty" regions
 #define NRD_USE_DENANIFICATION                                  1 // needed only if inputs have NAN / INF outside of viewport or denoising range
@@ -135,13 +148,20 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define NRD_CTA_ORDER_DEFAULT \
     const int2 pixelPos = _pixelPos
 
+// Tile classification ( REBLUR and RELAX tiles can be shared, only "sky" is exact in R8_UNORM )
+#define NRD_TILE_SKY                                            1.0 // all pixels are out of denoising range
+#define NRD_TILE_ROUGH                                          0.5 // all pixels in denoising range are rough ( REBLUR only )
+
+// "ClassifyTiles" groups ( 8x4 threads per 16x16 tile ) fitting into one wave reduce via wave intrinsics, skipping SMEM atomics and barriers
+#define NRD_CLASSIFY_TILES_THREAD_NUM                           32
+
 // Preloading in SMEM
 #define BUFFER_X ( GROUP_X + NRD_BORDER * 2 )
 #define BUFFER_Y ( GROUP_Y + NRD_BORDER * 2 )
 
 #define PRELOAD_INTO_SMEM_WITH_TILE_CHECK \
     isSky *= NRD_USE_TILE_CHECK; \
-    if( isSky == 0.0 ) \
+    if( isSky != NRD_TILE_SKY ) \
     { \
         int2 groupBase = pixelPos - threadPos - NRD_BORDER; \
         uint stageNum = ( BUFFER_X * BUFFER_Y + GROUP_X * GROUP_Y - 1 ) / ( GROUP_X * GROUP_Y ); \
@@ -348,6 +368,31 @@ float GetSpecMagicCurve( float roughness, float power = 0.25 )
     return _NRD_GetSpecMagicCurve( roughness, power );
 }
 
+// Previous position and surface motion uv from "IN_MV" ( "mv" is already scaled by "mvScale.xyz" ), the same for all temporal passes
+float3 GetPrevPosition( float3 X, float viewZ, float2 pixelUv, float3 mv, float4 mvScale, float4x4 mWorldToViewPrev, float4x4 mWorldToClipPrev, float4 frustumPrev, float3 cameraDelta, float orthoMode, out float2 smbPixelUv )
+{
+    float3 Xprev = X;
+    smbPixelUv = pixelUv + mv.xy;
+
+    if( mvScale.w == 0.0 )
+    {
+        if( mvScale.z == 0.0 )
+            mv.z = Geometry::AffineTransform( mWorldToViewPrev, X ).z - viewZ;
+
+        float viewZprev = viewZ + mv.z;
+        float3 Xvprevlocal = Geometry::ReconstructViewPosition( smbPixelUv, frustumPrev, viewZprev, orthoMode ); // TODO: use "gOrthoModePrev"
+
+        Xprev = Geometry::RotateVectorInverse( mWorldToViewPrev, Xvprevlocal ) + cameraDelta;
+    }
+    else
+    {
+        Xprev += mv;
+        smbPixelUv = Geometry::GetScreenUv( mWorldToClipPrev, Xprev );
+    }
+
+    return Xprev;
+}
+
 float ComputeParallaxInPixels( float3 X, float2 uvForZeroParallax, float4x4 mWorldToClip, float2 rectSize )
 {
     // Both produce same results, but behavior is different on objects attached to the camera:
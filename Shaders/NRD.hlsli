@@ -8,7 +8,7 @@ distribution of this software and related documentation without an express
 license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
-// NRD v4.17
+// NRD v4.18
 
 // IMPORTANT: DO NOT MODIFY THIS FILE WITHOUT FULL RECOMPILATION OF NRD LIBRARY!
 
@@ -80,6 +80,11 @@ NOISY INPUTS:
 // Bindings
 #define NRD_CONSTANT_BUFFER_REGISTER_INDEX                                              0
 
+// Bindless ( "NRD_BINDLESS" ): per-dispatch table of descriptor heap indices ( inputs first, then outputs )
+#define NRD_BINDLESS_TABLE_REGISTER_INDEX                                               1 // in "NRD_CONSTANT_BUFFER_AND_SAMPLERS_SPACE_INDEX"
+#define NRD_BINDLESS_TEXTURES_MAX_NUM                                                   32
+#define NRD_BINDLESS_STORAGE_TEXTURES_MAX_NUM                                           16
+
 // Spaces ( NRD integration expects unique values )
 #define NRD_RESOURCES_SPACE_INDEX                                                       0 // SRVs and UAVs
 #define NRD_CONSTANT_BUFFER_AND_SAMPLERS_SPACE_INDEX                                    1 // constant buffer and samplers
@@ -145,13 +150,31 @@ NOISY INPUTS:
     #define NRD_CONSTANT( constantType, constantName )                                  constantType constantName;
     #define NRD_CONSTANTS_END                                                           };
 
-    #define NRD_INPUTS_START
-    #define NRD_INPUT( resourceType, dataType, resourceName, regName, bindingIndex )    resourceType<dataType> resourceName : register( NRD_MERGE_TOKENS( regName, bindingIndex ), NRD_MERGE_TOKENS( space, NRD_RESOURCES_SPACE_INDEX ) );
-    #define NRD_INPUTS_END
+    #ifdef NRD_BINDLESS
+        // SM 6.6+: textures are fetched from "ResourceDescriptorHeap" using indices from the per-dispatch table
+        cbuffer NrdBindlessTable : register( NRD_MERGE_TOKENS( b, NRD_BINDLESS_TABLE_REGISTER_INDEX ), NRD_MERGE_TOKENS( space, NRD_CONSTANT_BUFFER_AND_SAMPLERS_SPACE_INDEX ) )
+        {
+            uint4 gNrdBindlessTable[ ( NRD_BINDLESS_TEXTURES_MAX_NUM + NRD_BINDLESS_STORAGE_TEXTURES_MAX_NUM ) / 4 ];
+        };
 
-    #define NRD_OUTPUTS_START
-    #define NRD_OUTPUT( resourceType, dataType, resourceName, regName, bindingIndex )   NRD_FORMAT_UNKNOWN resourceType<dataType> resourceName : register( NRD_MERGE_TOKENS( regName, bindingIndex ), NRD_MERGE_TOKENS( space, NRD_RESOURCES_SPACE_INDEX ) );
-    #define NRD_OUTPUTS_END
+        #define NRD_BINDLESS_INDEX( slot )                                              gNrdBindlessTable[ ( slot ) / 4 ][ ( slot ) % 4 ]
+
+        #define NRD_INPUTS_START
+        #define NRD_INPUT( resourceType, dataType, resourceName, regName, bindingIndex ) static const resourceType<dataType> resourceName = ResourceDescriptorHeap[ NRD_BINDLESS_INDEX( bindingIndex ) ];
+        #define NRD_INPUTS_END
+
+        #define NRD_OUTPUTS_START
+        #define NRD_OUTPUT( resourceType, dataType, resourceName, regName, bindingIndex ) static const resourceType<dataType> resourceName = ResourceDescriptorHeap[ NRD_BINDLESS_INDEX( NRD_BINDLESS_TEXTURES_MAX_NUM + bindingIndex ) ];
+        #define NRD_OUTPUTS_END
+    #else
+        #define NRD_INPUTS_START
+        #define NRD_INPUT( resourceType, dataType, resourceName, regName, bindingIndex ) resourceType<dataType> resourceName : register( NRD_MERGE_TOKENS( regName, bindingIndex ), NRD_MERGE_TOKENS( space, NRD_RESOURCES_SPACE_INDEX ) );
+        #define NRD_INPUTS_END
+
+        #define NRD_OUTPUTS_START
+        #define NRD_OUTPUT( resourceType, dataType, resourceName, regName, bindingIndex ) NRD_FORMAT_UNKNOWN resourceType<dataType> resourceName : register( NRD_MERGE_TOKENS( regName, bindingIndex ), NRD_MERGE_TOKENS( space, NRD_RESOURCES_SPACE_INDEX ) );
+        #define NRD_OUTPUTS_END
+    #endif
 
     #define NRD_SAMPLERS_START
     #define NRD_SAMPLER( resourceType, resourceName, regName, bindingIndex )            resourceType resourceName : register( NRD_MERGE_TOKENS( regName, bindingIndex ), NRD_MERGE_TOKENS( space, NRD_CONSTANT_BUFFER_AND_SAMPLERS_SPACE_INDEX ) );
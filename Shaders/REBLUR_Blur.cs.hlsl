@@ -32,7 +32,7 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
 
     // Tile-based early out ( quad uniform )
     float isSky = gIn_Tiles[ pixelPos >> 4 ].x;
-    if( isSky != 0.0 )
+    if( isSky == NRD_TILE_SKY )
         return;
 
     // Non-linear accum speed
@@ -17,17 +17,14 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "Common.hlsli"
 
 groupshared int s_Sum;
+groupshared int s_SmoothSum;
 
 [numthreads( 8, 4, 1 )]
 NRD_EXPORT void NRD_CS_MAIN( uint2 threadPos : SV_GroupThreadID, uint2 tilePos : SV_GroupID, uint threadIndex : SV_GroupIndex )
 {
-    if( threadIndex == 0 )
-        s_Sum = 0;
-
-    GroupMemoryBarrierWithGroupSync();
-
     uint2 pixelPos = tilePos * 16 + threadPos * uint2( 2, 4 );
     int sum = 0;
+    int smoothSum = 0;
 
     [unroll]
     for( uint i = 0; i < 2; i++ )
@@ -39,17 +36,50 @@ NRD_EXPORT void NRD_CS_MAIN( uint2 threadPos : SV_GroupThreadID, uint2 tilePos :
             float viewZ = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( pos ) ] );
 
             sum += !IsInDenoisingRange( viewZ ) ? 1 : 0;
+
+            #if( REBLUR_USE_ROUGH_TILES_IN_TA == 1 )
+                float roughness = NRD_FrontEnd_UnpackNormalAndRoughness( gIn_Normal_Roughness[ WithRectOrigin( pos ) ] ).w;
+
+                smoothSum += ( IsInDenoisingRange( viewZ ) && roughness < REBLUR_ROUGH_TILE_MIN_ROUGHNESS ) ? 1 : 0;
+            #endif
         }
     }
 
-    InterlockedAdd( s_Sum, sum );
+    // Reduce
+    #if( NRD_SUPPORTS_WAVE_INTRINSICS == 1 )
+        if( WaveActiveCountBits( true ) == NRD_CLASSIFY_TILES_THREAD_NUM )
+        {
+            sum = WaveActiveSum( sum );
+            smoothSum = WaveActiveSum( smoothSum );
+        }
+        else
+    #endif
+    {
+        if( threadIndex == 0 )
+        {
+            s_Sum = 0;
+            s_SmoothSum = 0;
+        }
+
+        GroupMemoryBarrierWithGroupSync();
 
-    GroupMemoryBarrierWithGroupSync();
+        InterlockedAdd( s_Sum, sum );
+        InterlockedAdd( s_SmoothSum, smoothSum );
+
+        GroupMemoryBarrierWithGroupSync();
+
+        sum = s_Sum;
+        smoothSum = s_SmoothSum;
+    }
 
     if( threadIndex == 0 )
     {
-        float isSky = s_Sum == 256 ? 1.0 : 0.0;
+        float tile = 0.0;
+        if( sum == 256 )
+            tile = NRD_TILE_SKY;
+        else if( smoothSum == 0 && REBLUR_USE_ROUGH_TILES_IN_TA )
+            tile = NRD_TILE_ROUGH;
 
-        gOut_Tiles[ tilePos ] = isSky;
+        gOut_Tiles[ tilePos ] = tile;
     }
 }
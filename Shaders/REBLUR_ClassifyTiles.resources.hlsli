@@ -14,6 +14,7 @@ NRD_CONSTANTS_END
 
 NRD_INPUTS_START
     NRD_INPUT( Texture2D, float, gIn_ViewZ, t, 0 )
+    NRD_INPUT( Texture2D, float4, gIn_Normal_Roughness, t, 1 )
 NRD_INPUTS_END
 
 NRD_OUTPUTS_START
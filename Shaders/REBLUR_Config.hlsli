@@ -34,6 +34,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 // Switches ( default 0 )
 #define REBLUR_USE_SCREEN_SPACE_SAMPLING_FOR_SPECULAR           0 // specular is more complicated
 #define REBLUR_USE_DECOMPRESSED_HIT_DIST_IN_RECONSTRUCTION      0 // compression helps to preserve "lobe important" values
+#define REBLUR_USE_ROUGH_TILES_IN_TA                            0 // (opt-in) specular TA uses only surface motion in tiles classified as "rough"
 
 #if( NRD_MODE == NRD_MODE_OCCLUSION || NRD_MODE == NRD_MODE_DO )
     #undef NRD_SUPPORTS_ANTIFIREFLY
@@ -97,7 +98,10 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define REBLUR_ROUGHNESS_SENSITIVITY_IN_TA                      ( NRD_ROUGHNESS_SENSITIVITY * 0.3 )
 #define REBLUR_ANTILAG_MODE                                     2 // 0 - modernized old, 1 - overly reactive @ low FPS, 2 - best?
 #define REBLUR_MAX_PERCENT_OF_LOBE_VOLUME_FOR_PRE_PASS          0.3 // specially tuned for "hitDistForTracking"
+#define REBLUR_ROUGH_TILE_MIN_ROUGHNESS                         0.9 // matches regression of specular motion to surface motion in TA
 #define REBLUR_INVALID                                          -32768.0 // marks INF pixels, which must be ignored in SMEM involved calculations
+#define REBLUR_HALF_RES_DEPTH_THRESHOLD                         0.05 // relative "viewZ" delta, used by "Downsample" and "Upsample" in half resolution mode
+#define REBLUR_HALF_RES_NORMAL_POWER                            8.0
 
 // Data types
 #if( NRD_MODE == NRD_MODE_OCCLUSION )
@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+#include "NRD.hlsli"
+#include "ml.hlsli"
+
+#include "REBLUR_Config.hlsli"
+#include "REBLUR_Downsample.resources.hlsli"
+
+#include "Common.hlsli"
+
+// Half resolution mode: "pixelPos" is a half resolution pixel, constants describe the full resolution viewport
+[numthreads( GROUP_X, GROUP_Y, 1 )]
+NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
+{
+    NRD_CTA_ORDER_DEFAULT;
+
+    int2 fullPos = pixelPos * 2;
+    if( any( fullPos > gRectSizeMinusOne ) )
+        return;
+
+    // The closest surface of the 2x2 quad represents the quad, guides are copied as is to preserve encoding and material ID
+    float viewZs[ 4 ];
+    uint bestIndex = 0;
+
+    [unroll]
+    for( uint i = 0; i < 4; i++ )
+    {
+        int2 pos = min( fullPos + int2( i & 1, i >> 1 ), gRectSizeMinusOne );
+        viewZs[ i ] = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( pos ) ] );
+
+        if( viewZs[ i ] < viewZs[ bestIndex ] )
+            bestIndex = i;
+    }
+
+    int2 bestPos = min( fullPos + int2( bestIndex & 1, bestIndex >> 1 ), gRectSizeMinusOne );
+    float bestViewZ = viewZs[ bestIndex ];
+
+    gOut_ViewZ[ pixelPos ] = gIn_ViewZ[ WithRectOrigin( bestPos ) ];
+    gOut_Normal_Roughness[ pixelPos ] = gIn_Normal_Roughness[ WithRectOrigin( bestPos ) ];
+    gOut_Mv[ pixelPos ] = gIn_Mv[ WithRectOrigin( bestPos ) ];
+
+    // Average the signal over the quad pixels lying on the same surface
+    float4 sum = 0;
+    float weightSum = 0;
+
+    [unroll]
+    for( uint j = 0; j < 4; j++ )
+    {
+        int2 pos = min( fullPos + int2( j & 1, j >> 1 ), gRectSizeMinusOne );
+        bool isSameSurface = abs( viewZs[ j ] - bestViewZ ) <= REBLUR_HALF_RES_DEPTH_THRESHOLD * bestViewZ;
+
+        // Conditional add: the signal can be garbage outside of the denoising range
+        if( isSameSurface && IsInDenoisingRange( viewZs[ j ] ) )
+        {
+            sum += gIn_Diff[ pos ];
+            weightSum += 1.0;
+        }
+    }
+
+    gOut_Diff[ pixelPos ] = weightSum != 0.0 ? sum / weightSum : 0.0;
+}
@@ -0,0 +1,39 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+NRD_CONSTANTS_START( REBLUR_DownsampleConstants )
+    REBLUR_SHARED_CONSTANTS
+NRD_CONSTANTS_END
+
+NRD_INPUTS_START
+    NRD_INPUT( Texture2D, float, gIn_ViewZ, t, 0 )
+    NRD_INPUT( Texture2D, float4, gIn_Normal_Roughness, t, 1 )
+    NRD_INPUT( Texture2D, float4, gIn_Mv, t, 2 )
+    NRD_INPUT( Texture2D, float4, gIn_Diff, t, 3 )
+NRD_INPUTS_END
+
+NRD_OUTPUTS_START
+    NRD_OUTPUT( RWTexture2D, float, gOut_ViewZ, u, 0 )
+    NRD_OUTPUT( RWTexture2D, float4, gOut_Normal_Roughness, u, 1 )
+    NRD_OUTPUT( RWTexture2D, float4, gOut_Mv, u, 2 )
+    NRD_OUTPUT( RWTexture2D, float4, gOut_Diff, u, 3 )
+NRD_OUTPUTS_END
+
+// Macro magic
+#define REBLUR_DownsampleGroupX 8
+#define REBLUR_DownsampleGroupY 8
+
+// Shader only
+#ifndef __cplusplus
+
+#define GROUP_X REBLUR_DownsampleGroupX
+#define GROUP_Y REBLUR_DownsampleGroupY
+
+#endif
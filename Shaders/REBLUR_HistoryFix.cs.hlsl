@@ -51,7 +51,7 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
     PRELOAD_INTO_SMEM_WITH_TILE_CHECK;
 
     // Tile-based early out ( quad uniform )
-    if( isSky != 0.0 )
+    if( isSky == NRD_TILE_SKY )
         return;
 
     // Blur stride
@@ -60,7 +60,7 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
     PRELOAD_INTO_SMEM_WITH_TILE_CHECK;
 
     // Tile-based early out
-    if( isSky != 0.0 || any( pixelPos > gRectSizeMinusOne ) )
+    if( isSky == NRD_TILE_SKY || any( pixelPos > gRectSizeMinusOne ) )
         return;
 
     // Early out
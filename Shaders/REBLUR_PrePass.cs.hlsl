@@ -25,7 +25,7 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
 
     // Tile-based early out
     float isSky = gIn_Tiles[ pixelPos >> 4 ].x;
-    if( isSky != 0.0 || any( pixelPos > gRectSizeMinusOne ) )
+    if( isSky == NRD_TILE_SKY || any( pixelPos > gRectSizeMinusOne ) )
         return;
 
     // Early out
@@ -75,9 +75,11 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
     PRELOAD_INTO_SMEM_WITH_TILE_CHECK;
 
     // Tile-based early out
-    if( isSky != 0.0 || any( pixelPos > gRectSizeMinusOne ) )
+    if( isSky == NRD_TILE_SKY || any( pixelPos > gRectSizeMinusOne ) )
         return;
 
+    bool isRoughTile = abs( isSky - NRD_TILE_ROUGH ) < 0.25 && REBLUR_USE_ROUGH_TILES_IN_TA;
+
     // Early out
     float viewZ = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( pixelPos ) ] );
     if( !IsInDenoisingRange( viewZ ) )
@@ -143,24 +145,8 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
 
     // Previous position and surface motion uv
     float3 mv = gIn_Mv[ WithRectOrigin( pixelPos ) ] * gMvScale.xyz;
-    float3 Xprev = X;
-    float2 smbPixelUv = pixelUv + mv.xy;
-
-    if( gMvScale.w == 0.0 )
-    {
-        if( gMvScale.z == 0.0 )
-            mv.z = Geometry::AffineTransform( gWorldToViewPrev, X ).z - viewZ;
-
-        float viewZprev = viewZ + mv.z;
-        float3 Xvprevlocal = Geometry::ReconstructViewPosition( smbPixelUv, gFrustumPrev, viewZprev, gOrthoMode ); // TODO: use gOrthoModePrev
-
-        Xprev = Geometry::RotateVectorInverse( gWorldToViewPrev, Xvprevlocal ) + gCameraDelta.xyz;
-    }
-    else
-    {
-        Xprev += mv;
-        smbPixelUv = Geometry::GetScreenUv( gWorldToClipPrev, Xprev );
-    }
+    float2 smbPixelUv;
+    float3 Xprev = GetPrevPosition( X, viewZ, pixelUv, mv, gMvScale, gWorldToViewPrev, gWorldToClipPrev, gFrustumPrev, gCameraDelta.xyz, gOrthoMode, smbPixelUv );
 
     // Previous viewZ ( 4x4, surface motion )
     /*
@@ -215,7 +201,9 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
     }
 
     // Parallax
-    float smbParallaxInPixels1 = ComputeParallaxInPixels( Xprev + gCameraDelta.xyz, gOrthoMode == 0.0 ? smbPixelUv : pixelUv, gWorldToClipPrev, gRectSize );
+    // IMPORTANT: "smbParallaxInUv1" is also the direction of motion for curvature estimation
+    float2 smbParallaxInUv1 = Geometry::GetScreenUv( gWorldToClipPrev, Xprev + gCameraDelta.xyz ) - ( gOrthoMode == 0.0 ? smbPixelUv : pixelUv );
+    float smbParallaxInPixels1 = length( smbParallaxInUv1 * gRectSize );
     float smbParallaxInPixels2 = ComputeParallaxInPixels( Xprev - gCameraDelta.xyz, gOrthoMode == 0.0 ? pixelUv : smbPixelUv, gWorldToClip, gRectSize );
 
     float smbParallaxInPixelsMax = max( smbParallaxInPixels1, smbParallaxInPixels2 );
@@ -376,315 +364,332 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
             }
         #endif
 
-        // Curvature estimation along predicted motion ( tests 15, 40, 76, 133, 146, 147, 148 )
-        /*
-        TODO: curvature! (-_-)
-         - by design: curvature = 0 on static objects if camera is static
-         - quantization errors hurt
-         - curvature on bumpy surfaces is just wrong, pulling virtual positions into a surface and introducing lags
-         - suboptimal reprojection if curvature changes signs under motion
-        */
+        // Virtual motion
+        // Tiles classified as "rough" contain only pixels, where specular motion regresses to surface motion. The
+        // branch is tile-uniform ( a group never crosses a tile ), i.e. such groups skip virtual motion tracking entirely
         float curvature = 0.0;
+        float2 vmbPixelUv = smbPixelUv;
+        float4 vmbOcclusionWeights = smbOcclusionWeights;
+        float vmbSpecAccumSpeed = smbSpecAccumSpeed;
+        float vmbNoN = smbNoN;
+        float virtualHistoryConfidence = 1.0;
+        bool vmbAllowCatRom = smbAllowCatRom;
+
+        [branch]
+        if( isRoughTile )
+        {
+            // Same disocclusion bits for "smb" and "vmb"
+            fbits += smbOcclusion0.z * 16.0;
+            fbits += smbOcclusion1.y * 32.0;
+            fbits += smbOcclusion2.y * 64.0;
+            fbits += smbOcclusion3.x * 128.0;
+        }
+        else
         {
-            // IMPORTANT: non-zero parallax on objects attached to the camera is needed
-            // IMPORTANT: the direction of "deltaUv" is important ( test 1 )
-            float2 uvForZeroParallax = gOrthoMode == 0.0 ? smbPixelUv : pixelUv;
-            float2 deltaUv = uvForZeroParallax - Geometry::GetScreenUv( gWorldToClipPrev, Xprev + gCameraDelta.xyz ); // TODO: repeats code for "smbParallaxInPixels1" with "-" sign
-            deltaUv *= gRectSize;
-            deltaUv /= max( smbParallaxInPixels1, 1.0 / 256.0 );
-
-            // 10 edge
-            float3 n10, x10;
+            // Curvature estimation along predicted motion ( tests 15, 40, 76, 133, 146, 147, 148 )
+            /*
+            TODO: curvature! (-_-)
+             - by design: curvature = 0 on static objects if camera is static
+             - quantization errors hurt
+             - curvature on bumpy surfaces is just wrong, pulling virtual positions into a surface and introducing lags
+             - suboptimal reprojection if curvature changes signs under motion
+            */
+            curvature = 0.0;
             {
-                float3 xv = Geometry::ReconstructViewPosition( pixelUv + float2( 1, 0 ) * gRectSizeInv, gFrustum, 1.0, gOrthoMode );
-                float3 x = Geometry::RotateVector( gViewToWorld, xv );
-                float3 v = GetViewVector( x );
-                float3 o = gOrthoMode == 0.0 ? 0 : x;
-
-                x10 = o + v * dot( X - o, N ) / dot( N, v ); // line-plane intersection
-                n10 = s_Normal_HitDistForTracking[ threadPos.y + NRD_BORDER ][ threadPos.x + NRD_BORDER + 1 ].xyz;
+                // IMPORTANT: non-zero parallax on objects attached to the camera is needed
+                // IMPORTANT: the direction of "deltaUv" is important ( test 1 )
+                float2 deltaUv = -smbParallaxInUv1;
+                deltaUv *= gRectSize;
+                deltaUv /= max( smbParallaxInPixels1, 1.0 / 256.0 );
+
+                // 10 edge
+                float3 n10, x10;
+                {
+                    float3 xv = Geometry::ReconstructViewPosition( pixelUv + float2( 1, 0 ) * gRectSizeInv, gFrustum, 1.0, gOrthoMode );
+                    float3 x = Geometry::RotateVector( gViewToWorld, xv );
+                    float3 v = GetViewVector( x );
+                    float3 o = gOrthoMode == 0.0 ? 0 : x;
+
+                    x10 = o + v * dot( X - o, N ) / dot( N, v ); // line-plane intersection
+                    n10 = s_Normal_HitDistForTracking[ threadPos.y + NRD_BORDER ][ threadPos.x + NRD_BORDER + 1 ].xyz;
+                }
+
+                // 01 edge
+                float3 n01, x01;
+                {
+                    float3 xv = Geometry::ReconstructViewPosition( pixelUv + float2( 0, 1 ) * gRectSizeInv, gFrustum, 1.0, gOrthoMode );
+                    float3 x = Geometry::RotateVector( gViewToWorld, xv );
+                    float3 v = GetViewVector( x );
+                    float3 o = gOrthoMode == 0.0 ? 0 : x;
+
+                    x01 = o + v * dot( X - o, N ) / dot( N, v ); // line-plane intersection
+                    n01 = s_Normal_HitDistForTracking[ threadPos.y + NRD_BORDER + 1 ][ threadPos.x + NRD_BORDER ].xyz;
+                }
+
+                // Mix
+                float2 ww = abs( deltaUv ) + 1.0 / 256.0;
+                ww /= ww.x + ww.y; // TODO: perspective correction?
+
+                float3 x = x10 * ww.x + x01 * ww.y;
+                float3 n = normalize( n10 * ww.x + n01 * ww.y );
+
+                // High parallax - flattens surface on high motion ( test 132, 172, 173, 174, 190, 201, 202, 203, e9 )
+                // - "smbParallaxInPixelsMin" is used to get "0" ( ignore "high parallax" ) on objects attached to the camera
+                // - increasing stride helps in corner cases due to better flattening, but on average it works worse ( test 1 if FPS <= 60 )
+                float2 motionUvHigh = pixelUv + smbParallaxInPixelsMin * deltaUv * gRectSizeInv;
+
+                // sqrt( 2.0 ) offers a smooth transition from one calculations to another without a hard border
+                if( smbParallaxInPixelsMin > sqrt( 2.0 ) && IsInScreenNearest( motionUvHigh ) )
+                {
+                    float2 uvScaled = WithRectOffset( ClampUvToViewport( motionUvHigh ) );
+
+                    float zHigh = UnpackViewZ( gIn_ViewZ.SampleLevel( gLinearClamp, uvScaled, 0 ) );
+                    float3 xHigh = Geometry::ReconstructViewPosition( motionUvHigh, gFrustum, zHigh, gOrthoMode );
+                    xHigh = Geometry::RotateVector( gViewToWorld, xHigh );
+
+                    float3 nHigh = NRD_FrontEnd_UnpackNormalAndRoughness( gIn_Normal_Roughness.SampleLevel( STOCHASTIC_BILINEAR_FILTER, StochasticBilinear( uvScaled, gRectSize ), 0 ) ).xyz;
+
+                    // Replace if same surface
+                    float2 geometryWeightParams = GetGeometryWeightParams( NRD_CURVATURE_HIGH_PARALLAX_DISOCCLUSION_THRESHOLD, frustumSize, X, N );
+                    float NoX = dot( N, xHigh );
+
+                    float w = ApplyGeometryWeightLast( 1.0, zHigh, NoX, geometryWeightParams );
+                    bool cmp = w > 0.5;
+
+                    n = cmp ? nHigh : n;
+                    x = cmp ? xHigh : x;
+                }
+
+                // Estimate curvature for the edge { x; X }
+                float3 edge = x - X;
+                float edgeLenSq = Math::LengthSquared( edge );
+                curvature = dot( n - N, edge ) * Math::PositiveRcp( edgeLenSq );
+
+                // Correction - very negative inconsistent with previous frame curvature blows up reprojection ( tests 164, 171 - 176 )
+                if( curvature < 0 )
+                {
+                    float2 uv1 = Geometry::GetScreenUv( gWorldToClipPrev, GetXvirtual( hitDistForTracking, curvature, X, X, N, V, roughness ) );
+                    float2 uv2 = Geometry::GetScreenUv( gWorldToClipPrev, X );
+                    float a = length( ( uv1 - uv2 ) * gRectSize );
+                    curvature *= float( a < NRD_MAX_ALLOWED_VIRTUAL_MOTION_ACCELERATION * smbParallaxInPixelsMax + gRectSizeInv.x );
+                }
             }
 
-            // 01 edge
-            float3 n01, x01;
-            {
-                float3 xv = Geometry::ReconstructViewPosition( pixelUv + float2( 0, 1 ) * gRectSizeInv, gFrustum, 1.0, gOrthoMode );
-                float3 x = Geometry::RotateVector( gViewToWorld, xv );
-                float3 v = GetViewVector( x );
-                float3 o = gOrthoMode == 0.0 ? 0 : x;
+            // Virtual motion - coordinates
+            float3 Xvirtual = GetXvirtual( hitDistForTracking, curvature, X, Xprev, N, V, roughness );
+            float XvirtualLength = length( Xvirtual );
+            float hitDistanceToLobeSpreadInPixels = 1.0 / PixelRadiusToWorld( gUnproject, gOrthoMode, 1.0, XvirtualLength );
 
-                x01 = o + v * dot( X - o, N ) / dot( N, v ); // line-plane intersection
-                n01 = s_Normal_HitDistForTracking[ threadPos.y + NRD_BORDER + 1 ][ threadPos.x + NRD_BORDER ].xyz;
-            }
+            vmbPixelUv = Geometry::GetScreenUv( gWorldToClipPrev, Xvirtual );
+            vmbPixelUv = materialID == gCameraAttachedReflectionMaterialID ? smbPixelUv : vmbPixelUv;
 
-            // Mix
-            float2 ww = abs( deltaUv ) + 1.0 / 256.0;
-            ww /= ww.x + ww.y; // TODO: perspective correction?
+            float2 vmbDelta = vmbPixelUv - smbPixelUv;
+            float vmbPixelsTraveled = length( vmbDelta * gRectSize );
 
-            float3 x = x10 * ww.x + x01 * ww.y;
-            float3 n = normalize( n10 * ww.x + n01 * ww.y );
+            Filtering::Bilinear vmbBilinearFilter = Filtering::GetBilinearFilter( vmbPixelUv, gRectSizePrev );
+            float2 vmbBilinearGatherUv = ( vmbBilinearFilter.origin + 1.0 ) * gResourceSizeInvPrev;
 
-            // High parallax - flattens surface on high motion ( test 132, 172, 173, 174, 190, 201, 202, 203, e9 )
-            // - "smbParallaxInPixelsMin" is used to get "0" ( ignore "high parallax" ) on objects attached to the camera
-            // - increasing stride helps in corner cases due to better flattening, but on average it works worse ( test 1 if FPS <= 60 )
-            float2 motionUvHigh = pixelUv + smbParallaxInPixelsMin * deltaUv * gRectSizeInv;
-
-            // sqrt( 2.0 ) offers a smooth transition from one calculations to another without a hard border
-            if( smbParallaxInPixelsMin > sqrt( 2.0 ) && IsInScreenNearest( motionUvHigh ) )
+            // Virtual motion - confidence: roughness
+            float4 roughnessWeights;
             {
-                float2 uvScaled = WithRectOffset( ClampUvToViewport( motionUvHigh ) );
-
-                float zHigh = UnpackViewZ( gIn_ViewZ.SampleLevel( gLinearClamp, uvScaled, 0 ) );
-                float3 xHigh = Geometry::ReconstructViewPosition( motionUvHigh, gFrustum, zHigh, gOrthoMode );
-                xHigh = Geometry::RotateVector( gViewToWorld, xHigh );
+                float2 relaxedRoughnessWeightParams = GetRelaxedRoughnessWeightParams( roughness * roughness, gRoughnessFraction, REBLUR_ROUGHNESS_SENSITIVITY_IN_TA ); // TODO: GetRoughnessWeightParams with 0.05 sensitivity?
 
-                float3 nHigh = NRD_FrontEnd_UnpackNormalAndRoughness( gIn_Normal_Roughness.SampleLevel( STOCHASTIC_BILINEAR_FILTER, StochasticBilinear( uvScaled, gRectSize ), 0 ) ).xyz;
-
-                // Replace if same surface
-                float2 geometryWeightParams = GetGeometryWeightParams( NRD_CURVATURE_HIGH_PARALLAX_DISOCCLUSION_THRESHOLD, frustumSize, X, N );
-                float NoX = dot( N, xHigh );
+                #if( NRD_NORMAL_ENCODING == NRD_NORMAL_ENCODING_R10G10B10A2_UNORM )
+                    float4 vmbRoughness = NRD_FrontEnd_UnpackRoughness( gPrev_Normal_Roughness.GatherBlue( gNearestClamp, vmbBilinearGatherUv ).wzxy );
+                #else
+                    float4 vmbRoughness = NRD_FrontEnd_UnpackRoughness( gPrev_Normal_Roughness.GatherAlpha( gNearestClamp, vmbBilinearGatherUv ).wzxy );
+                #endif
 
-                float w = ApplyGeometryWeightLast( 1.0, zHigh, NoX, geometryWeightParams );
-                bool cmp = w > 0.5;
+                roughnessWeights = ComputeNonExponentialWeight( vmbRoughness * vmbRoughness, relaxedRoughnessWeightParams.x, relaxedRoughnessWeightParams.y );
+                roughnessWeights = lerp( 1.0, roughnessWeights, Math::SmoothStep01( vmbPixelsTraveled ) ); // jitter friendly
 
-                n = cmp ? nHigh : n;
-                x = cmp ? xHigh : x;
+                float roughnessWeight = Filtering::ApplyBilinearFilter( roughnessWeights.x, roughnessWeights.y, roughnessWeights.z, roughnessWeights.w, vmbBilinearFilter );
+                virtualHistoryConfidence = roughnessWeight;
             }
 
-            // Estimate curvature for the edge { x; X }
-            float3 edge = x - X;
-            float edgeLenSq = Math::LengthSquared( edge );
-            curvature = dot( n - N, edge ) * Math::PositiveRcp( edgeLenSq );
-
-            // Correction - very negative inconsistent with previous frame curvature blows up reprojection ( tests 164, 171 - 176 )
-            if( curvature < 0 )
+            float4 vmbN;
+            float4 vmbNoN2x2;
             {
-                float2 uv1 = Geometry::GetScreenUv( gWorldToClipPrev, GetXvirtual( hitDistForTracking, curvature, X, X, N, V, roughness ) );
-                float2 uv2 = Geometry::GetScreenUv( gWorldToClipPrev, X );
-                float a = length( ( uv1 - uv2 ) * gRectSize );
-                curvature *= float( a < NRD_MAX_ALLOWED_VIRTUAL_MOTION_ACCELERATION * smbParallaxInPixelsMax + gRectSizeInv.x );
-            }
-        }
-
-        // Virtual motion - coordinates
-        float3 Xvirtual = GetXvirtual( hitDistForTracking, curvature, X, Xprev, N, V, roughness );
-        float XvirtualLength = length( Xvirtual );
-        float hitDistanceToLobeSpreadInPixels = 1.0 / PixelRadiusToWorld( gUnproject, gOrthoMode, 1.0, XvirtualLength );
-
-        float2 vmbPixelUv = Geometry::GetScreenUv( gWorldToClipPrev, Xvirtual );
-        vmbPixelUv = materialID == gCameraAttachedReflectionMaterialID ? smbPixelUv : vmbPixelUv;
-
-        float2 vmbDelta = vmbPixelUv - smbPixelUv;
-        float vmbPixelsTraveled = length( vmbDelta * gRectSize );
-
-        Filtering::Bilinear vmbBilinearFilter = Filtering::GetBilinearFilter( vmbPixelUv, gRectSizePrev );
-        float2 vmbBilinearGatherUv = ( vmbBilinearFilter.origin + 1.0 ) * gResourceSizeInvPrev;
-
-        // Virtual motion - confidence: roughness
-        float virtualHistoryConfidence;
-        float4 roughnessWeights;
-        {
-            float2 relaxedRoughnessWeightParams = GetRelaxedRoughnessWeightParams( roughness * roughness, gRoughnessFraction, REBLUR_ROUGHNESS_SENSITIVITY_IN_TA ); // TODO: GetRoughnessWeightParams with 0.05 sensitivity?
-
-            #if( NRD_NORMAL_ENCODING == NRD_NORMAL_ENCODING_R10G10B10A2_UNORM )
-                float4 vmbRoughness = NRD_FrontEnd_UnpackRoughness( gPrev_Normal_Roughness.GatherBlue( gNearestClamp, vmbBilinearGatherUv ).wzxy );
-            #else
-                float4 vmbRoughness = NRD_FrontEnd_UnpackRoughness( gPrev_Normal_Roughness.GatherAlpha( gNearestClamp, vmbBilinearGatherUv ).wzxy );
-            #endif
-
-            roughnessWeights = ComputeNonExponentialWeight( vmbRoughness * vmbRoughness, relaxedRoughnessWeightParams.x, relaxedRoughnessWeightParams.y );
-            roughnessWeights = lerp( 1.0, roughnessWeights, Math::SmoothStep01( vmbPixelsTraveled ) ); // jitter friendly
-
-            float roughnessWeight = Filtering::ApplyBilinearFilter( roughnessWeights.x, roughnessWeights.y, roughnessWeights.z, roughnessWeights.w, vmbBilinearFilter );
-            virtualHistoryConfidence = roughnessWeight;
-        }
-
-        float4 vmbN;
-        float4 vmbNoN2x2;
-        float vmbNoN;
-        {
-            float3 Nt = N; // IMPORTANT: yes, "N"
-
-            #if( NRD_USE_PREV_WORLD_SPACE_MATRIX == 1 )
-                Nt = Geometry::RotateVectorInverse( gWorldPrevToWorld, Nt ); // to "prev" world space
-            #endif
-
-            int3 p = int3( vmbBilinearFilter.origin, 0 );
-            float4 n00 = NRD_FrontEnd_UnpackNormalAndRoughness( gPrev_Normal_Roughness.Load( p ) );
-            float4 n10 = NRD_FrontEnd_UnpackNormalAndRoughness( gPrev_Normal_Roughness.Load( p, int2( 1, 0 ) ) );
-            float4 n01 = NRD_FrontEnd_UnpackNormalAndRoughness( gPrev_Normal_Roughness.Load( p, int2( 0, 1 ) ) );
-            float4 n11 = NRD_FrontEnd_UnpackNormalAndRoughness( gPrev_Normal_Roughness.Load( p, int2( 1, 1 ) ) );
-
-            vmbNoN2x2.x = dot( n00.xyz, Nt );
-            vmbNoN2x2.y = dot( n10.xyz, Nt );
-            vmbNoN2x2.z = dot( n01.xyz, Nt );
-            vmbNoN2x2.w = dot( n11.xyz, Nt );
-
-            vmbNoN = Filtering::ApplyBilinearFilter( vmbNoN2x2.x, vmbNoN2x2.y, vmbNoN2x2.z, vmbNoN2x2.w, vmbBilinearFilter );
+                float3 Nt = N; // IMPORTANT: yes, "N"
 
-            vmbN = Filtering::ApplyBilinearFilter( n00, n10, n01, n11, vmbBilinearFilter );
-            vmbN.xyz = _NRD_SafeNormalize( vmbN.xyz );
-
-            #if( NRD_USE_PREV_WORLD_SPACE_MATRIX == 1 )
-                vmbN.xyz = Geometry::RotateVector( gWorldPrevToWorld, vmbN.xyz ); // from "prev" world space
-            #endif
-        }
+                #if( NRD_USE_PREV_WORLD_SPACE_MATRIX == 1 )
+                    Nt = Geometry::RotateVectorInverse( gWorldPrevToWorld, Nt ); // to "prev" world space
+                #endif
 
-        // Virtual motion - disocclusion
-        float4 vmbOcclusionWeights;
-        float vmbSpecAccumSpeed;
-        bool vmbAllowCatRom;
-        {
-            // Disocclusion
-            float4 vmbOcclusionThreshold = float4( vmbNoN2x2 > cosMaxAngle ); // normal // TODO: use lobe angle?
-            vmbOcclusionThreshold *= step( 0.5, roughnessWeights ); // roughness
-            vmbOcclusionThreshold *= IsInScreenBilinear( vmbBilinearFilter.origin, gRectSizePrev ); // in screen
-            vmbOcclusionThreshold *= disocclusionThreshold * frustumSize;
-            vmbOcclusionThreshold *= lerp( 0.1, 1.0, NoV ); // IMPORTANT: yes, "*" not "/"! This is a must for test 168 ( see contact shadow behind the heating radiator ), without this rare bright samples may stretch
-            vmbOcclusionThreshold -= NRD_EPS;
-
-            float4 vmbViewZ = UnpackViewZ( gPrev_ViewZ.GatherRed( gNearestClamp, vmbBilinearGatherUv ).wzxy );
-            float3 vmbVv = Geometry::ReconstructViewPosition( vmbPixelUv, gFrustumPrev, 1.0 ); // unnormalized, orthoMode = 0
-            float3 Nv = Geometry::RotateVector( gWorldToViewPrev, N );
-            float NoXcurr = dot( N, Xprev - gCameraDelta.xyz );
-            float4 NoXprev = ( Nv.x * vmbVv.x + Nv.y * vmbVv.y ) * ( gOrthoMode == 0 ? vmbViewZ : gOrthoMode ) + Nv.z * vmbVv.z * vmbViewZ;
-            float4 vmbPlaneDist = abs( NoXprev - NoXcurr );
-
-            float4 vmbOcclusion = step( vmbPlaneDist, vmbOcclusionThreshold ) * IsInDenoisingRange( vmbViewZ );
-
-            // Prev data
-            uint4 vmbInternalData = gPrev_InternalData.GatherRed( gNearestClamp, vmbBilinearGatherUv ).wzxy;
-
-            float3 vmbInternalData00 = UnpackInternalData( vmbInternalData.x );
-            float3 vmbInternalData10 = UnpackInternalData( vmbInternalData.y );
-            float3 vmbInternalData01 = UnpackInternalData( vmbInternalData.z );
-            float3 vmbInternalData11 = UnpackInternalData( vmbInternalData.w );
-
-            #if( NRD_NORMAL_ENCODING == NRD_NORMAL_ENCODING_R10G10B10A2_UNORM )
-                // Disocclusion: material ID
-                float4 vmbMaterialID = float4( vmbInternalData00.z, vmbInternalData10.z, vmbInternalData01.z, vmbInternalData11.z  );
-                vmbOcclusion *= CompareMaterials( materialID, vmbMaterialID, gSpecMinMaterial );
-            #endif
+                int3 p = int3( vmbBilinearFilter.origin, 0 );
+                float4 n00 = NRD_FrontEnd_UnpackNormalAndRoughness( gPrev_Normal_Roughness.Load( p ) );
+                float4 n10 = NRD_FrontEnd_UnpackNormalAndRoughness( gPrev_Normal_Roughness.Load( p, int2( 1, 0 ) ) );
+                float4 n01 = NRD_FrontEnd_UnpackNormalAndRoughness( gPrev_Normal_Roughness.Load( p, int2( 0, 1 ) ) );
+                float4 n11 = NRD_FrontEnd_UnpackNormalAndRoughness( gPrev_Normal_Roughness.Load( p, int2( 1, 1 ) ) );
 
-            // Save disocclusion bits
-            fbits += vmbOcclusion.x * 16.0;
-            fbits += vmbOcclusion.y * 32.0;
-            fbits += vmbOcclusion.z * 64.0;
-            fbits += vmbOcclusion.w * 128.0;
+                vmbNoN2x2.x = dot( n00.xyz, Nt );
+                vmbNoN2x2.y = dot( n10.xyz, Nt );
+                vmbNoN2x2.z = dot( n01.xyz, Nt );
+                vmbNoN2x2.w = dot( n11.xyz, Nt );
 
-            // Accumulation speed
-            vmbOcclusionWeights = Filtering::GetBilinearCustomWeights( vmbBilinearFilter, vmbOcclusion );
-            vmbSpecAccumSpeed = Filtering::ApplyBilinearCustomWeights( vmbInternalData00.y, vmbInternalData10.y, vmbInternalData01.y, vmbInternalData11.y, vmbOcclusionWeights );
+                vmbNoN = Filtering::ApplyBilinearFilter( vmbNoN2x2.x, vmbNoN2x2.y, vmbNoN2x2.z, vmbNoN2x2.w, vmbBilinearFilter );
 
-            float vmbFootprintQuality = Filtering::ApplyBilinearFilter( vmbOcclusion.x, vmbOcclusion.y, vmbOcclusion.z, vmbOcclusion.w, vmbBilinearFilter );
-            vmbFootprintQuality = Math::Sqrt01( vmbFootprintQuality );
+                vmbN = Filtering::ApplyBilinearFilter( n00, n10, n01, n11, vmbBilinearFilter );
+                vmbN.xyz = _NRD_SafeNormalize( vmbN.xyz );
 
-            float vmbSpecHistoryConfidence = vmbFootprintQuality;
-            if( gHasHistoryConfidence && NRD_SUPPORTS_HISTORY_CONFIDENCE )
-            {
-                float confidence = saturate( gIn_SpecConfidence.SampleLevel( gLinearClamp, vmbPixelUv, 0 ) );
-                vmbSpecHistoryConfidence = min( vmbSpecHistoryConfidence, confidence );
+                #if( NRD_USE_PREV_WORLD_SPACE_MATRIX == 1 )
+                    vmbN.xyz = Geometry::RotateVector( gWorldPrevToWorld, vmbN.xyz ); // from "prev" world space
+                #endif
             }
-            vmbSpecAccumSpeed *= lerp( vmbSpecHistoryConfidence, 1.0, 1.0 / ( 1.0 + vmbSpecAccumSpeed ) );
 
-            // Is CatRom allowed? ( requires complete "vmbOcclusion" )
-            vmbAllowCatRom = dot( vmbOcclusion, 1.0 ) > 3.5 && REBLUR_USE_CATROM_FOR_VIRTUAL_MOTION_IN_TA;
-            vmbAllowCatRom = vmbAllowCatRom && smbAllowCatRom; // helps to reduce over-sharpening in disoccluded areas
-        }
-
-        // Estimate how many pixels are traveled by virtual motion - how many radians can it be?
-        float curvatureAngle;
-        float lobeHalfAngle;
-        {
-            // IMPORTANT: if curvature angle is multiplied by path length then we can get an angle exceeding "2 * PI", what is impossible.
-            // The max angle is PI ( most left and most right points on a hemisphere ), it can be achieved by using "tan" instead of angle.
-            float curvatureAngleTan = pixelSize * abs( curvature ); // tana = pixelSize / curvatureRadius = pixelSize * curvature
-            curvatureAngleTan *= max( vmbPixelsTraveled / max( NoV, 0.01 ), 1.0 ); // path length
-            curvatureAngleTan *= 2.0; // TODO: why it's here? but works well
-
-            curvatureAngle = atan( curvatureAngleTan );
-
-            // Copied from "GetNormalWeightParam" but doesn't use "lobeAngleFraction"
-            float percentOfVolume = NRD_MAX_PERCENT_OF_LOBE_VOLUME / ( 1.0 + vmbSpecAccumSpeed );
-            float lobeTanHalfAngle = ImportanceSampling::GetSpecularLobeTanHalfAngle( roughness, percentOfVolume );
+            // Virtual motion - disocclusion
+            {
+                // Disocclusion
+                float4 vmbOcclusionThreshold = float4( vmbNoN2x2 > cosMaxAngle ); // normal // TODO: use lobe angle?
+                vmbOcclusionThreshold *= step( 0.5, roughnessWeights ); // roughness
+                vmbOcclusionThreshold *= IsInScreenBilinear( vmbBilinearFilter.origin, gRectSizePrev ); // in screen
+                vmbOcclusionThreshold *= disocclusionThreshold * frustumSize;
+                vmbOcclusionThreshold *= lerp( 0.1, 1.0, NoV ); // IMPORTANT: yes, "*" not "/"! This is a must for test 168 ( see contact shadow behind the heating radiator ), without this rare bright samples may stretch
+                vmbOcclusionThreshold -= NRD_EPS;
+
+                float4 vmbViewZ = UnpackViewZ( gPrev_ViewZ.GatherRed( gNearestClamp, vmbBilinearGatherUv ).wzxy );
+                float3 vmbVv = Geometry::ReconstructViewPosition( vmbPixelUv, gFrustumPrev, 1.0 ); // unnormalized, orthoMode = 0
+                float3 Nv = Geometry::RotateVector( gWorldToViewPrev, N );
+                float NoXcurr = dot( N, Xprev - gCameraDelta.xyz );
+                float4 NoXprev = ( Nv.x * vmbVv.x + Nv.y * vmbVv.y ) * ( gOrthoMode == 0 ? vmbViewZ : gOrthoMode ) + Nv.z * vmbVv.z * vmbViewZ;
+                float4 vmbPlaneDist = abs( NoXprev - NoXcurr );
+
+                float4 vmbOcclusion = step( vmbPlaneDist, vmbOcclusionThreshold ) * IsInDenoisingRange( vmbViewZ );
+
+                // Prev data
+                uint4 vmbInternalData = gPrev_InternalData.GatherRed( gNearestClamp, vmbBilinearGatherUv ).wzxy;
+
+                float3 vmbInternalData00 = UnpackInternalData( vmbInternalData.x );
+                float3 vmbInternalData10 = UnpackInternalData( vmbInternalData.y );
+                float3 vmbInternalData01 = UnpackInternalData( vmbInternalData.z );
+                float3 vmbInternalData11 = UnpackInternalData( vmbInternalData.w );
+
+                #if( NRD_NORMAL_ENCODING == NRD_NORMAL_ENCODING_R10G10B10A2_UNORM )
+                    // Disocclusion: material ID
+                    float4 vmbMaterialID = float4( vmbInternalData00.z, vmbInternalData10.z, vmbInternalData01.z, vmbInternalData11.z  );
+                    vmbOcclusion *= CompareMaterials( materialID, vmbMaterialID, gSpecMinMaterial );
+                #endif
 
-            // TODO: use old code and sync with "GetNormalWeightParam"?
-            //float lobeTanHalfAngle = ImportanceSampling::GetSpecularLobeTanHalfAngle( roughness, NRD_MAX_PERCENT_OF_LOBE_VOLUME );
-            //lobeTanHalfAngle /= 1.0 + vmbSpecAccumSpeed;
+                // Save disocclusion bits
+                fbits += vmbOcclusion.x * 16.0;
+                fbits += vmbOcclusion.y * 32.0;
+                fbits += vmbOcclusion.z * 64.0;
+                fbits += vmbOcclusion.w * 128.0;
+
+                // Accumulation speed
+                vmbOcclusionWeights = Filtering::GetBilinearCustomWeights( vmbBilinearFilter, vmbOcclusion );
+                vmbSpecAccumSpeed = Filtering::ApplyBilinearCustomWeights( vmbInternalData00.y, vmbInternalData10.y, vmbInternalData01.y, vmbInternalData11.y, vmbOcclusionWeights );
+
+                float vmbFootprintQuality = Filtering::ApplyBilinearFilter( vmbOcclusion.x, vmbOcclusion.y, vmbOcclusion.z, vmbOcclusion.w, vmbBilinearFilter );
+                vmbFootprintQuality = Math::Sqrt01( vmbFootprintQuality );
+
+                float vmbSpecHistoryConfidence = vmbFootprintQuality;
+                if( gHasHistoryConfidence && NRD_SUPPORTS_HISTORY_CONFIDENCE )
+                {
+                    float confidence = saturate( gIn_SpecConfidence.SampleLevel( gLinearClamp, vmbPixelUv, 0 ) );
+                    vmbSpecHistoryConfidence = min( vmbSpecHistoryConfidence, confidence );
+                }
+                vmbSpecAccumSpeed *= lerp( vmbSpecHistoryConfidence, 1.0, 1.0 / ( 1.0 + vmbSpecAccumSpeed ) );
+
+                // Is CatRom allowed? ( requires complete "vmbOcclusion" )
+                vmbAllowCatRom = dot( vmbOcclusion, 1.0 ) > 3.5 && REBLUR_USE_CATROM_FOR_VIRTUAL_MOTION_IN_TA;
+                vmbAllowCatRom = vmbAllowCatRom && smbAllowCatRom; // helps to reduce over-sharpening in disoccluded areas
+            }
 
-            lobeTanHalfAngle = max( lobeTanHalfAngle, NRD_NORMAL_ENCODING_ERROR );
-            hitDistanceToLobeSpreadInPixels *= lobeTanHalfAngle;
+            // Estimate how many pixels are traveled by virtual motion - how many radians can it be?
+            float curvatureAngle;
+            float lobeHalfAngle;
+            {
+                // IMPORTANT: if curvature angle is multiplied by path length then we can get an angle exceeding "2 * PI", what is impossible.
+                // The max angle is PI ( most left and most right points on a hemisphere ), it can be achieved by using "tan" instead of angle.
+                float curvatureAngleTan = pixelSize * abs( curvature ); // tana = pixelSize / curvatureRadius = pixelSize * curvature
+                curvatureAngleTan *= max( vmbPixelsTraveled / max( NoV, 0.01 ), 1.0 ); // path length
+                curvatureAngleTan *= 2.0; // TODO: why it's here? but works well
 
-            lobeHalfAngle = atan( lobeTanHalfAngle );
-        }
+                curvatureAngle = atan( curvatureAngleTan );
 
-        // Virtual motion - confidence: parallax
-        // Tests 3, 6, 8, 11, 14, 100, 103, 104, 106, 109, 110, 114, 120, 127, 130, 131, 132, 138, 139 and 9e
-        float parallaxWeight;
-        {
-            float hitDistForTrackingPrev = gPrev_SpecHitDistForTracking.SampleLevel( gLinearClamp, vmbPixelUv * gResolutionScalePrev, 0 );
-            float3 XvirtualPrev = GetXvirtual( hitDistForTrackingPrev, curvature, X, Xprev, N, V, roughness );
+                // Copied from "GetNormalWeightParam" but doesn't use "lobeAngleFraction"
+                float percentOfVolume = NRD_MAX_PERCENT_OF_LOBE_VOLUME / ( 1.0 + vmbSpecAccumSpeed );
+                float lobeTanHalfAngle = ImportanceSampling::GetSpecularLobeTanHalfAngle( roughness, percentOfVolume );
 
-            float2 vmbPixelUvPrev = Geometry::GetScreenUv( gWorldToClipPrev, XvirtualPrev );
-            vmbPixelUvPrev = materialID == gCameraAttachedReflectionMaterialID ? smbPixelUv : vmbPixelUvPrev;
+                // TODO: use old code and sync with "GetNormalWeightParam"?
+                //float lobeTanHalfAngle = ImportanceSampling::GetSpecularLobeTanHalfAngle( roughness, NRD_MAX_PERCENT_OF_LOBE_VOLUME );
+                //lobeTanHalfAngle /= 1.0 + vmbSpecAccumSpeed;
 
-            float r = min( hitDistForTracking, hitDistForTrackingPrev ) * hitDistanceToLobeSpreadInPixels;
-            r *= 0.5; // strengthen the test
-            r = max( r, 0.1 * roughness ); // clean up dirt for high roughness
+                lobeTanHalfAngle = max( lobeTanHalfAngle, NRD_NORMAL_ENCODING_ERROR );
+                hitDistanceToLobeSpreadInPixels *= lobeTanHalfAngle;
 
-            float d = length( ( vmbPixelUvPrev - vmbPixelUv ) * gRectSize );
+                lobeHalfAngle = atan( lobeTanHalfAngle );
+            }
 
-            parallaxWeight = Math::LinearStep( r, 0.0, d );
+            // Virtual motion - confidence: parallax
+            // Tests 3, 6, 8, 11, 14, 100, 103, 104, 106, 109, 110, 114, 120, 127, 130, 131, 132, 138, 139 and 9e
+            float parallaxWeight;
+            {
+                float hitDistForTrackingPrev = gPrev_SpecHitDistForTracking.SampleLevel( gLinearClamp, vmbPixelUv * gResolutionScalePrev, 0 );
+                float3 XvirtualPrev = GetXvirtual( hitDistForTrackingPrev, curvature, X, Xprev, N, V, roughness );
 
-        }
+                float2 vmbPixelUvPrev = Geometry::GetScreenUv( gWorldToClipPrev, XvirtualPrev );
+                vmbPixelUvPrev = materialID == gCameraAttachedReflectionMaterialID ? smbPixelUv : vmbPixelUvPrev;
 
-        // Virtual motion - confidence: normal
-        {
-            // TODO: is it needed? "vmbN" suffers from reprojection stretching...
-            float normalWeight = GetEncodingAwareNormalWeight( N, vmbN.xyz, lobeHalfAngle, curvatureAngle, REBLUR_NORMAL_ULP );
-            normalWeight = lerp( 1.0, normalWeight, Math::SmoothStep01( vmbPixelsTraveled ) ); // jitter friendly
+                float r = min( hitDistForTracking, hitDistForTrackingPrev ) * hitDistanceToLobeSpreadInPixels;
+                r *= 0.5; // strengthen the test
+                r = max( r, 0.1 * roughness ); // clean up dirt for high roughness
 
-            virtualHistoryConfidence *= normalWeight;
-        }
+                float d = length( ( vmbPixelUvPrev - vmbPixelUv ) * gRectSize );
 
-        // Virtual motion - confidence: prev-prev tests
-        {
-            // IMPORTANT: 2 is needed because:
-            // - line *** allows fallback to laggy surface motion, which can be wrongly redistributed by virtual motion
-            // - we use at least linear filters, as the result a wider initial offset is needed
-            float stepBetweenTaps = min( vmbPixelsTraveled * gFramerateScale, 2.0 ) + vmbPixelsTraveled / REBLUR_VIRTUAL_MOTION_PREV_PREV_WEIGHT_ITERATION_NUM;
-            vmbDelta *= Math::Rsqrt( Math::LengthSquared( vmbDelta ) );
-            vmbDelta /= gRectSizePrev;
+                parallaxWeight = Math::LinearStep( r, 0.0, d );
 
-            float2 relaxedRoughnessWeightParams = GetRelaxedRoughnessWeightParams( vmbN.w * vmbN.w, gRoughnessFraction, REBLUR_ROUGHNESS_SENSITIVITY_IN_TA ); // TODO: GetRoughnessWeightParams with 0.05 sensitivity?
+            }
 
-            [unroll]
-            for( i = 1; i <= REBLUR_VIRTUAL_MOTION_PREV_PREV_WEIGHT_ITERATION_NUM; i++ )
+            // Virtual motion - confidence: normal
             {
-                float2 vmbPixelUvPrev = vmbPixelUv + vmbDelta * i * stepBetweenTaps;
-                float4 vmbNormalAndRoughnessPrev = NRD_FrontEnd_UnpackNormalAndRoughness( gPrev_Normal_Roughness.SampleLevel( STOCHASTIC_BILINEAR_FILTER, StochasticBilinear( vmbPixelUvPrev, gRectSizePrev ) * gResolutionScalePrev, 0 ) );
+                // TODO: is it needed? "vmbN" suffers from reprojection stretching...
+                float normalWeight = GetEncodingAwareNormalWeight( N, vmbN.xyz, lobeHalfAngle, curvatureAngle, REBLUR_NORMAL_ULP );
+                normalWeight = lerp( 1.0, normalWeight, Math::SmoothStep01( vmbPixelsTraveled ) ); // jitter friendly
 
-                #if( NRD_USE_PREV_WORLD_SPACE_MATRIX == 1 )
-                    vmbNormalAndRoughnessPrev.xyz = Geometry::RotateVector( gWorldPrevToWorld, vmbNormalAndRoughnessPrev.xyz ); // from "prev" world space
-                #endif
-
-                float w = GetEncodingAwareNormalWeight( vmbN.xyz, vmbNormalAndRoughnessPrev.xyz, lobeHalfAngle, curvatureAngle * ( 1.0 + i * stepBetweenTaps ), REBLUR_NORMAL_ULP );
-                w *= ComputeNonExponentialWeight( vmbNormalAndRoughnessPrev.w * vmbNormalAndRoughnessPrev.w, relaxedRoughnessWeightParams.x, relaxedRoughnessWeightParams.y );
-
-                #if( REBLUR_USE_STF == 1 && NRD_NORMAL_ENCODING == NRD_NORMAL_ENCODING_R10G10B10A2_UNORM )
-                    // Cures issues of "StochasticBilinear" and produces closer look to the linear filter
-                    w = lerp( 1.0, w, saturate( stepBetweenTaps ) );
-                #endif
-
-                w = IsInScreenNearest( vmbPixelUvPrev ) ? w : 1.0;
+                virtualHistoryConfidence *= normalWeight;
+            }
 
-                // For "min" usage "virtualHistoryConfidence" must include only "roughness" and "normal" weights before this line
-                virtualHistoryConfidence = min( virtualHistoryConfidence, w );
+            // Virtual motion - confidence: prev-prev tests
+            {
+                // IMPORTANT: 2 is needed because:
+                // - line *** allows fallback to laggy surface motion, which can be wrongly redistributed by virtual motion
+                // - we use at least linear filters, as the result a wider initial offset is needed
+                float stepBetweenTaps = min( vmbPixelsTraveled * gFramerateScale, 2.0 ) + vmbPixelsTraveled / REBLUR_VIRTUAL_MOTION_PREV_PREV_WEIGHT_ITERATION_NUM;
+                vmbDelta *= Math::Rsqrt( Math::LengthSquared( vmbDelta ) );
+                vmbDelta /= gRectSizePrev;
+
+                float2 relaxedRoughnessWeightParams = GetRelaxedRoughnessWeightParams( vmbN.w * vmbN.w, gRoughnessFraction, REBLUR_ROUGHNESS_SENSITIVITY_IN_TA ); // TODO: GetRoughnessWeightParams with 0.05 sensitivity?
+
+                [unroll]
+                for( i = 1; i <= REBLUR_VIRTUAL_MOTION_PREV_PREV_WEIGHT_ITERATION_NUM; i++ )
+                {
+                    float2 vmbPixelUvPrev = vmbPixelUv + vmbDelta * i * stepBetweenTaps;
+                    float4 vmbNormalAndRoughnessPrev = NRD_FrontEnd_UnpackNormalAndRoughness( gPrev_Normal_Roughness.SampleLevel( STOCHASTIC_BILINEAR_FILTER, StochasticBilinear( vmbPixelUvPrev, gRectSizePrev ) * gResolutionScalePrev, 0 ) );
+
+                    #if( NRD_USE_PREV_WORLD_SPACE_MATRIX == 1 )
+                        vmbNormalAndRoughnessPrev.xyz = Geometry::RotateVector( gWorldPrevToWorld, vmbNormalAndRoughnessPrev.xyz ); // from "prev" world space
+                    #endif
+
+                    float w = GetEncodingAwareNormalWeight( vmbN.xyz, vmbNormalAndRoughnessPrev.xyz, lobeHalfAngle, curvatureAngle * ( 1.0 + i * stepBetweenTaps ), REBLUR_NORMAL_ULP );
+                    w *= ComputeNonExponentialWeight( vmbNormalAndRoughnessPrev.w * vmbNormalAndRoughnessPrev.w, relaxedRoughnessWeightParams.x, relaxedRoughnessWeightParams.y );
+
+                    #if( REBLUR_USE_STF == 1 && NRD_NORMAL_ENCODING == NRD_NORMAL_ENCODING_R10G10B10A2_UNORM )
+                        // Cures issues of "StochasticBilinear" and produces closer look to the linear filter
+                        w = lerp( 1.0, w, saturate( stepBetweenTaps ) );
+                    #endif
+
+                    w = IsInScreenNearest( vmbPixelUvPrev ) ? w : 1.0;
+
+                    // For "min" usage "virtualHistoryConfidence" must include only "roughness" and "normal" weights before this line
+                    virtualHistoryConfidence = min( virtualHistoryConfidence, w );
+                }
             }
-        }
 
-        // Virtual motion - confidence: apply parallax weight
-        virtualHistoryConfidence *= parallaxWeight;
+            // Virtual motion - confidence: apply parallax weight
+            virtualHistoryConfidence *= parallaxWeight;
+        }
 
         // Surface history confidence ( test 9, 9e )
         // It needs to cover "vmb" failing cases, which are:
@@ -48,7 +48,7 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
     PRELOAD_INTO_SMEM_WITH_TILE_CHECK;
 
     // Tile-based early out
-    if( isSky != 0.0 || any( pixelPos > gRectSizeMinusOne ) )
+    if( isSky == NRD_TILE_SKY || any( pixelPos > gRectSizeMinusOne ) )
         return;
 
     // Early out
@@ -64,24 +64,8 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
     // Previous position and surface motion uv
     float4 inMv = gInOut_Mv[ WithRectOrigin( pixelPos ) ];
     float3 mv = inMv.xyz * gMvScale.xyz;
-    float3 Xprev = X;
-    float2 smbPixelUv = pixelUv + mv.xy;
-
-    if( gMvScale.w == 0.0 )
-    {
-        if( gMvScale.z == 0.0 )
-            mv.z = Geometry::AffineTransform( gWorldToViewPrev, X ).z - viewZ;
-
-        float viewZprev = viewZ + mv.z;
-        float3 Xvprevlocal = Geometry::ReconstructViewPosition( smbPixelUv, gFrustumPrev, viewZprev, gOrthoMode ); // TODO: use gOrthoModePrev
-
-        Xprev = Geometry::RotateVectorInverse( gWorldToViewPrev, Xvprevlocal ) + gCameraDelta.xyz;
-    }
-    else
-    {
-        Xprev += mv;
-        smbPixelUv = Geometry::GetScreenUv( gWorldToClipPrev, Xprev );
-    }
+    float2 smbPixelUv;
+    float3 Xprev = GetPrevPosition( X, viewZ, pixelUv, mv, gMvScale, gWorldToViewPrev, gWorldToClipPrev, gFrustumPrev, gCameraDelta.xyz, gOrthoMode, smbPixelUv );
 
     // Normal and roughness
     float materialID;
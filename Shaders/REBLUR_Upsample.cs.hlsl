@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+#include "NRD.hlsli"
+#include "ml.hlsli"
+
+#include "REBLUR_Config.hlsli"
+#include "REBLUR_Upsample.resources.hlsli"
+
+#include "Common.hlsli"
+
+// Half resolution mode: joint bilateral upsample of the denoised half resolution signal, guided by full resolution depth and normals
+[numthreads( GROUP_X, GROUP_Y, 1 )]
+NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
+{
+    NRD_CTA_ORDER_DEFAULT;
+
+    // Early out
+    float viewZ = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( pixelPos ) ] );
+    if( !IsInDenoisingRange( viewZ ) || any( pixelPos > gRectSizeMinusOne ) )
+        return;
+
+    float3 N = NRD_FrontEnd_UnpackNormalAndRoughness( gIn_Normal_Roughness[ WithRectOrigin( pixelPos ) ] ).xyz;
+
+    // Bilinear footprint in the half resolution viewport
+    int2 halfRectSizeMinusOne = ( ( gRectSizeMinusOne + 2 ) >> 1 ) - 1;
+    float2 halfPos = ( float2( pixelPos ) + 0.5 ) * 0.5 - 0.5;
+    int2 basePos = int2( floor( halfPos ) );
+    float2 f = halfPos - float2( basePos );
+    float4 bilinearWeights = float4( ( 1.0 - f.x ) * ( 1.0 - f.y ), f.x * ( 1.0 - f.y ), ( 1.0 - f.x ) * f.y, f.x * f.y );
+
+    float4 sum = 0;
+    float weightSum = 0;
+    float4 closest = 0;
+    float closestDelta = NRD_INF;
+
+    [unroll]
+    for( uint i = 0; i < 4; i++ )
+    {
+        int2 pos = clamp( basePos + int2( i & 1, i >> 1 ), 0, halfRectSizeMinusOne );
+
+        float z = UnpackViewZ( gIn_HalfViewZ[ pos ] );
+        float3 n = NRD_FrontEnd_UnpackNormalAndRoughness( gIn_HalfNormal_Roughness[ pos ] ).xyz;
+        float4 s = gIn_HalfDiff[ pos ];
+
+        float depthDelta = abs( z - viewZ ) / viewZ;
+        float depthWeight = saturate( 1.0 - depthDelta / REBLUR_HALF_RES_DEPTH_THRESHOLD );
+        float normalWeight = pow( saturate( dot( N, n ) ), REBLUR_HALF_RES_NORMAL_POWER );
+        float w = bilinearWeights[ i ] * depthWeight * normalWeight;
+
+        // Conditional add: the signal is undefined outside of the denoising range
+        if( w != 0.0 && IsInDenoisingRange( z ) )
+        {
+            sum += s * w;
+            weightSum += w;
+        }
+
+        // Fallback: the closest in depth sample
+        if( depthDelta < closestDelta && IsInDenoisingRange( z ) )
+        {
+            closest = s;
+            closestDelta = depthDelta;
+        }
+    }
+
+    gOut_Diff[ pixelPos ] = weightSum > NRD_EPS ? sum / weightSum : closest;
+}
@@ -178,7 +178,7 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
     PRELOAD_INTO_SMEM_WITH_TILE_CHECK;
 
     // Tile-based early out
-    if (isSky != 0.0 || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y)
+    if (isSky == NRD_TILE_SKY || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y)
         return;
 
     // Early out if linearZ is beyond denoising range
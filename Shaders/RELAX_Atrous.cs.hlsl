@@ -25,9 +25,12 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
 
     // Tile-based early out
     float isSky = gIn_Tiles[pixelPos >> 4];
-    if (isSky != 0.0 || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y)
+    if (isSky == NRD_TILE_SKY || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y)
         return;
 
+    // Adaptive iteration count: converged tiles take only the center sample, i.e. pass the signal through
+    bool isConvergedTile = gSkipConvergedTiles != 0 && gIn_AtrousTiles[pixelPos >> 3] == 0.0;
+
     // Early out if linearZ is beyond denoising range
     float centerViewZ = UnpackViewZ(gIn_ViewZ[WithRectOrigin(pixelPos)]);
     if (!IsInDenoisingRange( centerViewZ ))
@@ -140,94 +143,98 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
         offset = int2(gStepSize.xx * 0.5 * (Rng::Hash::GetFloat2() - 0.5));
     }
 
-    [unroll]
-    for (int j = -1; j <= 1; j++)
+    [branch]
+    if (!isConvergedTile)
     {
         [unroll]
-        for (int i = -1; i <= 1; i++)
+        for (int j = -1; j <= 1; j++)
         {
-            if (i == 0 && j == 0)
-                continue;
+            [unroll]
+            for (int i = -1; i <= 1; i++)
+            {
+                if (i == 0 && j == 0)
+                    continue;
 
-            int2 p = pixelPos + offset + int2(i, j) * gStepSize;
-            bool isInside = all(p >= int2(0, 0)) && all(p < gRectSize);
-            float kernel = kernelWeightGaussian3x3[abs(i)] * kernelWeightGaussian3x3[abs(j)];
+                int2 p = pixelPos + offset + int2(i, j) * gStepSize;
+                bool isInside = all(p >= int2(0, 0)) && all(p < gRectSize);
+                float kernel = kernelWeightGaussian3x3[abs(i)] * kernelWeightGaussian3x3[abs(j)];
 
-            // Fetching normal, roughness, linear Z
-            float sampleMaterialID;
-            float4 sampleNormalRoughnes = NRD_FrontEnd_UnpackNormalAndRoughness(gIn_Normal_Roughness[WithRectOrigin(p)], sampleMaterialID);
-            float3 sampleNormal = sampleNormalRoughnes.rgb;
-            float sampleRoughness = sampleNormalRoughnes.a;
-            float sampleViewZ = UnpackViewZ(gIn_ViewZ[WithRectOrigin(p)]);
+                // Fetching normal, roughness, linear Z
+                float sampleMaterialID;
+                float4 sampleNormalRoughnes = NRD_FrontEnd_UnpackNormalAndRoughness(gIn_Normal_Roughness[WithRectOrigin(p)], sampleMaterialID);
+                float3 sampleNormal = sampleNormalRoughnes.rgb;
+                float sampleRoughness = sampleNormalRoughnes.a;
+                float sampleViewZ = UnpackViewZ(gIn_ViewZ[WithRectOrigin(p)]);
 
-            // Calculating sample world position
-            float3 sampleWorldPos = GetCurrentWorldPosFromPixelPos(p, sampleViewZ);
+                // Calculating sample world position
+                float3 sampleWorldPos = GetCurrentWorldPosFromPixelPos(p, sampleViewZ);
 
-            // Calculating geometry weight for diffuse and specular
-            float geometryW = GetPlaneDistanceWeight_Atrous(centerWorldPos, centerNormal, sampleWorldPos, depthThreshold);
-            geometryW *= kernel;
-            geometryW *= float(isInside && IsInDenoisingRange( sampleViewZ ));
+                // Calculating geometry weight for diffuse and specular
+                float geometryW = GetPlaneDistanceWeight_Atrous(centerWorldPos, centerNormal, sampleWorldPos, depthThreshold);
+                geometryW *= kernel;
+                geometryW *= float(isInside && IsInDenoisingRange( sampleViewZ ));
 
 #if( NRD_HAS_SPEC )
-            // Getting sample view vector closer to center view vector
-            // by adding gRoughnessEdgeStoppingRelaxation * centerWorldPos
-            // relaxes view direction based rejection
-            float3 sampleV = -normalize(sampleWorldPos + gRoughnessEdgeStoppingRelaxation * centerWorldPos);
-
-            // Calculating weights for specular
-            float angles = Math::AcosApproxPositive(dot(centerNormal, sampleNormal));
-            float normalWSpecularSimplified = ComputeWeight(angles, specularNormalWeightParamSimplified, 0.0);
-            float normalWSpecular = GetSpecularNormalWeight_ATrous(specularNormalWeightParams, centerNormal, sampleNormal, centerV, sampleV);
-            float roughnessWSpecular = ComputeWeight(sampleRoughness, roughnessWeightParams.x, roughnessWeightParams.y);
-
-            // Summing up specular
-            float wSpecular = geometryW * (gRoughnessEdgeStoppingEnabled ? (normalWSpecular * roughnessWSpecular) : normalWSpecularSimplified);
-            wSpecular *= CompareMaterials(sampleMaterialID, centerMaterialID, gSpecMinMaterial);
-            if (wSpecular > 1e-4)
-            {
-                float4 sampleSpecularIlluminationAndVariance = gIn_Spec_Variance[p];
-                float sampleSpecularLuminance = Color::Luminance(sampleSpecularIlluminationAndVariance.rgb);
-
-                float specularLuminanceW = abs(centerSpecularLuminance - sampleSpecularLuminance) * specularPhiLIlluminationInv;
-                specularLuminanceW = min(gSpecMaxLuminanceRelativeDifference, specularLuminanceW);
-                specularLuminanceW *= specularLuminanceWeightRelaxation;
-
-                wSpecular *= exp(-specularLuminanceW);
-
-                sumWSpecular += wSpecular;
-                sumSpecularIlluminationAndVariance += float4(wSpecular.xxx, wSpecular * wSpecular) * sampleSpecularIlluminationAndVariance;
-                #if( NRD_MODE == NRD_MODE_SH )
-                    sumSpecularSH += gIn_SpecSh[p] * wSpecular;
-                #endif
-            }
+                // Getting sample view vector closer to center view vector
+                // by adding gRoughnessEdgeStoppingRelaxation * centerWorldPos
+                // relaxes view direction based rejection
+                float3 sampleV = -normalize(sampleWorldPos + gRoughnessEdgeStoppingRelaxation * centerWorldPos);
+
+                // Calculating weights for specular
+                float angles = Math::AcosApproxPositive(dot(centerNormal, sampleNormal));
+                float normalWSpecularSimplified = ComputeWeight(angles, specularNormalWeightParamSimplified, 0.0);
+                float normalWSpecular = GetSpecularNormalWeight_ATrous(specularNormalWeightParams, centerNormal, sampleNormal, centerV, sampleV);
+                float roughnessWSpecular = ComputeWeight(sampleRoughness, roughnessWeightParams.x, roughnessWeightParams.y);
+
+                // Summing up specular
+                float wSpecular = geometryW * (gRoughnessEdgeStoppingEnabled ? (normalWSpecular * roughnessWSpecular) : normalWSpecularSimplified);
+                wSpecular *= CompareMaterials(sampleMaterialID, centerMaterialID, gSpecMinMaterial);
+                if (wSpecular > 1e-4)
+                {
+                    float4 sampleSpecularIlluminationAndVariance = gIn_Spec_Variance[p];
+                    float sampleSpecularLuminance = Color::Luminance(sampleSpecularIlluminationAndVariance.rgb);
+
+                    float specularLuminanceW = abs(centerSpecularLuminance - sampleSpecularLuminance) * specularPhiLIlluminationInv;
+                    specularLuminanceW = min(gSpecMaxLuminanceRelativeDifference, specularLuminanceW);
+                    specularLuminanceW *= specularLuminanceWeightRelaxation;
+
+                    wSpecular *= exp(-specularLuminanceW);
+
+                    sumWSpecular += wSpecular;
+                    sumSpecularIlluminationAndVariance += float4(wSpecular.xxx, wSpecular * wSpecular) * sampleSpecularIlluminationAndVariance;
+                    #if( NRD_MODE == NRD_MODE_SH )
+                        sumSpecularSH += gIn_SpecSh[p] * wSpecular;
+                    #endif
+                }
 #endif
 
 #if( NRD_HAS_DIFF )
-            // Calculating weights for diffuse
-            float angled = Math::AcosApproxPositive(dot(centerNormal, sampleNormal));
-            float normalWDiffuse = ComputeWeight(angled, diffuseNormalWeightParam, 0.0);
-
-            // Summing up diffuse
-            float wDiffuse = geometryW * normalWDiffuse;
-            wDiffuse *= CompareMaterials(sampleMaterialID, centerMaterialID, gDiffMinMaterial);
-            if (wDiffuse > 1e-4)
-            {
-                float4 sampleDiffuseIlluminationAndVariance = gIn_Diff_Variance[p];
-                float sampleDiffuseLuminance = Color::Luminance(sampleDiffuseIlluminationAndVariance.rgb);
-
-                float diffuseLuminanceW = abs(centerDiffuseLuminance - sampleDiffuseLuminance) * diffusePhiLIlluminationInv;
-                diffuseLuminanceW = min(gDiffMaxLuminanceRelativeDifference, diffuseLuminanceW);
-                diffuseLuminanceW *= diffuseLuminanceWeightRelaxation;
-
-                wDiffuse *= exp(-diffuseLuminanceW);
-
-                sumWDiffuse += wDiffuse;
-                sumDiffuseIlluminationAndVariance +=  float4(wDiffuse.xxx, wDiffuse * wDiffuse) * sampleDiffuseIlluminationAndVariance;
-                #if( NRD_MODE == NRD_MODE_SH )
-                    sumDiffuseSH += gIn_DiffSh[p] * wDiffuse;
-                #endif
-            }
+                // Calculating weights for diffuse
+                float angled = Math::AcosApproxPositive(dot(centerNormal, sampleNormal));
+                float normalWDiffuse = ComputeWeight(angled, diffuseNormalWeightParam, 0.0);
+
+                // Summing up diffuse
+                float wDiffuse = geometryW * normalWDiffuse;
+                wDiffuse *= CompareMaterials(sampleMaterialID, centerMaterialID, gDiffMinMaterial);
+                if (wDiffuse > 1e-4)
+                {
+                    float4 sampleDiffuseIlluminationAndVariance = gIn_Diff_Variance[p];
+                    float sampleDiffuseLuminance = Color::Luminance(sampleDiffuseIlluminationAndVariance.rgb);
+
+                    float diffuseLuminanceW = abs(centerDiffuseLuminance - sampleDiffuseLuminance) * diffusePhiLIlluminationInv;
+                    diffuseLuminanceW = min(gDiffMaxLuminanceRelativeDifference, diffuseLuminanceW);
+                    diffuseLuminanceW *= diffuseLuminanceWeightRelaxation;
+
+                    wDiffuse *= exp(-diffuseLuminanceW);
+
+                    sumWDiffuse += wDiffuse;
+                    sumDiffuseIlluminationAndVariance +=  float4(wDiffuse.xxx, wDiffuse * wDiffuse) * sampleDiffuseIlluminationAndVariance;
+                    #if( NRD_MODE == NRD_MODE_SH )
+                        sumDiffuseSH += gIn_DiffSh[p] * wDiffuse;
+                    #endif
+                }
 #endif
+            }
         }
     }
 
@@ -12,6 +12,8 @@ NRD_CONSTANTS_START( RELAX_AtrousConstants )
     RELAX_SHARED_CONSTANTS
     NRD_CONSTANT( uint, gStepSize )
     NRD_CONSTANT( uint, gIsLastPass )
+    NRD_CONSTANT( uint, gSkipConvergedTiles )
+    NRD_CONSTANT( float, gConvergenceThreshold )
 NRD_CONSTANTS_END
 
 NRD_SAMPLERS_START
@@ -21,31 +23,32 @@ NRD_SAMPLERS_END
 
 NRD_INPUTS_START
     NRD_INPUT( Texture2D, float, gIn_Tiles, t, 0 )
-    NRD_INPUT( Texture2D, float, gIn_HistoryLength, t, 1 )
-    NRD_INPUT( Texture2D, float4, gIn_Normal_Roughness, t, 2 )
-    NRD_INPUT( Texture2D, float, gIn_ViewZ, t, 3 )
+    NRD_INPUT( Texture2D, float, gIn_AtrousTiles, t, 1 )
+    NRD_INPUT( Texture2D, float, gIn_HistoryLength, t, 2 )
+    NRD_INPUT( Texture2D, float4, gIn_Normal_Roughness, t, 3 )
+    NRD_INPUT( Texture2D, float, gIn_ViewZ, t, 4 )
     #if( NRD_HAS_DIFF && NRD_HAS_SPEC )
-        NRD_INPUT( Texture2D, float4, gIn_Spec_Variance, t, 4 )
-        NRD_INPUT( Texture2D, float4, gIn_Diff_Variance, t, 5 )
-        NRD_INPUT( Texture2D, float, gIn_SpecReprojectionConfidence, t, 6 )
-        NRD_INPUT( Texture2D, float, gIn_SpecConfidence, t, 7 )
-        NRD_INPUT( Texture2D, float, gIn_DiffConfidence, t, 8 )
+        NRD_INPUT( Texture2D, float4, gIn_Spec_Variance, t, 5 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff_Variance, t, 6 )
+        NRD_INPUT( Texture2D, float, gIn_SpecReprojectionConfidence, t, 7 )
+        NRD_INPUT( Texture2D, float, gIn_SpecConfidence, t, 8 )
+        NRD_INPUT( Texture2D, float, gIn_DiffConfidence, t, 9 )
         #if( NRD_MODE == NRD_MODE_SH )
-            NRD_INPUT( Texture2D, RELAX_SH_TYPE, gIn_SpecSh, t, 9 )
-            NRD_INPUT( Texture2D, RELAX_SH_TYPE, gIn_DiffSh, t, 10 )
+            NRD_INPUT( Texture2D, RELAX_SH_TYPE, gIn_SpecSh, t, 10 )
+            NRD_INPUT( Texture2D, RELAX_SH_TYPE, gIn_DiffSh, t, 11 )
         #endif
     #elif( NRD_HAS_DIFF )
-        NRD_INPUT( Texture2D, float4, gIn_Diff_Variance, t, 4 )
-        NRD_INPUT( Texture2D, float, gIn_DiffConfidence, t, 5 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff_Variance, t, 5 )
+        NRD_INPUT( Texture2D, float, gIn_DiffConfidence, t, 6 )
         #if( NRD_MODE == NRD_MODE_SH )
-            NRD_INPUT( Texture2D, RELAX_SH_TYPE, gIn_DiffSh, t, 6 )
+            NRD_INPUT( Texture2D, RELAX_SH_TYPE, gIn_DiffSh, t, 7 )
         #endif
     #else
-        NRD_INPUT( Texture2D, float4, gIn_Spec_Variance, t, 4 )
-        NRD_INPUT( Texture2D, float, gIn_SpecReprojectionConfidence, t, 5 )
-        NRD_INPUT( Texture2D, float, gIn_SpecConfidence, t, 6 )
+        NRD_INPUT( Texture2D, float4, gIn_Spec_Variance, t, 5 )
+        NRD_INPUT( Texture2D, float, gIn_SpecReprojectionConfidence, t, 6 )
+        NRD_INPUT( Texture2D, float, gIn_SpecConfidence, t, 7 )
         #if( NRD_MODE == NRD_MODE_SH )
-            NRD_INPUT( Texture2D, RELAX_SH_TYPE, gIn_SpecSh, t, 7 )
+            NRD_INPUT( Texture2D, RELAX_SH_TYPE, gIn_SpecSh, t, 8 )
         #endif
     #endif
 NRD_INPUTS_END
@@ -34,6 +34,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 groupshared float4 s_Normal_Roughness[BUFFER_Y][BUFFER_X];
 groupshared float4 s_WorldPos_MaterialID[BUFFER_Y][BUFFER_X];
+groupshared uint s_IsNoisyTile;
 
 // Helper functions
 
@@ -123,10 +124,60 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
 {
     NRD_CTA_ORDER_REVERSED;
 
+    if (threadIndex == 0)
+        s_IsNoisyTile = 0;
+
     // Preload
     float isSky = gIn_Tiles[pixelPos >> 4];
     PRELOAD_INTO_SMEM_WITH_TILE_CHECK;
 
+    // Adaptive iteration count: an 8x8 tile stays active in late A-trous iterations if at least one pixel is still noisy
+    {
+        float viewZ = UnpackViewZ(gIn_ViewZ[WithRectOrigin(pixelPos)]);
+        bool isNoisy = isSky != NRD_TILE_SKY && pixelPos.x < gRectSize.x && pixelPos.y < gRectSize.y && IsInDenoisingRange(viewZ);
+
+        [branch]
+        if (isNoisy && 255.0 * gIn_HistoryLength[pixelPos] >= gHistoryThreshold)
+        {
+#if( NRD_HAS_SPEC )
+            float specularVar;
+#endif
+#if( NRD_HAS_DIFF )
+            float diffuseVar;
+#endif
+            computeVariance(
+                threadPos.xy
+#if( NRD_HAS_SPEC )
+                , specularVar
+#endif
+#if( NRD_HAS_DIFF )
+                , diffuseVar
+#endif
+            );
+
+            int2 smemPos = threadPos.xy + int2(NRD_BORDER, NRD_BORDER);
+            float threshold = gConvergenceThreshold * gConvergenceThreshold;
+            isNoisy = false;
+
+#if( NRD_HAS_SPEC )
+            float specularLuminance = Color::Luminance(s_Spec[smemPos.y][smemPos.x].rgb);
+            isNoisy = isNoisy || specularVar > threshold * specularLuminance * specularLuminance;
+#endif
+#if( NRD_HAS_DIFF )
+            float diffuseLuminance = Color::Luminance(s_Diff[smemPos.y][smemPos.x].rgb);
+            isNoisy = isNoisy || diffuseVar > threshold * diffuseLuminance * diffuseLuminance;
+#endif
+        }
+
+        if (isNoisy)
+            InterlockedOr(s_IsNoisyTile, 1);
+
+        GroupMemoryBarrierWithGroupSync();
+
+        if (threadIndex == 0)
+            gOut_AtrousTiles[pixelPos >> 3] = s_IsNoisyTile != 0 ? 1.0 : 0.0;
+    }
+
     // Prev ViewZ
     float viewZpacked = gIn_ViewZ[WithRectOrigin(pixelPos)];
     gOut_ViewZ[pixelPos] = viewZpacked;
@@ -151,7 +202,7 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
 #endif
 
     // Tile-based early out
-    if (isSky != 0.0 || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y)
+    if (isSky == NRD_TILE_SKY || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y)
         return;
 
     // Early out if linearZ is beyond denoising range
@@ -12,6 +12,8 @@ NRD_CONSTANTS_START( RELAX_AtrousSmemConstants )
     RELAX_SHARED_CONSTANTS
     NRD_CONSTANT( uint, gStepSize )
     NRD_CONSTANT( uint, gIsLastPass )
+    NRD_CONSTANT( uint, gSkipConvergedTiles )
+    NRD_CONSTANT( float, gConvergenceThreshold )
 NRD_CONSTANTS_END
 
 NRD_SAMPLERS_START
@@ -57,25 +59,28 @@ NRD_OUTPUTS_START
         NRD_OUTPUT( RWTexture2D, float4, gOut_NormalRoughness, u, 2 )
         NRD_OUTPUT( RWTexture2D, float, gOut_MaterialID, u, 3 )
         NRD_OUTPUT( RWTexture2D, float, gOut_ViewZ, u, 4 )
+        NRD_OUTPUT( RWTexture2D, float, gOut_AtrousTiles, u, 5 )
         #if( NRD_MODE == NRD_MODE_SH )
-            NRD_OUTPUT( RWTexture2D, RELAX_SH_TYPE, gOut_SpecSh, u, 5 )
-            NRD_OUTPUT( RWTexture2D, RELAX_SH_TYPE, gOut_DiffSh, u, 6 )
+            NRD_OUTPUT( RWTexture2D, RELAX_SH_TYPE, gOut_SpecSh, u, 6 )
+            NRD_OUTPUT( RWTexture2D, RELAX_SH_TYPE, gOut_DiffSh, u, 7 )
         #endif
     #elif( NRD_HAS_DIFF )
         NRD_OUTPUT( RWTexture2D, float4, gOut_Diff_Variance, u, 0 )
         NRD_OUTPUT( RWTexture2D, float4, gOut_NormalRoughness, u, 1 )
         NRD_OUTPUT( RWTexture2D, float, gOut_MaterialID, u, 2 )
         NRD_OUTPUT( RWTexture2D, float, gOut_ViewZ, u, 3 )
+        NRD_OUTPUT( RWTexture2D, float, gOut_AtrousTiles, u, 4 )
         #if( NRD_MODE == NRD_MODE_SH )
-            NRD_OUTPUT( RWTexture2D, RELAX_SH_TYPE, gOut_DiffSh, u, 4 )
+            NRD_OUTPUT( RWTexture2D, RELAX_SH_TYPE, gOut_DiffSh, u, 5 )
         #endif
     #else
         NRD_OUTPUT( RWTexture2D, float4, gOut_Spec_Variance, u, 0 )
         NRD_OUTPUT( RWTexture2D, float4, gOut_NormalRoughness, u, 1 )
         NRD_OUTPUT( RWTexture2D, float, gOut_MaterialID, u, 2 )
         NRD_OUTPUT( RWTexture2D, float, gOut_ViewZ, u, 3 )
+        NRD_OUTPUT( RWTexture2D, float, gOut_AtrousTiles, u, 4 )
         #if( NRD_MODE == NRD_MODE_SH )
-            NRD_OUTPUT( RWTexture2D, RELAX_SH_TYPE, gOut_SpecSh, u, 4 )
+            NRD_OUTPUT( RWTexture2D, RELAX_SH_TYPE, gOut_SpecSh, u, 5 )
         #endif
     #endif
 NRD_OUTPUTS_END
@@ -21,11 +21,6 @@ groupshared uint s_isSky;
 [numthreads( 8, 4, 1 )]
 NRD_EXPORT void NRD_CS_MAIN( uint2 threadPos : SV_GroupThreadID, uint2 tilePos : SV_GroupID, uint threadIndex : SV_GroupIndex )
 {
-    if( threadIndex == 0 )
-        s_isSky = 0;
-
-    GroupMemoryBarrierWithGroupSync();
-
     uint2 pixelPos = tilePos * 16 + threadPos * uint2( 2, 4 );
     uint isSky = 0;
 
@@ -36,16 +31,31 @@ NRD_EXPORT void NRD_CS_MAIN( uint2 threadPos : SV_GroupThreadID, uint2 tilePos :
         for( uint j = 0; j < 4; j++ )
         {
             uint2 pos = pixelPos + uint2( i, j );
-            float viewZ = abs( gIn_ViewZ[ WithRectOrigin( pos ) ] );
+            float viewZ = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( pos ) ] );
 
             isSky += !IsInDenoisingRange( viewZ ) ? 1 : 0;
         }
     }
 
-    InterlockedAdd( s_isSky, isSky );
+    // Reduce
+    #if( NRD_SUPPORTS_WAVE_INTRINSICS == 1 )
+        if( WaveActiveCountBits( true ) == NRD_CLASSIFY_TILES_THREAD_NUM )
+            isSky = WaveActiveSum( isSky );
+        else
+    #endif
+    {
+        if( threadIndex == 0 )
+            s_isSky = 0;
+
+        GroupMemoryBarrierWithGroupSync();
+
+        InterlockedAdd( s_isSky, isSky );
 
-    GroupMemoryBarrierWithGroupSync();
+        GroupMemoryBarrierWithGroupSync();
+
+        isSky = s_isSky;
+    }
 
     if( threadIndex == 0 )
-        gOut_Tiles[ tilePos ] = s_isSky == 256 ? 1.0 : 0.0;
+        gOut_Tiles[ tilePos ] = isSky == 256 ? 1.0 : 0.0;
 }
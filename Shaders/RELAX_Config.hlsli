@@ -14,6 +14,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #define RELAX_MAX_ACCUM_FRAME_NUM                           255
 #define RELAX_ANTILAG_ACCELERATION_AMOUNT_SCALE             10.0 // Multiplier used to put RelaxAntilagSettings::accelerationAmount to convenient [0; 1] range
+#define RELAX_HISTORY_FIX_MIP_NUM                           4 // pyramid levels downsampled by 2, 4, 8 and 16 for "enableMipBasedHistoryFix"
 
 #define RELAX_SH_TYPE                                       float3
 
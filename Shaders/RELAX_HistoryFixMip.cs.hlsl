@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+#include "NRD.hlsli"
+#include "ml.hlsli"
+
+#include "RELAX_Config.hlsli"
+#include "RELAX_HistoryFixMip.resources.hlsli"
+
+#include "Common.hlsli"
+
+#include "RELAX_Common.hlsli"
+
+void LoadLevel(uint level, int2 pos, out float viewZ, out float4 diff, out float4 spec)
+{
+    diff = 0;
+    spec = 0;
+
+    if (level == 1)
+    {
+        viewZ = gIn_ViewZ_1[pos];
+        #if( NRD_HAS_DIFF )
+            diff = gIn_Diff_1[pos];
+        #endif
+        #if( NRD_HAS_SPEC )
+            spec = gIn_Spec_1[pos];
+        #endif
+    }
+    else if (level == 2)
+    {
+        viewZ = gIn_ViewZ_2[pos];
+        #if( NRD_HAS_DIFF )
+            diff = gIn_Diff_2[pos];
+        #endif
+        #if( NRD_HAS_SPEC )
+            spec = gIn_Spec_2[pos];
+        #endif
+    }
+    else if (level == 3)
+    {
+        viewZ = gIn_ViewZ_3[pos];
+        #if( NRD_HAS_DIFF )
+            diff = gIn_Diff_3[pos];
+        #endif
+        #if( NRD_HAS_SPEC )
+            spec = gIn_Spec_3[pos];
+        #endif
+    }
+    else
+    {
+        viewZ = gIn_ViewZ_4[pos];
+        #if( NRD_HAS_DIFF )
+            diff = gIn_Diff_4[pos];
+        #endif
+        #if( NRD_HAS_SPEC )
+            spec = gIn_Spec_4[pos];
+        #endif
+    }
+}
+
+// Same as "RELAX_HistoryFix", but 3x3 coherent taps from a pyramid level (see "RELAX_HistoryFixMipGen") replace 5x5 strided taps
+[numthreads(GROUP_X, GROUP_Y, 1)]
+NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
+{
+    NRD_CTA_ORDER_REVERSED;
+
+    // Tile-based early out
+    float isSky = gIn_Tiles[pixelPos >> 4];
+    if (isSky == NRD_TILE_SKY || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y)
+        return;
+
+    // Early out if linearZ is beyond denoising range
+    // Early out if no disocclusion detected
+    float centerViewZ = UnpackViewZ(gIn_ViewZ[WithRectOrigin(pixelPos)]);
+    float historyLength = 255.0 * gIn_HistoryLength[pixelPos];
+    if ((!IsInDenoisingRange( centerViewZ )) || (historyLength > gHistoryFixFrameNum || gHistoryFixFrameNum == 1.0))
+        return;
+
+    // Loading center data
+    float centerMaterialID;
+    float4 centerNormalRoughness = NRD_FrontEnd_UnpackNormalAndRoughness(gIn_Normal_Roughness[WithRectOrigin(pixelPos)], centerMaterialID);
+    float3 centerNormal = centerNormalRoughness.rgb;
+    float3 centerWorldPos = GetCurrentWorldPosFromPixelPos(pixelPos, centerViewZ);
+
+#if( NRD_HAS_DIFF )
+    float4 diffuseIlluminationAnd2ndMomentSum = gIn_Diff[pixelPos];
+    float diffuseWSum = 1;
+#endif
+#if( NRD_HAS_SPEC )
+    float4 specularIlluminationAnd2ndMomentSum = gIn_Spec[pixelPos];
+    float specularWSum = 1;
+#endif
+
+    // The level, which 3x3 footprint ( +/- 1.5 texels ) matches the footprint of the strided 5x5 kernel ( +/- 2 strides )
+    float baseStride = centerMaterialID == gHistoryFixAlternatePixelStrideMaterialID ? gHistoryFixAlternatePixelStride : gHistoryFixBasePixelStride;
+    float r = baseStride / ( 1.0 + historyLength );
+    uint level = (uint)clamp( round( log2( r * 4.0 / 3.0 ) ), 1.0, RELAX_HISTORY_FIX_MIP_NUM );
+
+    int2 levelRectSizeMinusOne = ( ( gRectSize + ( 1 << level ) - 1 ) >> level ) - 1;
+    int2 centerPos = pixelPos >> level;
+
+    // Averaged positions are less precise than real ones
+    float depthThreshold = gDepthThreshold * (gOrthoMode == 0 ? centerViewZ : 1.0) * float(level);
+
+    [unroll]
+    for (int j = -1; j <= 1; j++)
+    {
+        [unroll]
+        for (int i = -1; i <= 1; i++)
+        {
+            int2 samplePos = clamp(centerPos + int2(i, j), 0, levelRectSizeMinusOne);
+
+            float sampleViewZ;
+            float4 sampleDiff;
+            float4 sampleSpec;
+            LoadLevel(level, samplePos, sampleViewZ, sampleDiff, sampleSpec);
+
+            float2 sampleUv = (float2(samplePos) + 0.5) * float(1 << level) * gRectSizeInv;
+            float3 sampleWorldPos = GetCurrentWorldPosFromClipSpaceXY(sampleUv * 2.0 - 1.0, sampleViewZ);
+
+            // Only geometry is tested, normals and material IDs are not available in the pyramid
+            float w = GetPlaneDistanceWeight_Atrous(centerWorldPos, centerNormal, sampleWorldPos, depthThreshold);
+
+            // Conditional add: empty texels are marked as being outside of the denoising range
+            if (w != 0.0 && IsInDenoisingRange( sampleViewZ ))
+            {
+#if( NRD_HAS_DIFF )
+                diffuseIlluminationAnd2ndMomentSum += sampleDiff * w;
+                diffuseWSum += w;
+#endif
+#if( NRD_HAS_SPEC )
+                specularIlluminationAnd2ndMomentSum += sampleSpec * w;
+                specularWSum += w;
+#endif
+            }
+        }
+    }
+
+    // Output buffers will hold the pixels with disocclusion processed by history fix.
+    // The next shader will have to copy these areas to normal and responsive history buffers.
+#if( NRD_HAS_DIFF )
+    gOut_Diff[pixelPos] = diffuseIlluminationAnd2ndMomentSum / diffuseWSum;
+#endif
+
+#if( NRD_HAS_SPEC )
+    gOut_Spec[pixelPos] = specularIlluminationAnd2ndMomentSum / specularWSum;
+#endif
+}
@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+NRD_CONSTANTS_START( RELAX_HistoryFixMipConstants )
+    RELAX_SHARED_CONSTANTS
+NRD_CONSTANTS_END
+
+NRD_INPUTS_START
+    NRD_INPUT( Texture2D, float, gIn_Tiles, t, 0 )
+    NRD_INPUT( Texture2D, float,  gIn_HistoryLength, t, 1 )
+    NRD_INPUT( Texture2D, float4, gIn_Normal_Roughness, t, 2 )
+    NRD_INPUT( Texture2D, float,  gIn_ViewZ, t, 3 )
+    NRD_INPUT( Texture2D, float,  gIn_ViewZ_1, t, 4 )
+    NRD_INPUT( Texture2D, float,  gIn_ViewZ_2, t, 5 )
+    NRD_INPUT( Texture2D, float,  gIn_ViewZ_3, t, 6 )
+    NRD_INPUT( Texture2D, float,  gIn_ViewZ_4, t, 7 )
+    #if( NRD_HAS_DIFF && NRD_HAS_SPEC )
+        NRD_INPUT( Texture2D, float4, gIn_Spec, t, 8 )
+        NRD_INPUT( Texture2D, float4, gIn_Spec_1, t, 9 )
+        NRD_INPUT( Texture2D, float4, gIn_Spec_2, t, 10 )
+        NRD_INPUT( Texture2D, float4, gIn_Spec_3, t, 11 )
+        NRD_INPUT( Texture2D, float4, gIn_Spec_4, t, 12 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff, t, 13 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff_1, t, 14 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff_2, t, 15 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff_3, t, 16 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff_4, t, 17 )
+    #elif( NRD_HAS_DIFF )
+        NRD_INPUT( Texture2D, float4, gIn_Diff, t, 8 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff_1, t, 9 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff_2, t, 10 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff_3, t, 11 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff_4, t, 12 )
+    #else
+        NRD_INPUT( Texture2D, float4, gIn_Spec, t, 8 )
+        NRD_INPUT( Texture2D, float4, gIn_Spec_1, t, 9 )
+        NRD_INPUT( Texture2D, float4, gIn_Spec_2, t, 10 )
+        NRD_INPUT( Texture2D, float4, gIn_Spec_3, t, 11 )
+        NRD_INPUT( Texture2D, float4, gIn_Spec_4, t, 12 )
+    #endif
+NRD_INPUTS_END
+
+NRD_OUTPUTS_START
+    #if( NRD_HAS_DIFF && NRD_HAS_SPEC )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Spec, u, 0 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Diff, u, 1 )
+    #elif( NRD_HAS_DIFF )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Diff, u, 0 )
+    #else
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Spec, u, 0 )
+    #endif
+NRD_OUTPUTS_END
+
+// Macro magic
+#define RELAX_HistoryFixMipGroupX 8
+#define RELAX_HistoryFixMipGroupY 8
+
+// Shader only
+#ifndef __cplusplus
+
+#define GROUP_X RELAX_HistoryFixMipGroupX
+#define GROUP_Y RELAX_HistoryFixMipGroupY
+
+#endif
@@ -0,0 +1,158 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+#include "NRD.hlsli"
+#include "ml.hlsli"
+
+#include "RELAX_Config.hlsli"
+#include "RELAX_HistoryFixMipGen.resources.hlsli"
+
+#include "Common.hlsli"
+
+#include "RELAX_Common.hlsli"
+
+// Sums: .x - viewZ, .y - weight (number of full resolution pixels in the denoising range)
+groupshared float2 s_ViewZ_Weight[ GROUP_Y ][ GROUP_X ];
+#if( NRD_HAS_DIFF )
+    groupshared float4 s_Diff[ GROUP_Y ][ GROUP_X ];
+#endif
+#if( NRD_HAS_SPEC )
+    groupshared float4 s_Spec[ GROUP_Y ][ GROUP_X ];
+#endif
+
+void WriteLevel( uint level, int2 pos, float2 viewZ_weight, float4 diff, float4 spec )
+{
+    // Empty texels are marked as being outside of the denoising range
+    float invWeight = viewZ_weight.y != 0.0 ? 1.0 / viewZ_weight.y : 0.0;
+    float viewZ = viewZ_weight.y != 0.0 ? viewZ_weight.x * invWeight : NRD_INF;
+
+    if( level == 1 )
+    {
+        gOut_ViewZ_1[ pos ] = viewZ;
+        #if( NRD_HAS_DIFF )
+            gOut_Diff_1[ pos ] = diff * invWeight;
+        #endif
+        #if( NRD_HAS_SPEC )
+            gOut_Spec_1[ pos ] = spec * invWeight;
+        #endif
+    }
+    else if( level == 2 )
+    {
+        gOut_ViewZ_2[ pos ] = viewZ;
+        #if( NRD_HAS_DIFF )
+            gOut_Diff_2[ pos ] = diff * invWeight;
+        #endif
+        #if( NRD_HAS_SPEC )
+            gOut_Spec_2[ pos ] = spec * invWeight;
+        #endif
+    }
+    else if( level == 3 )
+    {
+        gOut_ViewZ_3[ pos ] = viewZ;
+        #if( NRD_HAS_DIFF )
+            gOut_Diff_3[ pos ] = diff * invWeight;
+        #endif
+        #if( NRD_HAS_SPEC )
+            gOut_Spec_3[ pos ] = spec * invWeight;
+        #endif
+    }
+    else
+    {
+        gOut_ViewZ_4[ pos ] = viewZ;
+        #if( NRD_HAS_DIFF )
+            gOut_Diff_4[ pos ] = diff * invWeight;
+        #endif
+        #if( NRD_HAS_SPEC )
+            gOut_Spec_4[ pos ] = spec * invWeight;
+        #endif
+    }
+}
+
+// Single pass downsampler: a thread produces a texel of the 1st level (a 2x2 quad at full resolution), a group - a 2x2 footprint of the last level
+[numthreads( GROUP_X, GROUP_Y, 1 )]
+NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
+{
+    NRD_CTA_ORDER_DEFAULT;
+
+    // Level 1
+    float2 viewZ_weight = 0;
+    float4 diff = 0;
+    float4 spec = 0;
+
+    [unroll]
+    for( uint i = 0; i < 4; i++ )
+    {
+        int2 pos = min( pixelPos * 2 + int2( i & 1, i >> 1 ), gRectSize - 1 );
+        float z = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( pos ) ] );
+
+        // Conditional add: the signal is undefined outside of the denoising range
+        if( IsInDenoisingRange( z ) )
+        {
+            viewZ_weight += float2( z, 1.0 );
+            #if( NRD_HAS_DIFF )
+                diff += gIn_Diff[ pos ];
+            #endif
+            #if( NRD_HAS_SPEC )
+                spec += gIn_Spec[ pos ];
+            #endif
+        }
+    }
+
+    if( all( pixelPos < ( ( gRectSize + 1 ) >> 1 ) ) )
+        WriteLevel( 1, pixelPos, viewZ_weight, diff, spec );
+
+    s_ViewZ_Weight[ threadPos.y ][ threadPos.x ] = viewZ_weight;
+    #if( NRD_HAS_DIFF )
+        s_Diff[ threadPos.y ][ threadPos.x ] = diff;
+    #endif
+    #if( NRD_HAS_SPEC )
+        s_Spec[ threadPos.y ][ threadPos.x ] = spec;
+    #endif
+
+    // Next levels: sums are reduced in place, active threads of a level read only cells written by the previous level
+    [unroll]
+    for( uint level = 2; level <= RELAX_HISTORY_FIX_MIP_NUM; level++ )
+    {
+        GroupMemoryBarrierWithGroupSync( );
+
+        int stride = 1 << ( level - 2 );
+        bool isActive = all( ( threadPos & ( 2 * stride - 1 ) ) == 0 );
+
+        if( isActive )
+        {
+            [unroll]
+            for( uint j = 1; j < 4; j++ )
+            {
+                int2 t = threadPos + int2( j & 1, j >> 1 ) * stride;
+
+                viewZ_weight += s_ViewZ_Weight[ t.y ][ t.x ];
+                #if( NRD_HAS_DIFF )
+                    diff += s_Diff[ t.y ][ t.x ];
+                #endif
+                #if( NRD_HAS_SPEC )
+                    spec += s_Spec[ t.y ][ t.x ];
+                #endif
+            }
+
+            s_ViewZ_Weight[ threadPos.y ][ threadPos.x ] = viewZ_weight;
+            #if( NRD_HAS_DIFF )
+                s_Diff[ threadPos.y ][ threadPos.x ] = diff;
+            #endif
+            #if( NRD_HAS_SPEC )
+                s_Spec[ threadPos.y ][ threadPos.x ] = spec;
+            #endif
+
+            int2 levelPos = int2( groupPos ) * ( int2( GROUP_X, GROUP_Y ) >> ( level - 1 ) ) + ( threadPos >> ( level - 1 ) );
+            int levelSize = 1 << level;
+            if( all( levelPos < ( ( gRectSize + levelSize - 1 ) >> level ) ) )
+                WriteLevel( level, levelPos, viewZ_weight, diff, spec );
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+NRD_CONSTANTS_START( RELAX_HistoryFixMipGenConstants )
+    RELAX_SHARED_CONSTANTS
+NRD_CONSTANTS_END
+
+NRD_INPUTS_START
+    NRD_INPUT( Texture2D, float, gIn_ViewZ, t, 0 )
+    #if( NRD_HAS_DIFF && NRD_HAS_SPEC )
+        NRD_INPUT( Texture2D, float4, gIn_Spec, t, 1 )
+        NRD_INPUT( Texture2D, float4, gIn_Diff, t, 2 )
+    #elif( NRD_HAS_DIFF )
+        NRD_INPUT( Texture2D, float4, gIn_Diff, t, 1 )
+    #else
+        NRD_INPUT( Texture2D, float4, gIn_Spec, t, 1 )
+    #endif
+NRD_INPUTS_END
+
+NRD_OUTPUTS_START
+    NRD_OUTPUT( RWTexture2D, float, gOut_ViewZ_1, u, 0 )
+    NRD_OUTPUT( RWTexture2D, float, gOut_ViewZ_2, u, 1 )
+    NRD_OUTPUT( RWTexture2D, float, gOut_ViewZ_3, u, 2 )
+    NRD_OUTPUT( RWTexture2D, float, gOut_ViewZ_4, u, 3 )
+    #if( NRD_HAS_DIFF && NRD_HAS_SPEC )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Spec_1, u, 4 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Spec_2, u, 5 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Spec_3, u, 6 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Spec_4, u, 7 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Diff_1, u, 8 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Diff_2, u, 9 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Diff_3, u, 10 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Diff_4, u, 11 )
+    #elif( NRD_HAS_DIFF )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Diff_1, u, 4 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Diff_2, u, 5 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Diff_3, u, 6 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Diff_4, u, 7 )
+    #else
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Spec_1, u, 4 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Spec_2, u, 5 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Spec_3, u, 6 )
+        NRD_OUTPUT( RWTexture2D, float4, gOut_Spec_4, u, 7 )
+    #endif
+NRD_OUTPUTS_END
+
+// Macro magic
+#define RELAX_HistoryFixMipGenGroupX 16
+#define RELAX_HistoryFixMipGenGroupY 16
+
+// Shader only
+#ifndef __cplusplus
+
+#define GROUP_X RELAX_HistoryFixMipGenGroupX
+#define GROUP_Y RELAX_HistoryFixMipGenGroupY
+
+#endif
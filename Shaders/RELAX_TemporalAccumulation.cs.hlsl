@@ -381,7 +381,7 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
     PRELOAD_INTO_SMEM_WITH_TILE_CHECK;
 
     // Tile-based early out
-    if (isSky != 0.0 || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y)
+    if (isSky == NRD_TILE_SKY || pixelPos.x >= gRectSize.x || pixelPos.y >= gRectSize.y)
         return;
 
     // Early out if linearZ is beyond denoising range
@@ -476,7 +476,9 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
 #endif
 
     // Calculating surface parallax
-    float smbParallaxInPixels1 = ComputeParallaxInPixels( prevWorldPos + gCameraDelta.xyz, gOrthoMode == 0.0 ? prevUVSMB : pixelUv, gWorldToClipPrev, gRectSize );
+    // IMPORTANT: "smbParallaxInUv1" is also the direction of motion for curvature estimation
+    float2 smbParallaxInUv1 = Geometry::GetScreenUv( gWorldToClipPrev, prevWorldPos + gCameraDelta.xyz ) - ( gOrthoMode == 0.0 ? prevUVSMB : pixelUv );
+    float smbParallaxInPixels1 = length( smbParallaxInUv1 * gRectSize );
     float smbParallaxInPixels2 = ComputeParallaxInPixels( prevWorldPos - gCameraDelta.xyz, gOrthoMode == 0.0 ? pixelUv : prevUVSMB, gWorldToClip, gRectSize );
 
     float smbParallaxInPixelsMax = max( smbParallaxInPixels1, smbParallaxInPixels2 );
@@ -658,8 +660,7 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
     {
         // IMPORTANT: non-zero parallax on objects attached to the camera is needed
         // IMPORTANT: the direction of "deltaUv" is important ( test 1 )
-        float2 uvForZeroParallax = gOrthoMode == 0.0 ? prevUVSMB : pixelUv;
-        float2 deltaUv = uvForZeroParallax - Geometry::GetScreenUv( gWorldToClipPrev, prevWorldPos + gCameraDelta.xyz ); // TODO: repeats code for "smbParallaxInPixels1" with "-" sign
+        float2 deltaUv = -smbParallaxInUv1;
         deltaUv *= gRectSize;
         deltaUv /= max( smbParallaxInPixels1, 1.0 / 256.0 );
 
@@ -174,6 +174,22 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
         result.xyz = Color::ColorizeZucconi( viewportUv.y > 0.95 ? 1.0 - viewportUv.x : f * float( !isInf ) );
         result.w = 1.0;
     }
+    else if( viewportIndex == 9 )
+    {
+        // Adaptive A-trous: tiles still active in late iterations ( red ) and converged tiles ( green )
+        Text::Print_ch( 'A', textState );
+        Text::Print_ch( 'T', textState );
+        Text::Print_ch( 'R', textState );
+        Text::Print_ch( 'O', textState );
+        Text::Print_ch( 'U', textState );
+        Text::Print_ch( 'S', textState );
+
+        float isNoisyTile = gIn_AtrousTiles.SampleLevel( gNearestClamp, viewportUvScaled, 0 );
+
+        result.xyz = isNoisyTile != 0.0 ? float3( 1, 0, 0 ) : float3( 0, 1, 0 );
+        result.xyz *= float( !isInf );
+        result.w = 1.0;
+    }
     else
         result = 0;
 
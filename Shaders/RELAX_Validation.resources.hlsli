@@ -22,6 +22,7 @@ NRD_INPUTS_START
     NRD_INPUT( Texture2D, float, gIn_ViewZ, t, 1 )
     NRD_INPUT( Texture2D, float3, gIn_Mv, t, 2 )
     NRD_INPUT( Texture2D, float, gIn_HistoryLength, t, 3 )
+    NRD_INPUT( Texture2D, float, gIn_AtrousTiles, t, 4 )
 NRD_INPUTS_END
 
 NRD_OUTPUTS_START
@@ -24,14 +24,6 @@ groupshared uint s_Radius;
 [numthreads( 8, 4, 1 )]
 NRD_EXPORT void NRD_CS_MAIN( uint2 threadPos : SV_GroupThreadID, uint2 tilePos : SV_GroupID, uint threadIndex : SV_GroupIndex )
 {
-    if( threadIndex == 0 )
-    {
-        s_Mask = 0;
-        s_Radius = 0;
-    }
-
-    GroupMemoryBarrier();
-
     uint2 pixelPos = tilePos * 16 + threadPos * uint2( 2, 4 );
 
     uint mask = 0;
@@ -74,20 +66,42 @@ NRD_EXPORT void NRD_CS_MAIN( uint2 threadPos : SV_GroupThreadID, uint2 tilePos :
         }
     }
 
-    InterlockedAdd( s_Mask, mask );
-    InterlockedMax( s_Radius, asuint( maxRadius ) );
+    // Reduce ( 9-bit counters can't overflow, i.e. summing packed masks is safe )
+    #if( NRD_SUPPORTS_WAVE_INTRINSICS == 1 )
+        if( WaveActiveCountBits( true ) == NRD_CLASSIFY_TILES_THREAD_NUM )
+        {
+            mask = WaveActiveSum( mask );
+            maxRadius = WaveActiveMax( maxRadius );
+        }
+        else
+    #endif
+    {
+        if( threadIndex == 0 )
+        {
+            s_Mask = 0;
+            s_Radius = 0;
+        }
+
+        GroupMemoryBarrierWithGroupSync();
 
-    GroupMemoryBarrier();
+        InterlockedAdd( s_Mask, mask );
+        InterlockedMax( s_Radius, asuint( maxRadius ) );
+
+        GroupMemoryBarrierWithGroupSync();
+
+        mask = s_Mask;
+        maxRadius = asfloat( s_Radius );
+    }
 
     if( threadIndex == 0 )
     {
-        bool isLit = ( ( s_Mask >> 0 ) & 511 ) == 256;
-        bool isUmbra = ( ( s_Mask >> 9 ) & 511 ) == 256;
-        bool isInf = ( ( s_Mask >> 18 ) & 511 ) == 256;
+        bool isLit = ( ( mask >> 0 ) & 511 ) == 256;
+        bool isUmbra = ( ( mask >> 9 ) & 511 ) == 256;
+        bool isInf = ( ( mask >> 18 ) & 511 ) == 256;
 
         float4 result;
         result.x = ( isLit || isUmbra ) ? 0.0 : 1.0;
-        result.y = saturate( asfloat( s_Radius ) / 16.0 );
+        result.y = saturate( maxRadius / 16.0 );
         result.z = isInf ? 1.0 : 0.0;
         result.w = 0.0;
 
@@ -122,24 +122,8 @@ NRD_EXPORT void NRD_CS_MAIN( NRD_CS_MAIN_ARGS )
     float3 X = Geometry::RotateVectorInverse( gWorldToView, Xv );
 
     float3 mv = gIn_Mv[ WithRectOrigin( pixelPos ) ] * gMvScale.xyz;
-    float3 Xprev = X;
-    float2 smbPixelUv = pixelUv + mv.xy;
-
-    if( gMvScale.w == 0.0 )
-    {
-        if( gMvScale.z == 0.0 )
-            mv.z = Geometry::AffineTransform( gWorldToViewPrev, X ).z - viewZ;
-
-        float viewZprev = viewZ + mv.z;
-        float3 Xvprevlocal = Geometry::ReconstructViewPosition( smbPixelUv, gFrustumPrev, viewZprev, gOrthoMode ); // TODO: use gOrthoModePrev
-
-        Xprev = Geometry::RotateVectorInverse( gWorldToViewPrev, Xvprevlocal ) + gCameraDelta.xyz;
-    }
-    else
-    {
-        Xprev += mv;
-        smbPixelUv = Geometry::GetScreenUv( gWorldToClipPrev, Xprev );
-    }
+    float2 smbPixelUv;
+    float3 Xprev = GetPrevPosition( X, viewZ, pixelUv, mv, gMvScale, gWorldToViewPrev, gWorldToClipPrev, gFrustumPrev, gCameraDelta.xyz, gOrthoMode, smbPixelUv );
 
     // History length
     Filtering::Bilinear smbBilinearFilter = Filtering::GetBilinearFilter( smbPixelUv, gRectSizePrev );
@@ -9,13 +9,17 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
 #define DENOISER_NAME REBLUR_Diffuse
-#define DIFF_TEMP1    AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST)
+#define DIFF_TEMP1    outDiff
 #define DIFF_TEMP2    AsUint(Transient::DIFF_TMP2)
 
 void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
     denoiserData.settings.reblur = ReblurSettings();
     denoiserData.settingsSize = sizeof(denoiserData.settings.reblur);
 
+    // Half resolution: all internal textures are downsampled, passes between "Downsample" and "Upsample" see a virtual half resolution viewport
+    bool isHalfRes = denoiserData.desc.enableHalfResolution;
+    uint16_t d = isHalfRes ? 2 : 1;
+
     enum class Permanent {
         PREV_VIEWZ = PERMANENT_POOL_START,
         PREV_NORMAL_ROUGHNESS,
@@ -26,13 +30,13 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
         DIFF_HISTORY_STABILIZED_PONG,
     };
 
-    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_VIEWZ, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_INTERNAL_DATA, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_FAST_HISTORY, 1});
-    AddTextureToPermanentPool({Format::R16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::R16_SFLOAT, 1});
+    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_VIEWZ, d, TextureClass::PREV_VIEWZ});
+    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, d, TextureClass::PREV_NORMAL_ROUGHNESS});
+    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_INTERNAL_DATA, d, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({REBLUR_FORMAT, d, TextureClass::HISTORY});
+    AddTextureToPermanentPool({REBLUR_FORMAT_FAST_HISTORY, d, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::R16_SFLOAT, d, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::R16_SFLOAT, d, TextureClass::HISTORY});
 
     enum class Transient {
         DATA1 = TRANSIENT_POOL_START,
@@ -40,23 +44,46 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
         DIFF_TMP2,
         DIFF_FAST_HISTORY,
         TILES,
+        HALF_VIEWZ,
+        HALF_NORMAL_ROUGHNESS,
+        HALF_MV,
+        HALF_DIFF,
+        HALF_DIFF_OUTPUT,
     };
 
-    AddTextureToTransientPool({Format::R8_UNORM, 1});
-    AddTextureToTransientPool({Format::R8_UINT, 1});
-    AddTextureToTransientPool({REBLUR_FORMAT, 1});
-    AddTextureToTransientPool({REBLUR_FORMAT_FAST_HISTORY, 1});
-    AddTextureToTransientPool({REBLUR_FORMAT_TILES, 16});
+    AddTextureToTransientPool({Format::R8_UNORM, d});
+    AddTextureToTransientPool({Format::R8_UINT, d});
+    AddTextureToTransientPool({REBLUR_FORMAT, d});
+    AddTextureToTransientPool({REBLUR_FORMAT_FAST_HISTORY, d});
+
+    if (isHalfRes) {
+        // Half resolution tiles can't be shared with full resolution denoisers
+        AddTextureToTransientPool({REBLUR_FORMAT_TILES, uint16_t(16 * d)});
+
+        AddTextureToTransientPool({REBLUR_FORMAT_PREV_VIEWZ, d});
+        AddTextureToTransientPool({REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, d});
+        AddTextureToTransientPool({Format::RGBA16_SFLOAT, d});
+        AddTextureToTransientPool({REBLUR_FORMAT, d});
+        AddTextureToTransientPool({REBLUR_FORMAT, d});
+    } else
+        AddTilesToTransientPool({REBLUR_FORMAT_TILES, 16});
+
+    uint16_t inViewZ = isHalfRes ? AsUint(Transient::HALF_VIEWZ) : AsUint(ResourceType::IN_VIEWZ);
+    uint16_t inNormalRoughness = isHalfRes ? AsUint(Transient::HALF_NORMAL_ROUGHNESS) : AsUint(ResourceType::IN_NORMAL_ROUGHNESS);
+    uint16_t inMv = isHalfRes ? AsUint(Transient::HALF_MV) : AsUint(ResourceType::IN_MV);
+    uint16_t inDiff = isHalfRes ? AsUint(Transient::HALF_DIFF) : AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST);
+    uint16_t outDiff = isHalfRes ? AsUint(Transient::HALF_DIFF_OUTPUT) : AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST);
 
     std::array<ShaderMake::ShaderConstant, 2> commonDefines = {{
         NRD_MAKE_SHADER_CONSTANT(NRD_SIGNAL, NRD_SIGNAL_DIFF),
         NRD_MAKE_SHADER_CONSTANT(NRD_MODE, NRD_MODE_RADIANCE),
     }};
 
-    PushPass("Classify tiles");
+    PushClassifyTilesPass();
     {
         // Inputs
-        PushInput(AsUint(ResourceType::IN_VIEWZ));
+        PushInput(inViewZ);
+        PushInput(inNormalRoughness);
 
         // Outputs
         PushOutput(AsUint(Transient::TILES));
@@ -74,9 +101,9 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
         {
             // Inputs
             PushInput(AsUint(Transient::TILES));
-            PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
-            PushInput(AsUint(ResourceType::IN_VIEWZ));
-            PushInput(AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST));
+            PushInput(inNormalRoughness);
+            PushInput(inViewZ);
+            PushInput(inDiff);
 
             // Outputs
             PushOutput(isPrepassEnabled ? DIFF_TEMP2 : DIFF_TEMP1);
@@ -98,9 +125,9 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
         {
             // Inputs
             PushInput(AsUint(Transient::TILES));
-            PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
-            PushInput(AsUint(ResourceType::IN_VIEWZ));
-            PushInput(isAfterReconstruction ? DIFF_TEMP2 : AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST));
+            PushInput(inNormalRoughness);
+            PushInput(inViewZ);
+            PushInput(isAfterReconstruction ? DIFF_TEMP2 : inDiff);
 
             // Outputs
             PushOutput(DIFF_TEMP1);
@@ -119,15 +146,15 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
         {
             // Inputs
             PushInput(AsUint(Transient::TILES));
-            PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
-            PushInput(AsUint(ResourceType::IN_VIEWZ));
-            PushInput(AsUint(ResourceType::IN_MV));
+            PushInput(inNormalRoughness);
+            PushInput(inViewZ);
+            PushInput(inMv);
             PushInput(AsUint(Permanent::PREV_VIEWZ));
             PushInput(AsUint(Permanent::PREV_NORMAL_ROUGHNESS));
             PushInput(AsUint(Permanent::PREV_INTERNAL_DATA));
             PushInput(hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : REBLUR_DUMMY);
             PushInput(hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : REBLUR_DUMMY);
-            PushInput(isAfterPrepass ? DIFF_TEMP1 : AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST));
+            PushInput(isAfterPrepass ? DIFF_TEMP1 : inDiff);
             PushInput(AsUint(Permanent::DIFF_HISTORY));
             PushInput(AsUint(Permanent::DIFF_FAST_HISTORY));
 
@@ -146,9 +173,9 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
     {
         // Inputs
         PushInput(AsUint(Transient::TILES));
-        PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
+        PushInput(inNormalRoughness);
         PushInput(AsUint(Transient::DATA1));
-        PushInput(AsUint(ResourceType::IN_VIEWZ));
+        PushInput(inViewZ);
         PushInput(DIFF_TEMP2);
         PushInput(AsUint(Transient::DIFF_FAST_HISTORY));
 
@@ -164,8 +191,8 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
     {
         // Inputs
         PushInput(AsUint(Transient::TILES));
-        PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
-        PushInput(AsUint(ResourceType::IN_VIEWZ));
+        PushInput(inNormalRoughness);
+        PushInput(inViewZ);
         PushInput(AsUint(Transient::DATA1));
         PushInput(DIFF_TEMP1);
 
@@ -184,7 +211,7 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
         {
             // Inputs
             PushInput(AsUint(Transient::TILES));
-            PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
+            PushInput(inNormalRoughness);
             PushInput(AsUint(Transient::DATA1));
             PushInput(AsUint(Permanent::PREV_VIEWZ));
             PushInput(DIFF_TEMP2);
@@ -195,7 +222,7 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
 
             if (!isTemporalStabilization) {
                 PushOutput(AsUint(Permanent::PREV_INTERNAL_DATA));
-                PushOutput(AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST));
+                PushOutput(outDiff);
             }
 
             // Shaders
@@ -212,7 +239,7 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
     {
         // Inputs
         PushInput(AsUint(Transient::TILES));
-        PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
+        PushInput(inNormalRoughness);
         PushInput(AsUint(Permanent::PREV_VIEWZ));
         PushInput(AsUint(Transient::DATA1));
         PushInput(AsUint(Transient::DATA2));
@@ -220,9 +247,9 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
         PushInput(AsUint(Permanent::DIFF_HISTORY_STABILIZED_PING), AsUint(Permanent::DIFF_HISTORY_STABILIZED_PONG));
 
         // Outputs
-        PushOutput(AsUint(ResourceType::IN_MV));
+        PushOutput(inMv);
         PushOutput(AsUint(Permanent::PREV_INTERNAL_DATA));
-        PushOutput(AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST));
+        PushOutput(outDiff);
         PushOutput(AsUint(Permanent::DIFF_HISTORY_STABILIZED_PONG), AsUint(Permanent::DIFF_HISTORY_STABILIZED_PING));
 
         // Shaders
@@ -243,6 +270,44 @@ void nrd::InstanceImpl::Add_ReblurDiffuse(DenoiserData& denoiserData) {
     }
 
     REBLUR_ADD_VALIDATION_DISPATCH(Transient::DATA2, ResourceType::IN_DIFF_RADIANCE_HITDIST, ResourceType::IN_DIFF_RADIANCE_HITDIST);
+
+    if (isHalfRes) {
+        PushPass("Downsample");
+        {
+            // Inputs
+            PushInput(AsUint(ResourceType::IN_VIEWZ));
+            PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
+            PushInput(AsUint(ResourceType::IN_MV));
+            PushInput(AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST));
+
+            // Outputs
+            PushOutput(AsUint(Transient::HALF_VIEWZ));
+            PushOutput(AsUint(Transient::HALF_NORMAL_ROUGHNESS));
+            PushOutput(AsUint(Transient::HALF_MV));
+            PushOutput(AsUint(Transient::HALF_DIFF));
+
+            // Shaders
+            std::array<ShaderMake::ShaderConstant, 0> defines = {};
+            AddDispatchWithArgs(REBLUR_Downsample, defines, d, 1);
+        }
+
+        PushPass("Upsample");
+        {
+            // Inputs
+            PushInput(AsUint(ResourceType::IN_VIEWZ));
+            PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
+            PushInput(AsUint(Transient::HALF_VIEWZ));
+            PushInput(AsUint(Transient::HALF_NORMAL_ROUGHNESS));
+            PushInput(AsUint(Transient::HALF_DIFF_OUTPUT));
+
+            // Outputs
+            PushOutput(AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST));
+
+            // Shaders
+            std::array<ShaderMake::ShaderConstant, 0> defines = {};
+            AddDispatch(REBLUR_Upsample, defines);
+        }
+    }
 }
 
 #undef DENOISER_NAME
@@ -28,14 +28,14 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSh(DenoiserData& denoiserData) {
         DIFF_SH_HISTORY,
     };
 
-    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_VIEWZ, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_INTERNAL_DATA, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_FAST_HISTORY, 1});
-    AddTextureToPermanentPool({Format::R16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::R16_SFLOAT, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT, 1});
+    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_VIEWZ, 1, TextureClass::PREV_VIEWZ});
+    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1, TextureClass::PREV_NORMAL_ROUGHNESS});
+    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_INTERNAL_DATA, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({REBLUR_FORMAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({REBLUR_FORMAT_FAST_HISTORY, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::R16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::R16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({REBLUR_FORMAT, 1, TextureClass::HISTORY});
 
     enum class Transient {
         DATA1 = TRANSIENT_POOL_START,
@@ -51,17 +51,18 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSh(DenoiserData& denoiserData) {
     AddTextureToTransientPool({REBLUR_FORMAT, 1});
     AddTextureToTransientPool({REBLUR_FORMAT_FAST_HISTORY, 1});
     AddTextureToTransientPool({REBLUR_FORMAT, 1});
-    AddTextureToTransientPool({REBLUR_FORMAT_TILES, 16});
+    AddTilesToTransientPool({REBLUR_FORMAT_TILES, 16});
 
     std::array<ShaderMake::ShaderConstant, 2> commonDefines = {{
         NRD_MAKE_SHADER_CONSTANT(NRD_SIGNAL, NRD_SIGNAL_DIFF),
         NRD_MAKE_SHADER_CONSTANT(NRD_MODE, NRD_MODE_SH),
     }};
 
-    PushPass("Classify tiles");
+    PushClassifyTilesPass();
     {
         // Inputs
         PushInput(AsUint(ResourceType::IN_VIEWZ));
+        PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
 
         // Outputs
         PushOutput(AsUint(Transient::TILES));
@@ -30,15 +30,15 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSpecularOcclusion(DenoiserData& denoise
         SPEC_HITDIST_FOR_TRACKING_PONG,
     };
 
-    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_VIEWZ, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_INTERNAL_DATA, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_OCCLUSION, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_OCCLUSION, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_OCCLUSION_FAST_HISTORY, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_OCCLUSION_FAST_HISTORY, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1});
-    AddTextureToPermanentPool({REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1});
+    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_VIEWZ, 1, TextureClass::PREV_VIEWZ});
+    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1, TextureClass::PREV_NORMAL_ROUGHNESS});
+    AddTextureToPermanentPool({REBLUR_FORMAT_PREV_INTERNAL_DATA, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({REBLUR_FORMAT_OCCLUSION, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({REBLUR_FORMAT_OCCLUSION, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({REBLUR_FORMAT_OCCLUSION_FAST_HISTORY, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({REBLUR_FORMAT_OCCLUSION_FAST_HISTORY, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1, TextureClass::INTERNAL_DATA});
 
     enum class Transient {
         DATA1 = TRANSIENT_POOL_START,
@@ -54,17 +54,18 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSpecularOcclusion(DenoiserData& denoise
     AddTextureToTransientPool({REBLUR_FORMAT_OCCLUSION_FAST_HISTORY, 1});
     AddTextureToTransientPool({REBLUR_FORMAT_OCCLUSION, 1});
     AddTextureToTransientPool({REBLUR_FORMAT_OCCLUSION_FAST_HISTORY, 1});
-    AddTextureToTransientPool({REBLUR_FORMAT_TILES, 16});
+    AddTilesToTransientPool({REBLUR_FORMAT_TILES, 16});
 
     std::array<ShaderMake::ShaderConstant, 2> commonDefines = {{
         NRD_MAKE_SHADER_CONSTANT(NRD_SIGNAL, NRD_SIGNAL_BOTH),
         NRD_MAKE_SHADER_CONSTANT(NRD_MODE, NRD_MODE_OCCLUSION),
     }};
 
-    PushPass("Classify tiles");
+    PushClassifyTilesPass();
     {
         // Inputs
         PushInput(AsUint(ResourceType::IN_VIEWZ));
+        PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
 
         // Outputs
         PushOutput(AsUint(Transient::TILES));
@@ -21,7 +21,7 @@ void nrd::InstanceImpl::Add_Reference(DenoiserData& denoiserData) {
         HISTORY = PERMANENT_POOL_START,
     };
 
-    AddTextureToPermanentPool({Format::RGBA32_SFLOAT, 1});
+    AddTextureToPermanentPool({Format::RGBA32_SFLOAT, 1, TextureClass::HISTORY});
 
     std::array<ShaderMake::ShaderConstant, 0> commonDefines = {};
 
@@ -60,7 +60,10 @@ void nrd::InstanceImpl::Update_Reference(const DenoiserData& denoiserData) {
 
     const ReferenceSettings& settings = denoiserData.settings.reference;
 
-    if (m_WorldToClip != m_WorldToClipPrev || m_CommonSettings.accumulationMode != AccumulationMode::CONTINUE || m_CommonSettings.rectSize[0] != m_CommonSettings.rectSizePrev[0] || m_CommonSettings.rectSize[1] != m_CommonSettings.rectSizePrev[1])
+    // Raw matrices are compared, because REFERENCE doesn't need derived camera state (see "UpdateCamera")
+    bool isCameraChanged = memcmp(m_CommonSettings.worldToViewMatrix, m_CommonSettings.worldToViewMatrixPrev, sizeof(m_CommonSettings.worldToViewMatrix)) || memcmp(m_CommonSettings.viewToClipMatrix, m_CommonSettings.viewToClipMatrixPrev, sizeof(m_CommonSettings.viewToClipMatrix));
+
+    if (isCameraChanged || m_CommonSettings.accumulationMode != AccumulationMode::CONTINUE || m_CommonSettings.rectSize[0] != m_CommonSettings.rectSizePrev[0] || m_CommonSettings.rectSize[1] != m_CommonSettings.rectSizePrev[1])
         m_AccumulatedFrameNum = 0;
     else {
         uint32_t maxAccumulatedFRameNum = min(settings.maxAccumulatedFrameNum, REFERENCE_MAX_HISTORY_FRAME_NUM);
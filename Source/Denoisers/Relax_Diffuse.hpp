@@ -23,31 +23,41 @@ void nrd::InstanceImpl::Add_RelaxDiffuse(DenoiserData& denoiserData) {
         VIEWZ_PREV
     };
 
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::R8_UNORM, 1});
-    AddTextureToPermanentPool({Format::RGBA8_UNORM, 1});
-    AddTextureToPermanentPool({Format::R8_UNORM, 1});
-    AddTextureToPermanentPool({Format::R32_SFLOAT, 1});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::R8_UNORM, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::RGBA8_UNORM, 1, TextureClass::PREV_NORMAL_ROUGHNESS});
+    AddTextureToPermanentPool({Format::R8_UNORM, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::R32_SFLOAT, 1, TextureClass::PREV_VIEWZ});
 
     enum class Transient {
         DIFF_ILLUM_PING = TRANSIENT_POOL_START,
         DIFF_ILLUM_PONG,
         TILES,
-        HISTORY_LENGTH
+        HISTORY_LENGTH,
+        ATROUS_TILES,
+        MIP_VIEWZ,
+        MIP_DIFF = MIP_VIEWZ + RELAX_HISTORY_FIX_MIP_NUM
     };
 
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToTransientPool({Format::R8_UNORM, 16});
+    AddTilesToTransientPool({Format::R8_UNORM, 16});
     AddTextureToTransientPool({Format::R8_UNORM, 1});
+    AddTextureToTransientPool({Format::R8_UNORM, 8});
+
+    for (uint16_t i = 1; i <= RELAX_HISTORY_FIX_MIP_NUM; i++)
+        AddTextureToTransientPool({Format::R32_SFLOAT, uint16_t(1 << i)});
+
+    for (uint16_t i = 1; i <= RELAX_HISTORY_FIX_MIP_NUM; i++)
+        AddTextureToTransientPool({Format::RGBA16_SFLOAT, uint16_t(1 << i)});
 
     std::array<ShaderMake::ShaderConstant, 2> commonDefines = {{
         NRD_MAKE_SHADER_CONSTANT(NRD_SIGNAL, NRD_SIGNAL_DIFF),
         NRD_MAKE_SHADER_CONSTANT(NRD_MODE, NRD_MODE_RADIANCE),
     }};
 
-    PushPass("Classify tiles");
+    PushClassifyTilesPass();
     {
         // Inputs
         PushInput(AsUint(ResourceType::IN_VIEWZ));
@@ -212,6 +222,10 @@ void nrd::InstanceImpl::Add_RelaxDiffuse(DenoiserData& denoiserData) {
             {
                 // Inputs
                 PushInput(AsUint(Transient::TILES));
+
+                if (!isSmem)
+                    PushInput(AsUint(Transient::ATROUS_TILES));
+
                 PushInput(AsUint(Transient::HISTORY_LENGTH));
                 PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
                 PushInput(AsUint(ResourceType::IN_VIEWZ));
@@ -233,6 +247,7 @@ void nrd::InstanceImpl::Add_RelaxDiffuse(DenoiserData& denoiserData) {
                     PushOutput(AsUint(Permanent::NORMAL_ROUGHNESS_PREV));
                     PushOutput(AsUint(Permanent::MATERIAL_ID_PREV));
                     PushOutput(AsUint(Permanent::VIEWZ_PREV));
+                    PushOutput(AsUint(Transient::ATROUS_TILES));
                 }
 
                 // Shaders
@@ -259,6 +274,45 @@ void nrd::InstanceImpl::Add_RelaxDiffuse(DenoiserData& denoiserData) {
     }
 
     RELAX_ADD_VALIDATION_DISPATCH;
+
+    PushPass("History fix (mip generation)");
+    {
+        // Inputs
+        PushInput(AsUint(ResourceType::IN_VIEWZ));
+        PushInput(AsUint(Transient::DIFF_ILLUM_PING));
+
+        // Outputs
+        for (uint16_t i = 0; i < RELAX_HISTORY_FIX_MIP_NUM; i++)
+            PushOutput(uint16_t(AsUint(Transient::MIP_VIEWZ) + i));
+
+        for (uint16_t i = 0; i < RELAX_HISTORY_FIX_MIP_NUM; i++)
+            PushOutput(uint16_t(AsUint(Transient::MIP_DIFF) + i));
+
+        // Shaders
+        AddDispatchWithArgs(RELAX_HistoryFixMipGen, commonDefines, 2, 1);
+    }
+
+    PushPass("History fix (mip)");
+    {
+        // Inputs
+        PushInput(AsUint(Transient::TILES));
+        PushInput(AsUint(Transient::HISTORY_LENGTH));
+        PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
+        PushInput(AsUint(ResourceType::IN_VIEWZ));
+
+        for (uint16_t i = 0; i < RELAX_HISTORY_FIX_MIP_NUM; i++)
+            PushInput(uint16_t(AsUint(Transient::MIP_VIEWZ) + i));
+
+        PushInput(AsUint(Transient::DIFF_ILLUM_PING));
+        for (uint16_t i = 0; i < RELAX_HISTORY_FIX_MIP_NUM; i++)
+            PushInput(uint16_t(AsUint(Transient::MIP_DIFF) + i));
+
+        // Outputs
+        PushOutput(AsUint(Transient::DIFF_ILLUM_PONG));
+
+        // Shaders
+        AddDispatch(RELAX_HistoryFixMip, commonDefines);
+    }
 }
 
 #undef DENOISER_NAME
@@ -25,14 +25,14 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSh(DenoiserData& denoiserData) {
         VIEWZ_PREV
     };
 
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::R8_UNORM, 1});
-    AddTextureToPermanentPool({Format::RGBA8_UNORM, 1});
-    AddTextureToPermanentPool({Format::R8_UNORM, 1});
-    AddTextureToPermanentPool({Format::R32_SFLOAT, 1});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::R8_UNORM, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::RGBA8_UNORM, 1, TextureClass::PREV_NORMAL_ROUGHNESS});
+    AddTextureToPermanentPool({Format::R8_UNORM, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::R32_SFLOAT, 1, TextureClass::PREV_VIEWZ});
 
     enum class Transient {
         DIFF_ILLUM_PING = TRANSIENT_POOL_START,
@@ -40,22 +40,24 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSh(DenoiserData& denoiserData) {
         DIFF_ILLUM_PONG,
         DIFF_ILLUM_PONG_SH1,
         TILES,
-        HISTORY_LENGTH
+        HISTORY_LENGTH,
+        ATROUS_TILES
     };
 
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToTransientPool({Format::R8_UNORM, 16});
+    AddTilesToTransientPool({Format::R8_UNORM, 16});
     AddTextureToTransientPool({Format::R8_UNORM, 1});
+    AddTextureToTransientPool({Format::R8_UNORM, 8});
 
     std::array<ShaderMake::ShaderConstant, 2> commonDefines = {{
         NRD_MAKE_SHADER_CONSTANT(NRD_SIGNAL, NRD_SIGNAL_DIFF),
         NRD_MAKE_SHADER_CONSTANT(NRD_MODE, NRD_MODE_SH),
     }};
 
-    PushPass("Classify tiles");
+    PushClassifyTilesPass();
     {
         // Inputs
         PushInput(AsUint(ResourceType::IN_VIEWZ));
@@ -233,6 +235,10 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSh(DenoiserData& denoiserData) {
             {
                 // Inputs
                 PushInput(AsUint(Transient::TILES));
+
+                if (!isSmem)
+                    PushInput(AsUint(Transient::ATROUS_TILES));
+
                 PushInput(AsUint(Transient::HISTORY_LENGTH));
                 PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
                 PushInput(AsUint(ResourceType::IN_VIEWZ));
@@ -259,6 +265,7 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSh(DenoiserData& denoiserData) {
                     PushOutput(AsUint(Permanent::NORMAL_ROUGHNESS_PREV));
                     PushOutput(AsUint(Permanent::MATERIAL_ID_PREV));
                     PushOutput(AsUint(Permanent::VIEWZ_PREV));
+                    PushOutput(AsUint(Transient::ATROUS_TILES));
                 }
 
                 if (isLast)
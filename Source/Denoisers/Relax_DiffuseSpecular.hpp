@@ -27,16 +27,16 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecular(DenoiserData& denoiserData) {
         VIEWZ_PREV,
     };
 
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::R16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::R16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::R8_UNORM, 1});
-    AddTextureToPermanentPool({Format::RGBA8_UNORM, 1});
-    AddTextureToPermanentPool({Format::R8_UNORM, 1});
-    AddTextureToPermanentPool({Format::R32_SFLOAT, 1});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::R16_SFLOAT, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::R16_SFLOAT, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::R8_UNORM, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::RGBA8_UNORM, 1, TextureClass::PREV_NORMAL_ROUGHNESS});
+    AddTextureToPermanentPool({Format::R8_UNORM, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::R32_SFLOAT, 1, TextureClass::PREV_VIEWZ});
 
     enum class Transient {
         SPEC_ILLUM_PING = TRANSIENT_POOL_START,
@@ -45,7 +45,11 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecular(DenoiserData& denoiserData) {
         DIFF_ILLUM_PONG,
         SPEC_REPROJECTION_CONFIDENCE,
         TILES,
-        HISTORY_LENGTH
+        HISTORY_LENGTH,
+        ATROUS_TILES,
+        MIP_VIEWZ,
+        MIP_SPEC = MIP_VIEWZ + RELAX_HISTORY_FIX_MIP_NUM,
+        MIP_DIFF = MIP_SPEC + RELAX_HISTORY_FIX_MIP_NUM
     };
 
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
@@ -53,15 +57,25 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecular(DenoiserData& denoiserData) {
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
     AddTextureToTransientPool({Format::R8_UNORM, 1});
-    AddTextureToTransientPool({Format::R8_UNORM, 16});
+    AddTilesToTransientPool({Format::R8_UNORM, 16});
     AddTextureToTransientPool({Format::R8_UNORM, 1});
+    AddTextureToTransientPool({Format::R8_UNORM, 8});
+
+    for (uint16_t i = 1; i <= RELAX_HISTORY_FIX_MIP_NUM; i++)
+        AddTextureToTransientPool({Format::R32_SFLOAT, uint16_t(1 << i)});
+
+    for (uint16_t i = 1; i <= RELAX_HISTORY_FIX_MIP_NUM; i++)
+        AddTextureToTransientPool({Format::RGBA16_SFLOAT, uint16_t(1 << i)});
+
+    for (uint16_t i = 1; i <= RELAX_HISTORY_FIX_MIP_NUM; i++)
+        AddTextureToTransientPool({Format::RGBA16_SFLOAT, uint16_t(1 << i)});
 
     std::array<ShaderMake::ShaderConstant, 2> commonDefines = {{
         NRD_MAKE_SHADER_CONSTANT(NRD_SIGNAL, NRD_SIGNAL_BOTH),
         NRD_MAKE_SHADER_CONSTANT(NRD_MODE, NRD_MODE_RADIANCE),
     }};
 
-    PushPass("Classify tiles");
+    PushClassifyTilesPass();
     {
         // Inputs
         PushInput(AsUint(ResourceType::IN_VIEWZ));
@@ -250,6 +264,10 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecular(DenoiserData& denoiserData) {
             {
                 // Inputs
                 PushInput(AsUint(Transient::TILES));
+
+                if (!isSmem)
+                    PushInput(AsUint(Transient::ATROUS_TILES));
+
                 PushInput(AsUint(Transient::HISTORY_LENGTH));
                 PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
                 PushInput(AsUint(ResourceType::IN_VIEWZ));
@@ -279,6 +297,7 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecular(DenoiserData& denoiserData) {
                     PushOutput(AsUint(Permanent::NORMAL_ROUGHNESS_PREV));
                     PushOutput(AsUint(Permanent::MATERIAL_ID_PREV));
                     PushOutput(AsUint(Permanent::VIEWZ_PREV));
+                    PushOutput(AsUint(Transient::ATROUS_TILES));
                 }
 
                 // Shaders
@@ -307,6 +326,54 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecular(DenoiserData& denoiserData) {
     }
 
     RELAX_ADD_VALIDATION_DISPATCH;
+
+    PushPass("History fix (mip generation)");
+    {
+        // Inputs
+        PushInput(AsUint(ResourceType::IN_VIEWZ));
+        PushInput(AsUint(Transient::SPEC_ILLUM_PING));
+        PushInput(AsUint(Transient::DIFF_ILLUM_PING));
+
+        // Outputs
+        for (uint16_t i = 0; i < RELAX_HISTORY_FIX_MIP_NUM; i++)
+            PushOutput(uint16_t(AsUint(Transient::MIP_VIEWZ) + i));
+
+        for (uint16_t i = 0; i < RELAX_HISTORY_FIX_MIP_NUM; i++)
+            PushOutput(uint16_t(AsUint(Transient::MIP_SPEC) + i));
+
+        for (uint16_t i = 0; i < RELAX_HISTORY_FIX_MIP_NUM; i++)
+            PushOutput(uint16_t(AsUint(Transient::MIP_DIFF) + i));
+
+        // Shaders
+        AddDispatchWithArgs(RELAX_HistoryFixMipGen, commonDefines, 2, 1);
+    }
+
+    PushPass("History fix (mip)");
+    {
+        // Inputs
+        PushInput(AsUint(Transient::TILES));
+        PushInput(AsUint(Transient::HISTORY_LENGTH));
+        PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
+        PushInput(AsUint(ResourceType::IN_VIEWZ));
+
+        for (uint16_t i = 0; i < RELAX_HISTORY_FIX_MIP_NUM; i++)
+            PushInput(uint16_t(AsUint(Transient::MIP_VIEWZ) + i));
+
+        PushInput(AsUint(Transient::SPEC_ILLUM_PING));
+        for (uint16_t i = 0; i < RELAX_HISTORY_FIX_MIP_NUM; i++)
+            PushInput(uint16_t(AsUint(Transient::MIP_SPEC) + i));
+
+        PushInput(AsUint(Transient::DIFF_ILLUM_PING));
+        for (uint16_t i = 0; i < RELAX_HISTORY_FIX_MIP_NUM; i++)
+            PushInput(uint16_t(AsUint(Transient::MIP_DIFF) + i));
+
+        // Outputs
+        PushOutput(AsUint(Transient::SPEC_ILLUM_PONG));
+        PushOutput(AsUint(Transient::DIFF_ILLUM_PONG));
+
+        // Shaders
+        AddDispatch(RELAX_HistoryFixMip, commonDefines);
+    }
 }
 
 #undef DENOISER_NAME
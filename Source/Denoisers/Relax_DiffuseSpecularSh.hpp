@@ -31,20 +31,20 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecularSh(DenoiserData& denoiserData) {
         VIEWZ_PREV,
     };
 
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::R16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::R16_SFLOAT, 1});
-    AddTextureToPermanentPool({Format::R8_UNORM, 1});
-    AddTextureToPermanentPool({Format::RGBA8_UNORM, 1});
-    AddTextureToPermanentPool({Format::R8_UNORM, 1});
-    AddTextureToPermanentPool({Format::R32_SFLOAT, 1});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::RGBA16_SFLOAT, 1, TextureClass::FAST_HISTORY});
+    AddTextureToPermanentPool({Format::R16_SFLOAT, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::R16_SFLOAT, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::R8_UNORM, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::RGBA8_UNORM, 1, TextureClass::PREV_NORMAL_ROUGHNESS});
+    AddTextureToPermanentPool({Format::R8_UNORM, 1, TextureClass::INTERNAL_DATA});
+    AddTextureToPermanentPool({Format::R32_SFLOAT, 1, TextureClass::PREV_VIEWZ});
 
     enum class Transient {
         SPEC_ILLUM_PING = TRANSIENT_POOL_START,
@@ -57,7 +57,8 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecularSh(DenoiserData& denoiserData) {
         DIFF_ILLUM_PONG_SH1,
         SPEC_REPROJECTION_CONFIDENCE,
         TILES,
-        HISTORY_LENGTH
+        HISTORY_LENGTH,
+        ATROUS_TILES
     };
 
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
@@ -69,15 +70,16 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecularSh(DenoiserData& denoiserData) {
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
     AddTextureToTransientPool({Format::RGBA16_SFLOAT, 1});
     AddTextureToTransientPool({Format::R8_UNORM, 1});
-    AddTextureToTransientPool({Format::R8_UNORM, 16});
+    AddTilesToTransientPool({Format::R8_UNORM, 16});
     AddTextureToTransientPool({Format::R8_UNORM, 1});
+    AddTextureToTransientPool({Format::R8_UNORM, 8});
 
     std::array<ShaderMake::ShaderConstant, 2> commonDefines = {{
         NRD_MAKE_SHADER_CONSTANT(NRD_SIGNAL, NRD_SIGNAL_BOTH),
         NRD_MAKE_SHADER_CONSTANT(NRD_MODE, NRD_MODE_SH),
     }};
 
-    PushPass("Classify tiles");
+    PushClassifyTilesPass();
     {
         // Inputs
         PushInput(AsUint(ResourceType::IN_VIEWZ));
@@ -292,6 +294,10 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecularSh(DenoiserData& denoiserData) {
             {
                 // Inputs
                 PushInput(AsUint(Transient::TILES));
+
+                if (!isSmem)
+                    PushInput(AsUint(Transient::ATROUS_TILES));
+
                 PushInput(AsUint(Transient::HISTORY_LENGTH));
                 PushInput(AsUint(ResourceType::IN_NORMAL_ROUGHNESS));
                 PushInput(AsUint(ResourceType::IN_VIEWZ));
@@ -329,6 +335,7 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecularSh(DenoiserData& denoiserData) {
                     PushOutput(AsUint(Permanent::NORMAL_ROUGHNESS_PREV));
                     PushOutput(AsUint(Permanent::MATERIAL_ID_PREV));
                     PushOutput(AsUint(Permanent::VIEWZ_PREV));
+                    PushOutput(AsUint(Transient::ATROUS_TILES));
                 }
 
                 if (isLast) {
@@ -18,7 +18,7 @@ void nrd::InstanceImpl::Add_SigmaShadow(DenoiserData& denoiserData) {
         HISTORY_LENGTH = PERMANENT_POOL_START,
     };
 
-    AddTextureToPermanentPool({Format::R32_UINT, 1});
+    AddTextureToPermanentPool({Format::R32_UINT, 1, TextureClass::INTERNAL_DATA});
 
     enum class Transient {
         DATA_1 = TRANSIENT_POOL_START,
@@ -44,7 +44,7 @@ void nrd::InstanceImpl::Add_SigmaShadow(DenoiserData& denoiserData) {
         {"TRANSLUCENCY", "0"},
     }};
 
-    PushPass("Classify tiles");
+    PushClassifyTilesPass();
     {
         // Inputs
         PushInput(AsUint(ResourceType::IN_VIEWZ));
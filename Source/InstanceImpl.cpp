@@ -64,6 +64,8 @@ constexpr std::array<bool, (size_t)nrd::Format::MAX_NUM> g_IsIntegerFormat = {
 
 #include "../Shaders/Clear.resources.hlsli"
 
+static_assert(ClearBatchSize == nrd::CLEAR_BATCH_SIZE, "ClearBatchSize & CLEAR_BATCH_SIZE don't match!");
+
 #if NRD_EMBEDS_DXBC_SHADERS
 #    include "Clear.cs.dxbc.h"
 #endif
@@ -85,9 +87,53 @@ inline bool IsInList(nrd::Identifier identifier, const nrd::Identifier* identifi
     return false;
 }
 
+// FNV-1a
+constexpr uint64_t HASH_OFFSET = 14695981039346656037ull;
+constexpr uint64_t HASH_PRIME = 1099511628211ull;
+
+inline uint64_t Hash(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * HASH_PRIME;
+
+    return hash;
+}
+
+// Zero camera delta and the same inputs as on the previous frame, apart from values expected to change on each frame
+inline bool IsStaticFrame(const nrd::CommonSettings& curr, const nrd::CommonSettings& prev) {
+    if (curr.accumulationMode != nrd::AccumulationMode::CONTINUE)
+        return false;
+
+    if (memcmp(curr.worldToViewMatrix, curr.worldToViewMatrixPrev, sizeof(curr.worldToViewMatrix)) || memcmp(curr.viewToClipMatrix, curr.viewToClipMatrixPrev, sizeof(curr.viewToClipMatrix)))
+        return false;
+
+    nrd::CommonSettings temp = curr;
+    memcpy(temp.cameraJitter, prev.cameraJitter, sizeof(temp.cameraJitter));
+    memcpy(temp.cameraJitterPrev, prev.cameraJitterPrev, sizeof(temp.cameraJitterPrev));
+    temp.timeDeltaBetweenFrames = prev.timeDeltaBetweenFrames;
+    temp.frameIndex = prev.frameIndex;
+
+    return !memcmp(&temp, &prev, sizeof(temp)); // a false negative is harmless
+}
+
+// Frames needed for accumulation to saturate if inputs are static
+inline uint32_t GetConvergedFrameNum(const nrd::DenoiserData& denoiserData) {
+    if ((uint32_t)denoiserData.desc.denoiser <= (uint32_t)nrd::Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION)
+        return denoiserData.settings.reblur.maxAccumulatedFrameNum;
+    else if ((uint32_t)denoiserData.desc.denoiser <= (uint32_t)nrd::Denoiser::RELAX_DIFFUSE_SPECULAR_SH)
+        return std::max(denoiserData.settings.relax.diffuseMaxAccumulatedFrameNum, denoiserData.settings.relax.specularMaxAccumulatedFrameNum);
+    else if (denoiserData.desc.denoiser == nrd::Denoiser::SIGMA_SHADOW || denoiserData.desc.denoiser == nrd::Denoiser::SIGMA_SHADOW_TRANSLUCENCY)
+        return denoiserData.settings.sigma.maxStabilizedFrameNum ? denoiserData.settings.sigma.maxStabilizedFrameNum : uint32_t(-1);
+
+    return uint32_t(-1);
+}
+
 nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreationDesc) {
     const LibraryDesc& libraryDesc = *GetLibraryDesc();
 
+    m_Shared = Allocate<SharedTables>(GetStdAllocator(), GetStdAllocator());
+    m_EnableSharedTileClassification = instanceCreationDesc.enableSharedTileClassification;
+
     // Collect dispatches from all denoisers
     for (uint32_t i = 0; i < instanceCreationDesc.denoisersNum; i++) {
         const DenoiserDesc& denoiserDesc = instanceCreationDesc.denoisers[i];
@@ -101,6 +147,10 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
         if (j == libraryDesc.supportedDenoisersNum)
             return Result::UNSUPPORTED;
 
+        // Check that half resolution is requested only for a denoiser supporting it
+        if (denoiserDesc.enableHalfResolution && denoiserDesc.denoiser != Denoiser::REBLUR_DIFFUSE)
+            return Result::UNSUPPORTED;
+
         // Check that identifier is unique
         for (j = 0; j < instanceCreationDesc.denoisersNum; j++) {
             if (i != j && instanceCreationDesc.denoisers[j].identifier == denoiserDesc.identifier)
@@ -108,14 +158,15 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
         }
 
         // Append dispatches for the current denoiser
-        m_PermanentPoolOffset = (uint16_t)m_PermanentPool.size();
-        m_TransientPoolOffset = (uint16_t)m_TransientPool.size();
+        m_PermanentPoolOffset = (uint16_t)m_Shared->permanentPool.size();
+        m_TransientPoolOffset = (uint16_t)m_Shared->transientPool.size();
 
         m_IndexRemap.clear();
+        m_SharedTilesLocalIndex = uint16_t(-1);
 
         DenoiserData denoiserData = {};
         denoiserData.desc = denoiserDesc;
-        denoiserData.dispatchOffset = m_Dispatches.size();
+        denoiserData.dispatchOffset = m_Shared->dispatches.size();
         denoiserData.pingPongOffset = m_PingPongs.size();
 
         size_t resourceOffset = m_Resources.size();
@@ -162,10 +213,11 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
             return Result::INVALID_ARGUMENT;
 
         denoiserData.pingPongNum = m_PingPongs.size() - denoiserData.pingPongOffset;
+        denoiserData.usesSharedTiles = m_SharedTilesLocalIndex != uint16_t(-1);
 
         // Patch identifiers
-        for (size_t dispatchIndex = denoiserData.dispatchOffset; dispatchIndex < m_Dispatches.size(); dispatchIndex++) {
-            InternalDispatchDesc& internalDispatchDesc = m_Dispatches[dispatchIndex];
+        for (size_t dispatchIndex = denoiserData.dispatchOffset; dispatchIndex < m_Shared->dispatches.size(); dispatchIndex++) {
+            InternalDispatchDesc& internalDispatchDesc = m_Shared->dispatches[dispatchIndex];
             internalDispatchDesc.identifier = denoiserDesc.identifier;
         }
 
@@ -183,7 +235,7 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
 
             // Keep only unique instances
             bool isFound = false;
-            for (const ClearResource& temp : m_ClearResources) {
+            for (const ClearResource& temp : m_Shared->clearResources) {
                 if (temp.resource.descriptorType == resource.descriptorType && temp.resource.type == resource.type && temp.resource.indexInPool == resource.indexInPool) {
                     isFound = true;
                     break;
@@ -195,20 +247,20 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
                 bool isInteger = false;
                 uint16_t downsampleFactor = 1;
                 if (resource.type == ResourceType::PERMANENT_POOL || resource.type == ResourceType::TRANSIENT_POOL) {
-                    TextureDesc& textureDesc = resource.type == ResourceType::PERMANENT_POOL ? m_PermanentPool[resource.indexInPool] : m_TransientPool[resource.indexInPool];
+                    TextureDesc& textureDesc = resource.type == ResourceType::PERMANENT_POOL ? m_Shared->permanentPool[resource.indexInPool] : m_Shared->transientPool[resource.indexInPool];
                     isInteger = g_IsIntegerFormat[(size_t)textureDesc.format];
                     downsampleFactor = textureDesc.downsampleFactor;
                 }
 
                 // Add PING resource
-                m_ClearResources.push_back({denoiserDesc.identifier, resource, downsampleFactor, isInteger});
+                m_Shared->clearResources.push_back({denoiserDesc.identifier, resource, downsampleFactor, isInteger});
 
                 // Add PONG resource
                 for (uint32_t p = 0; p < denoiserData.pingPongNum; p++) {
                     const PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + p];
                     if (pingPong.resourceIndex == (uint32_t)resourceIndex) {
                         ResourceDesc resourcePong = {resource.descriptorType, resource.type, pingPong.indexInPoolToSwapWith};
-                        m_ClearResources.push_back({denoiserDesc.identifier, resourcePong, downsampleFactor, isInteger});
+                        m_Shared->clearResources.push_back({denoiserDesc.identifier, resourcePong, downsampleFactor, isInteger});
                         break;
                     }
                 }
@@ -219,30 +271,91 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
     }
 
     // Add "clear" dispatches
-    m_DispatchClearIndex[0] = m_Dispatches.size();
-    _PushPass("Clear (f)");
+    m_DispatchClearIndex[0] = m_Shared->dispatches.size();
+    _PushPass("Clear (f)", PipelineType::CLEAR);
     {
         PushOutput(0);
 
-        std::array<ShaderMake::ShaderConstant, 1> defines = {
-            {{"FLOAT", "1"}},
+        std::array<ShaderMake::ShaderConstant, 2> defines = {
+            {{"FLOAT", "1"}, {"BATCH", "0"}},
         };
         AddDispatchNoConstants(Clear, defines);
     }
 
-    m_DispatchClearIndex[1] = m_Dispatches.size();
-    _PushPass("Clear (ui)");
+    m_DispatchClearIndex[1] = m_Shared->dispatches.size();
+    _PushPass("Clear (ui)", PipelineType::CLEAR);
     {
         PushOutput(0);
 
-        std::array<ShaderMake::ShaderConstant, 1> defines = {
-            {{"FLOAT", "0"}},
+        std::array<ShaderMake::ShaderConstant, 2> defines = {
+            {{"FLOAT", "0"}, {"BATCH", "0"}},
+        };
+        AddDispatchNoConstants(Clear, defines);
+    }
+
+    m_DispatchClearIndex[2] = m_Shared->dispatches.size();
+    _PushPass("Clear batch (f)", PipelineType::CLEAR);
+    {
+        for (uint16_t i = 0; i < CLEAR_BATCH_SIZE; i++)
+            PushOutput(i);
+
+        std::array<ShaderMake::ShaderConstant, 2> defines = {
+            {{"FLOAT", "1"}, {"BATCH", "1"}},
         };
         AddDispatchNoConstants(Clear, defines);
     }
 
+    m_DispatchClearIndex[3] = m_Shared->dispatches.size();
+    _PushPass("Clear batch (ui)", PipelineType::CLEAR);
+    {
+        for (uint16_t i = 0; i < CLEAR_BATCH_SIZE; i++)
+            PushOutput(i);
+
+        std::array<ShaderMake::ShaderConstant, 2> defines = {
+            {{"FLOAT", "0"}, {"BATCH", "1"}},
+        };
+        AddDispatchNoConstants(Clear, defines);
+    }
+
+    m_ClearBatches.reserve(m_Shared->clearResources.size());
+
     PrepareDesc();
 
+    // Release lookup tables needed only for creation
+    m_Permutations = HashMap<uint64_t, PermutationEntry>(GetStdAllocator());
+    m_IndexedBlobs = HashMap<uint64_t, bool>(GetStdAllocator());
+    m_PipelineIndices = HashMap<uint64_t, uint16_t>(GetStdAllocator());
+
+    // IMPORTANT: since now all std::vectors become "locked" (no reallocations)
+
+    return Result::SUCCESS;
+}
+
+nrd::Result nrd::InstanceImpl::Clone(const InstanceImpl& instance) {
+    // Immutable tables are shared
+    m_Shared = instance.m_Shared;
+    m_Shared->refCount++;
+
+    m_Desc = instance.m_Desc;
+    m_EnableSharedTileClassification = instance.m_EnableSharedTileClassification;
+    m_SharedTilesIndexInPool = instance.m_SharedTilesIndexInPool;
+    memcpy(m_DispatchClearIndex, instance.m_DispatchClearIndex, sizeof(m_DispatchClearIndex));
+
+    // Mutable state is duplicated: settings are inherited, the per-frame state starts from scratch ("m_IsFirstUse" triggers "CLEAR_AND_RESTART").
+    // Ping-pong parity is copied "as is", which is fine because a clone has its own textures
+    m_DenoiserData = instance.m_DenoiserData;
+    for (DenoiserData& denoiserData : m_DenoiserData) {
+        denoiserData.emptyFrameNum = 0;
+        denoiserData.unchangedFrameNum = 0;
+        denoiserData.activeTileNum = 0;
+        denoiserData.isSkipped = false;
+        denoiserData.isRestartRequested = false;
+    }
+
+    m_Resources = instance.m_Resources;
+    m_PingPongs = instance.m_PingPongs;
+    m_ClearBatches.reserve(m_Shared->clearResources.size());
+
     // IMPORTANT: since now all std::vectors become "locked" (no reallocations)
 
     return Result::SUCCESS;
@@ -252,6 +365,9 @@ nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSet
     m_SplitScreenPrev = m_CommonSettings.splitScreen;
 
     bool isNewFrame = m_IsFirstUse || m_CommonSettings.frameIndex != commonSettings.frameIndex; // prev != curr
+    bool isStaticFrame = !m_IsFirstUse && IsStaticFrame(commonSettings, m_CommonSettings);
+    m_IsStaticFrame = isNewFrame ? isStaticFrame : (m_IsStaticFrame && isStaticFrame);
+
     memcpy(&m_CommonSettings, &commonSettings, sizeof(commonSettings));
 
     // Silently fix settings for known cases
@@ -263,9 +379,6 @@ nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSet
     if (m_CommonSettings.accumulationMode != AccumulationMode::CONTINUE) {
         m_SplitScreenPrev = 0.0f;
 
-        m_WorldToViewPrev = m_WorldToView;
-        m_ViewToClipPrev = m_ViewToClip;
-
         m_CommonSettings.resourceSizePrev[0] = m_CommonSettings.resourceSize[0];
         m_CommonSettings.resourceSizePrev[1] = m_CommonSettings.resourceSize[1];
 
@@ -328,114 +441,8 @@ nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSet
     isValid &= NRD_SUPPORTS_DISOCCLUSION_THRESHOLD_MIX || !m_CommonSettings.isDisocclusionThresholdMixAvailable;
     assert("'isDisocclusionThresholdMixAvailable' must be 'false' if 'NRD_SUPPORTS_DISOCCLUSION_THRESHOLD_MIX = 0'" && isValid);
 
-    { // Rotators (respecting sample patterns symmetry)
-        // Square roots of primes provide excellent decorrelation for Weyl sequences
-        float anglePre = Sequence::Weyl1D(1.0f / sqrt(2.0f), m_CommonSettings.frameIndex);
-        float angle = Sequence::Weyl1D(1.0f / sqrt(3.0f), m_CommonSettings.frameIndex);
-
-        // "PostBlur" rotator is rotated to avoid mapping to same directions after "Blur"
-        constexpr float minNonSymmetryAngle = 22.5f; // see the kernel: 90 - symmetry angle, 45 - same directions
-
-        m_RotatorPre = Geometry::GetRotator(anglePre * radians(90.0f));
-        m_Rotator = Geometry::GetRotator(angle * radians(90.0f));
-        m_RotatorPost = Geometry::GetRotator(angle * radians(90.0f) + radians(minNonSymmetryAngle));
-    }
-
-    // Main matrices
-    m_ViewToClip = float4x4(
-        float4(m_CommonSettings.viewToClipMatrix),
-        float4(m_CommonSettings.viewToClipMatrix + 4),
-        float4(m_CommonSettings.viewToClipMatrix + 8),
-        float4(m_CommonSettings.viewToClipMatrix + 12));
-
-    m_ViewToClipPrev = float4x4(
-        float4(m_CommonSettings.viewToClipMatrixPrev),
-        float4(m_CommonSettings.viewToClipMatrixPrev + 4),
-        float4(m_CommonSettings.viewToClipMatrixPrev + 8),
-        float4(m_CommonSettings.viewToClipMatrixPrev + 12));
-
-    m_WorldToView = float4x4(
-        float4(m_CommonSettings.worldToViewMatrix),
-        float4(m_CommonSettings.worldToViewMatrix + 4),
-        float4(m_CommonSettings.worldToViewMatrix + 8),
-        float4(m_CommonSettings.worldToViewMatrix + 12));
-
-    m_WorldToViewPrev = float4x4(
-        float4(m_CommonSettings.worldToViewMatrixPrev),
-        float4(m_CommonSettings.worldToViewMatrixPrev + 4),
-        float4(m_CommonSettings.worldToViewMatrixPrev + 8),
-        float4(m_CommonSettings.worldToViewMatrixPrev + 12));
-
-    m_WorldPrevToWorld = float4x4(
-        float4(m_CommonSettings.worldPrevToWorldMatrix),
-        float4(m_CommonSettings.worldPrevToWorldMatrix + 4),
-        float4(m_CommonSettings.worldPrevToWorldMatrix + 8),
-        float4(m_CommonSettings.worldPrevToWorldMatrix + 12));
-
-    // Convert to LH
-    uint32_t flags = 0;
-    DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClip, &flags, nullptr, nullptr, m_Frustum.a, nullptr, nullptr);
-
-    if (!(flags & PROJ_LEFT_HANDED)) {
-        m_ViewToClip[2] = -m_ViewToClip[2];
-        m_ViewToClipPrev[2] = -m_ViewToClipPrev[2];
-
-        m_WorldToView.Transpose();
-        m_WorldToView[2] = -m_WorldToView[2];
-        m_WorldToView.Transpose();
-
-        m_WorldToViewPrev.Transpose();
-        m_WorldToViewPrev[2] = -m_WorldToViewPrev[2];
-        m_WorldToViewPrev.Transpose();
-    }
-
-    // Compute other matrices
-    m_ViewToWorld = m_WorldToView;
-    m_ViewToWorld.InvertOrtho();
-
-    m_ViewToWorldPrev = m_WorldToViewPrev;
-    m_ViewToWorldPrev.InvertOrtho();
-
-    const float3& cameraPosition = m_ViewToWorld[3].xyz;
-    const float3& cameraPositionPrev = m_ViewToWorldPrev[3].xyz;
-    float3 translationDelta = cameraPositionPrev - cameraPosition;
-
-    // IMPORTANT: this part is mandatory needed to preserve precision by making matrices camera relative
-    m_ViewToWorld.SetTranslation(float3::Zero());
-    m_WorldToView = m_ViewToWorld;
-    m_WorldToView.InvertOrtho();
-
-    m_ViewToWorldPrev.SetTranslation(translationDelta);
-    m_WorldToViewPrev = m_ViewToWorldPrev;
-    m_WorldToViewPrev.InvertOrtho();
-
-    m_WorldToClip = m_ViewToClip * m_WorldToView;
-    m_WorldToClipPrev = m_ViewToClipPrev * m_WorldToViewPrev;
-
-    m_ClipToWorldPrev = m_WorldToClipPrev;
-    m_ClipToWorldPrev.Invert();
-
-    m_ClipToView = m_ViewToClip;
-    m_ClipToView.Invert();
-
-    m_ClipToViewPrev = m_ViewToClipPrev;
-    m_ClipToViewPrev.Invert();
-
-    m_ClipToWorld = m_WorldToClip;
-    m_ClipToWorld.Invert();
-
-    float project[3];
-    DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClip, &flags, nullptr, nullptr, m_Frustum.a, project, nullptr);
-
-    m_ProjectY = project[1];
-    m_OrthoMode = (flags & PROJ_ORTHO) ? -1.0f : 0.0f;
-
-    DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClipPrev, &flags, nullptr, nullptr, m_FrustumPrev.a, nullptr, nullptr);
-
-    m_ViewDirection = -float3(m_ViewToWorld[2]);
-    m_ViewDirectionPrev = -float3(m_ViewToWorldPrev[2]);
-
-    m_CameraDelta = float3(translationDelta.x, translationDelta.y, translationDelta.z);
+    // Derived camera state is computed on first use (see "UpdateCamera")
+    m_IsCameraDirty = true;
 
     if (isNewFrame) {
         m_Timer.UpdateElapsedTimeSinceLastSave();
@@ -459,9 +466,13 @@ nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSet
 nrd::Result nrd::InstanceImpl::SetDenoiserSettings(Identifier identifier, const void* denoiserSettings) {
     for (DenoiserData& denoiserData : m_DenoiserData) {
         if (denoiserData.desc.identifier == identifier) {
+            if (memcmp(&denoiserData.settings, denoiserSettings, denoiserData.settingsSize))
+                denoiserData.unchangedFrameNum = 0;
+
             memcpy(&denoiserData.settings, denoiserSettings, denoiserData.settingsSize);
 
             bool enableAntiFirefly = false;
+            bool enableMipBasedHistoryFix = false;
             CheckerboardMode checkerboardMode = CheckerboardMode::OFF;
 
             if ((uint32_t)denoiserData.desc.denoiser <= (uint32_t)Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION) {
@@ -471,6 +482,7 @@ nrd::Result nrd::InstanceImpl::SetDenoiserSettings(Identifier identifier, const
             } else if ((uint32_t)denoiserData.desc.denoiser <= (uint32_t)Denoiser::RELAX_DIFFUSE_SPECULAR_SH) {
                 const RelaxSettings& settings = *(RelaxSettings*)denoiserSettings;
                 enableAntiFirefly = settings.enableAntiFirefly;
+                enableMipBasedHistoryFix = settings.enableMipBasedHistoryFix;
                 checkerboardMode = settings.checkerboardMode;
             } else if (denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW || denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW_TRANSLUCENCY) {
                 const SigmaSettings& settings = *(SigmaSettings*)denoiserSettings;
@@ -483,7 +495,52 @@ nrd::Result nrd::InstanceImpl::SetDenoiserSettings(Identifier identifier, const
             bool isCheckerboardValid = NRD_SUPPORTS_CHECKERBOARD || checkerboardMode == CheckerboardMode::OFF;
             assert("'checkerboardMode' must be 'OFF' if 'NRD_SUPPORTS_CHECKERBOARD = 0'" && isCheckerboardValid);
 
-            return (isAntifireflyValid && isCheckerboardValid) ? Result::SUCCESS : Result::INVALID_ARGUMENT;
+            bool isHalfResolutionValid = !denoiserData.desc.enableHalfResolution || checkerboardMode == CheckerboardMode::OFF;
+            assert("'checkerboardMode' must be 'OFF' if 'DenoiserDesc::enableHalfResolution = true'" && isHalfResolutionValid);
+
+            bool isSh = denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SH || denoiserData.desc.denoiser == Denoiser::RELAX_SPECULAR_SH || denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SPECULAR_SH;
+            bool isMipBasedHistoryFixValid = !enableMipBasedHistoryFix || !isSh;
+            assert("'enableMipBasedHistoryFix' is not supported by RELAX SH denoisers" && isMipBasedHistoryFixValid);
+
+            return (isAntifireflyValid && isCheckerboardValid && isHalfResolutionValid && isMipBasedHistoryFixValid) ? Result::SUCCESS : Result::INVALID_ARGUMENT;
+        }
+    }
+
+    return Result::INVALID_ARGUMENT;
+}
+
+nrd::Result nrd::InstanceImpl::SetDenoiserFeedback(Identifier identifier, uint32_t activeTileNum) {
+    for (DenoiserData& denoiserData : m_DenoiserData) {
+        if (denoiserData.desc.identifier == identifier) {
+            // No tile classification
+            if (denoiserData.desc.denoiser == Denoiser::REFERENCE)
+                return Result::INVALID_ARGUMENT;
+
+            if (activeTileNum)
+                denoiserData.emptyFrameNum = 0;
+            else if (denoiserData.emptyFrameNum != uint32_t(-1))
+                denoiserData.emptyFrameNum++;
+
+            // Cheap change detection for a frozen denoiser
+            if (activeTileNum != denoiserData.activeTileNum)
+                denoiserData.unchangedFrameNum = 0;
+
+            denoiserData.activeTileNum = activeTileNum;
+
+            return Result::SUCCESS;
+        }
+    }
+
+    return Result::INVALID_ARGUMENT;
+}
+
+nrd::Result nrd::InstanceImpl::RestartDenoiser(Identifier identifier) {
+    for (DenoiserData& denoiserData : m_DenoiserData) {
+        if (denoiserData.desc.identifier == identifier) {
+            denoiserData.isRestartRequested = true;
+            denoiserData.unchangedFrameNum = 0;
+
+            return Result::SUCCESS;
         }
     }
 
@@ -493,6 +550,8 @@ nrd::Result nrd::InstanceImpl::SetDenoiserSettings(Identifier identifier, const
 nrd::Result nrd::InstanceImpl::GetComputeDispatches(const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum) {
     m_ConstantDataOffset = 0;
     m_ActiveDispatches.clear();
+    m_ClearBatches.clear();
+    m_AreSharedTilesClassified = false;
 
     // Trivial checks
     if (!identifiers || !identifiersNum) {
@@ -503,39 +562,48 @@ nrd::Result nrd::InstanceImpl::GetComputeDispatches(const Identifier* identifier
     }
 
     // Inject "clear" calls if needed
-    if (m_CommonSettings.accumulationMode == AccumulationMode::CLEAR_AND_RESTART) {
-        for (const ClearResource& clearResource : m_ClearResources) {
-            // If current denoiser is in list
-            if (!IsInList(clearResource.identifier, identifiers, identifiersNum))
-                continue;
-
-            // Add a clear dispatch
-            const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[m_DispatchClearIndex[clearResource.isInteger ? 1 : 0]];
-
-            uint16_t w = DivideUp(m_CommonSettings.resourceSize[0], clearResource.downsampleFactor);
-            uint16_t h = DivideUp(m_CommonSettings.resourceSize[1], clearResource.downsampleFactor);
-
-            DispatchDesc dispatchDesc = {};
-            dispatchDesc.name = internalDispatchDesc.name;
-            dispatchDesc.identifier = clearResource.identifier;
-            dispatchDesc.resources = &clearResource.resource;
-            dispatchDesc.resourcesNum = 1;
-            dispatchDesc.pipelineIndex = internalDispatchDesc.pipelineIndex;
-            dispatchDesc.gridWidth = DivideUp(w, internalDispatchDesc.numThreads.width);
-            dispatchDesc.gridHeight = DivideUp(h, internalDispatchDesc.numThreads.height);
-
-            m_ActiveDispatches.push_back(dispatchDesc);
-        }
+    bool isClearAndRestart = m_CommonSettings.accumulationMode == AccumulationMode::CLEAR_AND_RESTART;
+    if (isClearAndRestart) {
+        uint32_t clearBatchOffset = GatherClearBatches(identifiers, identifiersNum);
+        PushClearDispatches(clearBatchOffset);
     }
 
     // Collect dispatches for requested denoisers
-    for (const DenoiserData& denoiserData : m_DenoiserData) {
+    for (DenoiserData& denoiserData : m_DenoiserData) {
         // If current denoiser is in list
         if (!IsInList(denoiserData.desc.identifier, identifiers, identifiersNum))
             continue;
 
+        // The tile classification pass (the first local dispatch) is the "probe" providing the feedback for a skipped or frozen denoiser.
+        // Not available if the tiles are shared and have already been classified by another denoiser on this frame
+        bool hasProbe = denoiserData.desc.denoiser != Denoiser::REFERENCE && (!denoiserData.usesSharedTiles || !m_AreSharedTilesClassified);
+        hasProbe &= !m_CommonSettings.enableValidation && m_CommonSettings.splitScreen == 0.0f;
+
+        // A denoiser with nothing to denoise for a while gets skipped. Its history is outdated on resume
+        bool isSkipped = hasProbe && m_CommonSettings.emptyFrameNumToSkipDenoiser && denoiserData.emptyFrameNum >= m_CommonSettings.emptyFrameNumToSkipDenoiser;
+        bool isResumed = denoiserData.isSkipped && !isSkipped;
+        bool isRestarted = isResumed || denoiserData.isRestartRequested;
+        if (isRestarted && !isClearAndRestart) {
+            uint32_t clearBatchOffset = GatherClearBatches(&denoiserData.desc.identifier, 1);
+            PushClearDispatches(clearBatchOffset);
+        }
+
+        denoiserData.isSkipped = isSkipped;
+        denoiserData.isRestartRequested = false;
+
+        // Updated before the freeze decision, i.e. a frame with a camera change or a history reset is never frozen
+        if (!m_IsStaticFrame || isRestarted)
+            denoiserData.unchangedFrameNum = 0;
+        else if (denoiserData.unchangedFrameNum != uint32_t(-1))
+            denoiserData.unchangedFrameNum++;
+
+        // A converged denoiser with static inputs gets frozen if the app reports a static scene. Its history stays intact, i.e. no ping-pong swaps
+        bool isFrozen = hasProbe && !isSkipped && m_CommonSettings.isSceneStatic && denoiserData.unchangedFrameNum > GetConvergedFrameNum(denoiserData);
+
         // Update denoiser and gather dispatches
-        UpdatePingPong(denoiserData);
+        size_t firstDispatchIndex = m_ActiveDispatches.size();
+        if (!isFrozen)
+            UpdatePingPong(denoiserData);
 
         if (denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE || denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SH || denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR || denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR_SH || denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR || denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR_SH || denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION)
             Update_Reblur(denoiserData);
@@ -547,6 +615,13 @@ nrd::Result nrd::InstanceImpl::GetComputeDispatches(const Identifier* identifier
             Update_SigmaShadow(denoiserData);
         else if (denoiserData.desc.denoiser == Denoiser::REFERENCE)
             Update_Reference(denoiserData);
+
+        // Keep only the "probe" (in half resolution it's preceded by the downsampling pass)
+        if (isSkipped || isFrozen) {
+            size_t probeIndex = firstDispatchIndex + (denoiserData.desc.enableHalfResolution ? 1 : 0);
+            assert("Unexpected probe!" && m_ActiveDispatches[probeIndex].pipelineIndex == m_Shared->dispatches[denoiserData.dispatchOffset].pipelineIndex);
+            m_ActiveDispatches.resize(probeIndex + 1);
+        }
     }
 
     // Maximize CB reuse
@@ -566,6 +641,87 @@ nrd::Result nrd::InstanceImpl::GetComputeDispatches(const Identifier* identifier
     return dispatchDescsNum ? Result::SUCCESS : Result::INVALID_ARGUMENT;
 }
 
+bool nrd::InstanceImpl::FindPermutation(const void* blob, size_t blobSize, const ShaderMake::ShaderConstant* defines, uint32_t definesNum, const void** bytecode, size_t* size) {
+    // A blob gets indexed on first use, i.e. it's walked once per instance, not once per permutation
+    if (m_IndexedBlobs.emplace((uint64_t)(size_t)blob, true).second)
+        IndexPermutations(blob, blobSize);
+
+    // Hash "NAME=VALUE NAME=VALUE" on the fly
+    uint64_t hash = Hash(HASH_OFFSET, &blob, sizeof(blob));
+    size_t permutationSize = 0;
+    for (uint32_t i = 0; i < definesNum; i++) {
+        size_t nameSize = strlen(defines[i].name);
+        size_t valueSize = strlen(defines[i].value);
+
+        if (i)
+            hash = Hash(hash, " ", 1);
+        hash = Hash(hash, defines[i].name, nameSize);
+        hash = Hash(hash, "=", 1);
+        hash = Hash(hash, defines[i].value, valueSize);
+
+        permutationSize += (i ? 1 : 0) + nameSize + 1 + valueSize;
+    }
+
+    const auto& entry = m_Permutations.find(hash);
+    if (entry != m_Permutations.end() && entry->second.permutationSize == permutationSize) {
+        // Verify (hash collisions are unlikely, but possible)
+        const char* s = entry->second.permutation;
+        bool isMatched = true;
+        for (uint32_t i = 0; i < definesNum && isMatched; i++) {
+            size_t nameSize = strlen(defines[i].name);
+            size_t valueSize = strlen(defines[i].value);
+
+            if (i)
+                isMatched = *s++ == ' ';
+            isMatched = isMatched && !strncmp(s, defines[i].name, nameSize) && s[nameSize] == '=' && !strncmp(s + nameSize + 1, defines[i].value, valueSize);
+
+            s += nameSize + 1 + valueSize;
+        }
+
+        if (isMatched) {
+            *bytecode = entry->second.bytecode;
+            *size = entry->second.size;
+
+            return true;
+        }
+    }
+
+    // Not a permutation blob or a hash collision
+    return ShaderMake::FindPermutationInBlob(blob, blobSize, defines, definesNum, bytecode, size);
+}
+
+void nrd::InstanceImpl::IndexPermutations(const void* blob, size_t blobSize) {
+    // ShaderMake blob layout: "NVSP", then entries "{uint32_t permutationSize, uint32_t dataSize}, permutation, bytecode"
+    const uint8_t* bytes = (const uint8_t*)blob;
+    if (blobSize < 4 || memcmp(bytes, "NVSP", 4))
+        return;
+
+    bytes += 4;
+    blobSize -= 4;
+
+    uint64_t blobHash = Hash(HASH_OFFSET, &blob, sizeof(blob));
+    while (blobSize > sizeof(uint32_t) * 2) {
+        uint32_t header[2];
+        memcpy(header, bytes, sizeof(header));
+
+        size_t entrySize = sizeof(header) + header[0] + header[1];
+        if (!header[1] || blobSize < entrySize)
+            break;
+
+        PermutationEntry permutationEntry = {};
+        permutationEntry.permutation = (const char*)bytes + sizeof(header);
+        permutationEntry.bytecode = bytes + sizeof(header) + header[0];
+        permutationEntry.permutationSize = header[0];
+        permutationEntry.size = header[1];
+
+        uint64_t hash = Hash(blobHash, permutationEntry.permutation, permutationEntry.permutationSize);
+        m_Permutations.emplace(hash, permutationEntry); // on a collision the first entry wins, others are found by "FindPermutationInBlob"
+
+        bytes += entrySize;
+        blobSize -= entrySize;
+    }
+}
+
 void nrd::InstanceImpl::AddInternalDispatch(PipelineDesc& pipelineDesc, NumThreads numThreads, uint16_t downsampleFactor, uint32_t constantBufferDataSize, uint32_t maxRepeatNum) {
 #if NRD_EMBEDS_DXBC_SHADERS
     assert("DXBC: shader permutation is not found!" && pipelineDesc.computeShaderDXBC.bytecode);
@@ -580,25 +736,28 @@ void nrd::InstanceImpl::AddInternalDispatch(PipelineDesc& pipelineDesc, NumThrea
 #endif
 
     // Add pipeline (unique only)
-    size_t pipelineIndex = 0;
-    for (; pipelineIndex < m_Pipelines.size(); pipelineIndex++) {
-        [[maybe_unused]] const PipelineDesc& pipeline = m_Pipelines[pipelineIndex];
-
+    const void* bytecode = nullptr;
 #if NRD_EMBEDS_DXBC_SHADERS
-        if (pipeline.computeShaderDXBC.bytecode == pipelineDesc.computeShaderDXBC.bytecode)
-            break;
+    bytecode = pipelineDesc.computeShaderDXBC.bytecode;
 #elif NRD_EMBEDS_DXIL_SHADERS
-        if (pipeline.computeShaderDXIL.bytecode == pipelineDesc.computeShaderDXIL.bytecode)
-            break;
+    bytecode = pipelineDesc.computeShaderDXIL.bytecode;
 #elif NRD_EMBEDS_SPIRV_SHADERS
-        if (pipeline.computeShaderSPIRV.bytecode == pipelineDesc.computeShaderSPIRV.bytecode)
-            break;
+    bytecode = pipelineDesc.computeShaderSPIRV.bytecode;
 #endif
+
+    size_t pipelineIndex = m_Shared->pipelines.size();
+    if (bytecode) {
+        const auto& entry = m_PipelineIndices.find((uint64_t)(size_t)bytecode);
+        if (entry != m_PipelineIndices.end())
+            pipelineIndex = entry->second;
+        else
+            m_PipelineIndices.emplace((uint64_t)(size_t)bytecode, (uint16_t)pipelineIndex);
     }
 
-    if (pipelineIndex == m_Pipelines.size()) {
-        pipelineDesc.resourceRanges = (ResourceRangeDesc*)m_ResourceRanges.size();
+    if (pipelineIndex == m_Shared->pipelines.size()) {
+        pipelineDesc.resourceRanges = (ResourceRangeDesc*)m_Shared->resourceRanges.size();
         pipelineDesc.hasConstantData = constantBufferDataSize != 0;
+        pipelineDesc.type = m_PipelineType;
 
         for (size_t r = 0; r < 2; r++) {
             ResourceRangeDesc descriptorRange = {};
@@ -611,12 +770,12 @@ void nrd::InstanceImpl::AddInternalDispatch(PipelineDesc& pipelineDesc, NumThrea
             }
 
             if (descriptorRange.descriptorsNum != 0) {
-                m_ResourceRanges.push_back(descriptorRange);
+                m_Shared->resourceRanges.push_back(descriptorRange);
                 pipelineDesc.resourceRangesNum++;
             }
         }
 
-        m_Pipelines.push_back(pipelineDesc);
+        m_Shared->pipelines.push_back(pipelineDesc);
     }
 
     // Add dispatch
@@ -627,10 +786,10 @@ void nrd::InstanceImpl::AddInternalDispatch(PipelineDesc& pipelineDesc, NumThrea
     dispatchDesc.maxRepeatNum = (uint16_t)maxRepeatNum;
     dispatchDesc.constantBufferDataSize = constantBufferDataSize;
     dispatchDesc.resourcesNum = uint32_t(m_Resources.size() - m_ResourceOffset);
-    dispatchDesc.resources = (ResourceDesc*)m_ResourceOffset;
+    dispatchDesc.resourceOffset = m_ResourceOffset;
     dispatchDesc.numThreads = numThreads;
 
-    m_Dispatches.push_back(dispatchDesc);
+    m_Shared->dispatches.push_back(dispatchDesc);
 }
 
 void nrd::InstanceImpl::PrepareDesc() {
@@ -645,35 +804,26 @@ void nrd::InstanceImpl::PrepareDesc() {
     m_Desc.samplersBaseRegisterIndex = 0;
 
     m_Desc.shaderEntryPoint = NRD_STRINGIFY(NRD_CS_MAIN);
-    m_Desc.pipelines = m_Pipelines.data();
-    m_Desc.pipelinesNum = (uint32_t)m_Pipelines.size();
+    m_Desc.pipelines = m_Shared->pipelines.data();
+    m_Desc.pipelinesNum = (uint32_t)m_Shared->pipelines.size();
     m_Desc.resourcesBaseRegisterIndex = 0;
 
-    m_Desc.permanentPool = m_PermanentPool.data();
-    m_Desc.permanentPoolSize = (uint32_t)m_PermanentPool.size();
+    m_Desc.permanentPool = m_Shared->permanentPool.data();
+    m_Desc.permanentPoolSize = (uint32_t)m_Shared->permanentPool.size();
 
-    m_Desc.transientPool = m_TransientPool.data();
-    m_Desc.transientPoolSize = (uint32_t)m_TransientPool.size();
+    m_Desc.transientPool = m_Shared->transientPool.data();
+    m_Desc.transientPoolSize = (uint32_t)m_Shared->transientPool.size();
 
     // Calculate descriptor heap (pool) requirements
-    Vector<const char*> unique(GetStdAllocator());
-    unique.reserve(m_Dispatches.size());
-
-    for (InternalDispatchDesc& dispatchDesc : m_Dispatches) {
-        size_t textureOffset = (size_t)dispatchDesc.resources;
-        dispatchDesc.resources = &m_Resources[textureOffset];
-
-        // Ignore permutations (we need only unique passes for descriptor pool limits)
-        size_t n = 0;
-        for (; n < unique.size(); n++) {
-            // We can use "==" because all strings are static memory
-            if (dispatchDesc.name == unique[n])
-                break;
-        }
-        if (n != unique.size())
-            continue;
+    HashMap<uint64_t, bool> unique(GetStdAllocator());
+    unique.reserve(m_Shared->dispatches.size());
+
+    for (InternalDispatchDesc& dispatchDesc : m_Shared->dispatches) {
+        const ResourceDesc* resources = &m_Resources[dispatchDesc.resourceOffset];
 
-        unique.push_back(dispatchDesc.name);
+        // Ignore permutations (we need only unique passes for descriptor pool limits). Pointers can be used because all strings are static memory
+        if (!unique.emplace((uint64_t)(size_t)dispatchDesc.name, true).second)
+            continue;
 
         // Update limits
         m_Desc.descriptorPoolDesc.setsMaxNum += dispatchDesc.maxRepeatNum;
@@ -681,7 +831,7 @@ void nrd::InstanceImpl::PrepareDesc() {
         uint32_t texturesMaxNum = 0;
         uint32_t storageTexturesMaxNum = 0;
         for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++) {
-            const ResourceDesc& resource = dispatchDesc.resources[i];
+            const ResourceDesc& resource = resources[i];
 
             if (resource.descriptorType == DescriptorType::TEXTURE) {
                 m_Desc.descriptorPoolDesc.totalTexturesNum += dispatchDesc.maxRepeatNum;
@@ -698,16 +848,187 @@ void nrd::InstanceImpl::PrepareDesc() {
         m_Desc.descriptorPoolDesc.perSetStorageTexturesMaxNum = std::max(m_Desc.descriptorPoolDesc.perSetStorageTexturesMaxNum, storageTexturesMaxNum);
     }
 
-    // For potential clears
-    uint32_t clearNum = (uint32_t)m_ClearResources.size();
-    m_Desc.descriptorPoolDesc.setsMaxNum += clearNum;
-    m_Desc.descriptorPoolDesc.totalStorageTexturesNum += clearNum;
+    // For potential clears (all denoisers requested is the worst case)
+    uint32_t clearBatchOffset = GatherClearBatches(nullptr, 0);
+    uint32_t clearBatchNum = (uint32_t)m_ClearBatches.size() - clearBatchOffset;
+    m_Desc.descriptorPoolDesc.setsMaxNum += clearBatchNum;
+    m_Desc.descriptorPoolDesc.totalStorageTexturesNum += clearBatchNum * CLEAR_BATCH_SIZE;
+    m_ClearBatches.clear();
 
     // Assign resources
-    for (PipelineDesc& pipelineDesc : m_Pipelines) {
+    for (PipelineDesc& pipelineDesc : m_Shared->pipelines) {
         size_t descriptorRangeffset = (size_t)pipelineDesc.resourceRanges;
-        pipelineDesc.resourceRanges = &m_ResourceRanges[descriptorRangeffset];
+        pipelineDesc.resourceRanges = &m_Shared->resourceRanges[descriptorRangeffset];
+    }
+}
+
+void nrd::InstanceImpl::PushClearDispatches(uint32_t clearBatchOffset) {
+    for (size_t i = clearBatchOffset; i < m_ClearBatches.size(); i++) {
+        const ClearBatch& clearBatch = m_ClearBatches[i];
+
+        // Add a clear dispatch (a single texture doesn't need the "batch" permutation)
+        bool isBatch = clearBatch.resourcesNum > 1;
+        const InternalDispatchDesc& internalDispatchDesc = m_Shared->dispatches[m_DispatchClearIndex[(isBatch ? 2 : 0) + (clearBatch.isInteger ? 1 : 0)]];
+
+        uint16_t w = DivideUp(m_CommonSettings.resourceSize[0], clearBatch.downsampleFactor);
+        uint16_t h = DivideUp(m_CommonSettings.resourceSize[1], clearBatch.downsampleFactor);
+
+        DispatchDesc dispatchDesc = {};
+        dispatchDesc.name = internalDispatchDesc.name;
+        dispatchDesc.identifier = clearBatch.identifier;
+        dispatchDesc.resources = clearBatch.resources;
+        dispatchDesc.resourcesNum = isBatch ? CLEAR_BATCH_SIZE : 1;
+        dispatchDesc.pipelineIndex = internalDispatchDesc.pipelineIndex;
+        dispatchDesc.gridWidth = DivideUp(w, internalDispatchDesc.numThreads.width);
+        dispatchDesc.gridHeight = DivideUp(h, internalDispatchDesc.numThreads.height);
+
+        m_ActiveDispatches.push_back(dispatchDesc);
+    }
+}
+
+// Batches get appended, since "DispatchDesc::resources" of already pushed clears point into "m_ClearBatches" until the next
+// "GetComputeDispatches". Returns the index of the first added batch
+uint32_t nrd::InstanceImpl::GatherClearBatches(const Identifier* identifiers, uint32_t identifiersNum) {
+    uint32_t clearBatchOffset = (uint32_t)m_ClearBatches.size();
+
+    for (const ClearResource& clearResource : m_Shared->clearResources) {
+        // If current denoiser is in list ("identifiers = nullptr" means "all")
+        if (identifiers && !IsInList(clearResource.identifier, identifiers, identifiersNum))
+            continue;
+
+        // Find a compatible batch with a free slot
+        ClearBatch* clearBatch = nullptr;
+        for (size_t i = clearBatchOffset; i < m_ClearBatches.size(); i++) {
+            ClearBatch& temp = m_ClearBatches[i];
+            if (temp.identifier == clearResource.identifier && temp.isInteger == clearResource.isInteger && temp.downsampleFactor == clearResource.downsampleFactor && temp.resourcesNum < CLEAR_BATCH_SIZE) {
+                clearBatch = &temp;
+                break;
+            }
+        }
+
+        // Or start a new one (a denoiser is cleared once per frame, i.e. can't exceed "m_Shared->clearResources.size()" and no reallocations)
+        if (!clearBatch) {
+            clearBatch = &m_ClearBatches.emplace_back();
+            *clearBatch = {};
+            clearBatch->identifier = clearResource.identifier;
+            clearBatch->downsampleFactor = clearResource.downsampleFactor;
+            clearBatch->isInteger = clearResource.isInteger;
+        }
+
+        // Unused slots are filled with the first texture (clearing twice is harmless)
+        if (clearBatch->resourcesNum == 0) {
+            for (ResourceDesc& resource : clearBatch->resources)
+                resource = clearResource.resource;
+        }
+
+        clearBatch->resources[clearBatch->resourcesNum++] = clearResource.resource;
+    }
+
+    return clearBatchOffset;
+}
+
+void nrd::InstanceImpl::UpdateCamera() {
+    if (!m_IsCameraDirty)
+        return;
+
+    m_IsCameraDirty = false;
+
+    { // Rotators (respecting sample patterns symmetry)
+        // Square roots of primes provide excellent decorrelation for Weyl sequences
+        float anglePre = Sequence::Weyl1D(1.0f / sqrt(2.0f), m_CommonSettings.frameIndex);
+        float angle = Sequence::Weyl1D(1.0f / sqrt(3.0f), m_CommonSettings.frameIndex);
+
+        // "PostBlur" rotator is rotated to avoid mapping to same directions after "Blur"
+        constexpr float minNonSymmetryAngle = 22.5f; // see the kernel: 90 - symmetry angle, 45 - same directions
+
+        m_RotatorPre = Geometry::GetRotator(anglePre * radians(90.0f));
+        m_Rotator = Geometry::GetRotator(angle * radians(90.0f));
+        m_RotatorPost = Geometry::GetRotator(angle * radians(90.0f) + radians(minNonSymmetryAngle));
+    }
+
+    // Main matrices
+    m_ViewToClip = float4x4(
+        float4(m_CommonSettings.viewToClipMatrix),
+        float4(m_CommonSettings.viewToClipMatrix + 4),
+        float4(m_CommonSettings.viewToClipMatrix + 8),
+        float4(m_CommonSettings.viewToClipMatrix + 12));
+
+    m_ViewToClipPrev = float4x4(
+        float4(m_CommonSettings.viewToClipMatrixPrev),
+        float4(m_CommonSettings.viewToClipMatrixPrev + 4),
+        float4(m_CommonSettings.viewToClipMatrixPrev + 8),
+        float4(m_CommonSettings.viewToClipMatrixPrev + 12));
+
+    m_WorldToView = float4x4(
+        float4(m_CommonSettings.worldToViewMatrix),
+        float4(m_CommonSettings.worldToViewMatrix + 4),
+        float4(m_CommonSettings.worldToViewMatrix + 8),
+        float4(m_CommonSettings.worldToViewMatrix + 12));
+
+    m_WorldToViewPrev = float4x4(
+        float4(m_CommonSettings.worldToViewMatrixPrev),
+        float4(m_CommonSettings.worldToViewMatrixPrev + 4),
+        float4(m_CommonSettings.worldToViewMatrixPrev + 8),
+        float4(m_CommonSettings.worldToViewMatrixPrev + 12));
+
+    m_WorldPrevToWorld = float4x4(
+        float4(m_CommonSettings.worldPrevToWorldMatrix),
+        float4(m_CommonSettings.worldPrevToWorldMatrix + 4),
+        float4(m_CommonSettings.worldPrevToWorldMatrix + 8),
+        float4(m_CommonSettings.worldPrevToWorldMatrix + 12));
+
+    // Convert to LH
+    uint32_t flags = 0;
+    DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClip, &flags, nullptr, nullptr, m_Frustum.a, nullptr, nullptr);
+
+    if (!(flags & PROJ_LEFT_HANDED)) {
+        m_ViewToClip[2] = -m_ViewToClip[2];
+        m_ViewToClipPrev[2] = -m_ViewToClipPrev[2];
+
+        m_WorldToView.Transpose();
+        m_WorldToView[2] = -m_WorldToView[2];
+        m_WorldToView.Transpose();
+
+        m_WorldToViewPrev.Transpose();
+        m_WorldToViewPrev[2] = -m_WorldToViewPrev[2];
+        m_WorldToViewPrev.Transpose();
     }
+
+    // Compute other matrices
+    m_ViewToWorld = m_WorldToView;
+    m_ViewToWorld.InvertOrtho();
+
+    m_ViewToWorldPrev = m_WorldToViewPrev;
+    m_ViewToWorldPrev.InvertOrtho();
+
+    const float3& cameraPosition = m_ViewToWorld[3].xyz;
+    const float3& cameraPositionPrev = m_ViewToWorldPrev[3].xyz;
+    float3 translationDelta = cameraPositionPrev - cameraPosition;
+
+    // IMPORTANT: this part is mandatory needed to preserve precision by making matrices camera relative
+    m_ViewToWorld.SetTranslation(float3::Zero());
+    m_WorldToView = m_ViewToWorld;
+    m_WorldToView.InvertOrtho();
+
+    m_ViewToWorldPrev.SetTranslation(translationDelta);
+    m_WorldToViewPrev = m_ViewToWorldPrev;
+    m_WorldToViewPrev.InvertOrtho();
+
+    m_WorldToClip = m_ViewToClip * m_WorldToView;
+    m_WorldToClipPrev = m_ViewToClipPrev * m_WorldToViewPrev;
+
+    float project[3];
+    DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClip, &flags, nullptr, nullptr, m_Frustum.a, project, nullptr);
+
+    m_ProjectY = project[1];
+    m_OrthoMode = (flags & PROJ_ORTHO) ? -1.0f : 0.0f;
+
+    DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClipPrev, &flags, nullptr, nullptr, m_FrustumPrev.a, nullptr, nullptr);
+
+    m_ViewDirection = -float3(m_ViewToWorld[2]);
+    m_ViewDirectionPrev = -float3(m_ViewToWorldPrev[2]);
+
+    m_CameraDelta = float3(translationDelta.x, translationDelta.y, translationDelta.z);
 }
 
 void nrd::InstanceImpl::UpdatePingPong(const DenoiserData& denoiserData) {
@@ -723,7 +1044,12 @@ void nrd::InstanceImpl::PushTexture(DescriptorType descriptorType, uint16_t loca
     ResourceType resourceType = (ResourceType)localIndex;
     uint16_t globalIndex = 0;
 
-    if (localIndex >= TRANSIENT_POOL_START) {
+    if (localIndex >= TRANSIENT_POOL_START && localIndex - TRANSIENT_POOL_START == m_SharedTilesLocalIndex) {
+        assert(indexToSwapWith == uint16_t(-1));
+
+        resourceType = ResourceType::PERMANENT_POOL;
+        globalIndex = m_SharedTilesIndexInPool;
+    } else if (localIndex >= TRANSIENT_POOL_START) {
         resourceType = ResourceType::TRANSIENT_POOL;
         globalIndex = m_IndexRemap[localIndex - TRANSIENT_POOL_START];
 
@@ -752,7 +1078,7 @@ void nrd::InstanceImpl::AddTextureToTransientPool(const TextureDesc& textureDesc
     // Try to find a replacement from previous denoisers
     for (uint16_t i = 0; i < m_TransientPoolOffset; i++) {
         // Format and dimensions must match
-        const TextureDesc& t = m_TransientPool[i];
+        const TextureDesc& t = m_Shared->transientPool[i];
         if (t.format == textureDesc.format && t.downsampleFactor == textureDesc.downsampleFactor) {
             // The candidate must not be already in use in the current denoiser
             size_t j = 0;
@@ -771,19 +1097,41 @@ void nrd::InstanceImpl::AddTextureToTransientPool(const TextureDesc& textureDesc
     }
 
     // A replacement is not found - add memory
-    m_IndexRemap.push_back((uint16_t)m_TransientPool.size());
-    m_TransientPool.push_back(textureDesc);
+    m_IndexRemap.push_back((uint16_t)m_Shared->transientPool.size());
+    m_Shared->transientPool.push_back(textureDesc);
+}
+
+void nrd::InstanceImpl::AddTilesToTransientPool(const TextureDesc& textureDesc) {
+    if (!m_EnableSharedTileClassification) {
+        AddTextureToTransientPool(textureDesc);
+
+        return;
+    }
+
+    // Shared tiles must survive between denoisers, i.e. they live in the permanent pool (tiny)
+    if (m_SharedTilesIndexInPool == uint16_t(-1)) {
+        m_SharedTilesIndexInPool = (uint16_t)m_Shared->permanentPool.size();
+        m_Shared->permanentPool.push_back({textureDesc.format, textureDesc.downsampleFactor, TextureClass::INTERNAL_DATA});
+    } else {
+        const TextureDesc& sharedTiles = m_Shared->permanentPool[m_SharedTilesIndexInPool];
+        assert("Incompatible tiles" && sharedTiles.format == textureDesc.format && sharedTiles.downsampleFactor == textureDesc.downsampleFactor);
+        (void)sharedTiles;
+    }
+
+    // Keep local indexing intact ("-1" is never matched in "AddTextureToTransientPool")
+    m_SharedTilesLocalIndex = (uint16_t)m_IndexRemap.size();
+    m_IndexRemap.push_back(uint16_t(-1));
 }
 
 void* nrd::InstanceImpl::PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex) {
     size_t dispatchIndex = denoiserData.dispatchOffset + localIndex;
-    const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[dispatchIndex];
+    const InternalDispatchDesc& internalDispatchDesc = m_Shared->dispatches[dispatchIndex];
 
     // Copy data
     DispatchDesc dispatchDesc = {};
     dispatchDesc.name = internalDispatchDesc.name;
     dispatchDesc.identifier = internalDispatchDesc.identifier;
-    dispatchDesc.resources = internalDispatchDesc.resources;
+    dispatchDesc.resources = m_Resources.data() + internalDispatchDesc.resourceOffset;
     dispatchDesc.resourcesNum = internalDispatchDesc.resourcesNum;
     dispatchDesc.pipelineIndex = internalDispatchDesc.pipelineIndex;
 
@@ -19,6 +19,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "ml.h"
 #include "ml.hlsli"
 
+#include <atomic>  // std::atomic
 #include <cassert> // assert
 #include <cstdlib> // malloc
 #include <cstring> // memset
@@ -32,19 +33,19 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define NRD_MAKE_SHADER_CONSTANT(name, value) ShaderMake::ShaderConstant{#name, #value}
 
 #if NRD_EMBEDS_DXBC_SHADERS
-#    define FillDXBC(blobName, defines, computeShader) ShaderMake::FindPermutationInBlob(g_##blobName##_cs_dxbc, GetCountOf(g_##blobName##_cs_dxbc), defines.data(), (uint32_t)defines.size(), &computeShader.bytecode, (size_t*)&computeShader.size)
+#    define FillDXBC(blobName, defines, computeShader) FindPermutation(g_##blobName##_cs_dxbc, GetCountOf(g_##blobName##_cs_dxbc), defines.data(), (uint32_t)defines.size(), &computeShader.bytecode, (size_t*)&computeShader.size)
 #else
 #    define FillDXBC(blobName, defines, computeShader)
 #endif
 
 #if NRD_EMBEDS_DXIL_SHADERS
-#    define FillDXIL(blobName, defines, computeShader) ShaderMake::FindPermutationInBlob(g_##blobName##_cs_dxil, GetCountOf(g_##blobName##_cs_dxil), defines.data(), (uint32_t)defines.size(), &computeShader.bytecode, (size_t*)&computeShader.size)
+#    define FillDXIL(blobName, defines, computeShader) FindPermutation(g_##blobName##_cs_dxil, GetCountOf(g_##blobName##_cs_dxil), defines.data(), (uint32_t)defines.size(), &computeShader.bytecode, (size_t*)&computeShader.size)
 #else
 #    define FillDXIL(blobName, defines, computeShader)
 #endif
 
 #if NRD_EMBEDS_SPIRV_SHADERS
-#    define FillSPIRV(blobName, defines, computeShader) ShaderMake::FindPermutationInBlob(g_##blobName##_cs_spirv, GetCountOf(g_##blobName##_cs_spirv), defines.data(), (uint32_t)defines.size(), &computeShader.bytecode, (size_t*)&computeShader.size)
+#    define FillSPIRV(blobName, defines, computeShader) FindPermutation(g_##blobName##_cs_spirv, GetCountOf(g_##blobName##_cs_spirv), defines.data(), (uint32_t)defines.size(), &computeShader.bytecode, (size_t*)&computeShader.size)
 #else
 #    define FillSPIRV(blobName, defines, computeShader)
 #endif
@@ -101,6 +102,9 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define PushPass(passName) \
     _PushPass(NRD_STRINGIFY(DENOISER_NAME) " - " passName)
 
+#define PushClassifyTilesPass() \
+    _PushPass(NRD_STRINGIFY(DENOISER_NAME) " - Classify tiles", PipelineType::CLASSIFY_TILES)
+
 // TODO: rework is needed, but still better than copy-pasting
 #define NRD_DECLARE_DIMS \
     [[maybe_unused]] uint16_t resourceW = m_CommonSettings.resourceSize[0]; \
@@ -141,6 +145,7 @@ namespace nrd {
 constexpr uint16_t PERMANENT_POOL_START = 1000;
 constexpr uint16_t TRANSIENT_POOL_START = 2000;
 constexpr size_t CONSTANT_DATA_SIZE = 128 * 1024; // TODO: improve
+constexpr uint16_t CLEAR_BATCH_SIZE = 8;            // must match "ClearBatchSize" in "Clear.resources.hlsli"
 
 constexpr uint16_t USE_PREV_DIMS = 0xFFFF;
 
@@ -167,6 +172,12 @@ struct DenoiserData {
     size_t dispatchOffset;
     size_t pingPongOffset;
     size_t pingPongNum;
+    uint32_t emptyFrameNum;     // consecutive frames without active tiles (see "SetDenoiserFeedback")
+    uint32_t unchangedFrameNum; // consecutive frames with static inputs (see "isSceneStatic")
+    uint32_t activeTileNum;     // last reported via "SetDenoiserFeedback"
+    bool usesSharedTiles;
+    bool isSkipped;
+    bool isRestartRequested; // see "RestartDenoiser"
 };
 
 struct PingPong {
@@ -189,7 +200,7 @@ struct NumThreads {
 
 struct InternalDispatchDesc {
     const char* name;
-    const ResourceDesc* resources; // concatenated resources for all "ResourceRangeDesc" descriptions in InstanceDesc::pipelines[ pipelineIndex ]
+    size_t resourceOffset; // in "m_Resources": concatenated resources for all "ResourceRangeDesc" descriptions in InstanceDesc::pipelines[ pipelineIndex ]
     uint32_t resourcesNum;
     const uint8_t* constantBufferData;
     uint32_t constantBufferDataSize;
@@ -207,6 +218,50 @@ struct ClearResource {
     bool isInteger;
 };
 
+// Clears of textures of the same denoiser with same "downsampleFactor" and "isInteger" get merged into a single dispatch
+// (a dispatch belongs to a single denoiser, i.e. the integration can skip or reorder it along with other denoiser's dispatches)
+struct ClearBatch {
+    ResourceDesc resources[CLEAR_BATCH_SIZE];
+    Identifier identifier;
+    uint16_t downsampleFactor;
+    uint16_t resourcesNum;
+    bool isInteger;
+};
+
+// An entry of an embedded permutation blob
+struct PermutationEntry {
+    const char* permutation; // "NAME=VALUE NAME=VALUE", not null-terminated
+    const void* bytecode;
+    uint32_t permutationSize;
+    uint32_t size;
+};
+
+// Immutable after "Create", shared by an instance and its clones (see "CloneInstance")
+struct SharedTables {
+    inline SharedTables(const StdAllocator<uint8_t>& stdAllocator)
+        : permanentPool(stdAllocator)
+        , transientPool(stdAllocator)
+        , resourceRanges(stdAllocator)
+        , pipelines(stdAllocator)
+        , dispatches(stdAllocator)
+        , clearResources(stdAllocator) {
+        permanentPool.reserve(32);
+        transientPool.reserve(32);
+        resourceRanges.reserve(64);
+        pipelines.reserve(32);
+        dispatches.reserve(32);
+        clearResources.reserve(32);
+    }
+
+    Vector<TextureDesc> permanentPool;
+    Vector<TextureDesc> transientPool;
+    Vector<ResourceRangeDesc> resourceRanges;
+    Vector<PipelineDesc> pipelines;
+    Vector<InternalDispatchDesc> dispatches;
+    Vector<ClearResource> clearResources;
+    std::atomic<uint32_t> refCount{1};
+};
+
 class InstanceImpl {
     // Add denoisers here
 public:
@@ -250,16 +305,14 @@ public:
     inline InstanceImpl(const StdAllocator<uint8_t>& stdAllocator)
         : m_StdAllocator(stdAllocator)
         , m_DenoiserData(GetStdAllocator())
-        , m_PermanentPool(GetStdAllocator())
-        , m_TransientPool(GetStdAllocator())
         , m_Resources(GetStdAllocator())
-        , m_ClearResources(GetStdAllocator())
+        , m_ClearBatches(GetStdAllocator())
         , m_PingPongs(GetStdAllocator())
-        , m_ResourceRanges(GetStdAllocator())
-        , m_Pipelines(GetStdAllocator())
-        , m_Dispatches(GetStdAllocator())
         , m_ActiveDispatches(GetStdAllocator())
-        , m_IndexRemap(GetStdAllocator()) {
+        , m_IndexRemap(GetStdAllocator())
+        , m_Permutations(GetStdAllocator())
+        , m_IndexedBlobs(GetStdAllocator())
+        , m_PipelineIndices(GetStdAllocator()) {
         m_ConstantDataUnaligned = m_StdAllocator.allocate(CONSTANT_DATA_SIZE + sizeof(float4));
 
         // IMPORTANT: underlying memory for constants must be aligned, as well as any individual SSE-type containing member,
@@ -268,19 +321,16 @@ public:
         memset(m_ConstantData, 0, CONSTANT_DATA_SIZE);
 
         m_DenoiserData.reserve(8);
-        m_PermanentPool.reserve(32);
-        m_TransientPool.reserve(32);
         m_Resources.reserve(128);
-        m_ClearResources.reserve(32);
         m_PingPongs.reserve(32);
-        m_ResourceRanges.reserve(64);
-        m_Pipelines.reserve(32);
-        m_Dispatches.reserve(32);
         m_ActiveDispatches.reserve(32);
     }
 
     ~InstanceImpl() {
         m_StdAllocator.deallocate(m_ConstantDataUnaligned, 0);
+
+        if (m_Shared && --m_Shared->refCount == 0)
+            Deallocate(m_StdAllocator, m_Shared);
     }
 
     inline const InstanceDesc& GetDesc() const {
@@ -291,14 +341,35 @@ public:
         return m_StdAllocator;
     }
 
+    inline const StdAllocator<uint8_t>& GetStdAllocator() const {
+        return m_StdAllocator;
+    }
+
+    inline size_t GetDenoiserSettingsSize(Identifier identifier) const {
+        for (const DenoiserData& denoiserData : m_DenoiserData) {
+            if (denoiserData.desc.identifier == identifier)
+                return denoiserData.settingsSize;
+        }
+
+        return 0;
+    }
+
     Result Create(const InstanceCreationDesc& instanceCreationDesc);
+    Result Clone(const InstanceImpl& instance);
     Result SetCommonSettings(const CommonSettings& commonSettings);
     Result SetDenoiserSettings(Identifier identifier, const void* denoiserSettings);
+    Result SetDenoiserFeedback(Identifier identifier, uint32_t activeTileNum);
+    Result RestartDenoiser(Identifier identifier);
     Result GetComputeDispatches(const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
 
 private:
+    uint32_t GatherClearBatches(const Identifier* identifiers, uint32_t identifiersNum);
+    void PushClearDispatches(uint32_t clearBatchOffset);
+    bool FindPermutation(const void* blob, size_t blobSize, const ShaderMake::ShaderConstant* defines, uint32_t definesNum, const void** bytecode, size_t* size);
+    void IndexPermutations(const void* blob, size_t blobSize);
     void AddInternalDispatch(PipelineDesc& pipelineDesc, NumThreads numThreads, uint16_t downsampleFactor, uint32_t constantBufferDataSize, uint32_t maxRepeatNum);
     void PrepareDesc();
+    void UpdateCamera();
     void UpdatePingPong(const DenoiserData& denoiserData);
     void PushTexture(DescriptorType descriptorType, uint16_t localIndex, uint16_t indexToSwapWith = uint16_t(-1));
 
@@ -307,8 +378,10 @@ private:
     void AddTextureToTransientPool(const TextureDesc& textureDesc);
     void* PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex);
 
+    void AddTilesToTransientPool(const TextureDesc& textureDesc);
+
     inline void AddTextureToPermanentPool(const TextureDesc& textureDesc) {
-        m_PermanentPool.push_back(textureDesc);
+        m_Shared->permanentPool.push_back(textureDesc);
     }
 
     inline void PushInput(uint16_t indexInPool, uint16_t indexToSwapWith = uint16_t(-1)) {
@@ -319,39 +392,35 @@ private:
         PushTexture(DescriptorType::STORAGE_TEXTURE, indexInPool, indexToSwapWith);
     }
 
-    inline void _PushPass(const char* name) {
+    inline void _PushPass(const char* name, PipelineType pipelineType = PipelineType::DEFAULT) {
         m_PassName = name;
+        m_PipelineType = pipelineType;
         m_ResourceOffset = m_Resources.size();
     }
 
 private:
     StdAllocator<uint8_t> m_StdAllocator;
     Vector<DenoiserData> m_DenoiserData;
-    Vector<TextureDesc> m_PermanentPool;
-    Vector<TextureDesc> m_TransientPool;
-    Vector<ResourceDesc> m_Resources;
-    Vector<ClearResource> m_ClearResources;
+    Vector<ResourceDesc> m_Resources; // mutable, since ping-pong swaps "indexInPool"
+    Vector<ClearBatch> m_ClearBatches;
     Vector<PingPong> m_PingPongs;
-    Vector<ResourceRangeDesc> m_ResourceRanges;
-    Vector<PipelineDesc> m_Pipelines;
-    Vector<InternalDispatchDesc> m_Dispatches;
     Vector<DispatchDesc> m_ActiveDispatches;
     Vector<uint16_t> m_IndexRemap;
+    HashMap<uint64_t, PermutationEntry> m_Permutations; // "Create" only: hash of blob + permutation => entry
+    HashMap<uint64_t, bool> m_IndexedBlobs;             // "Create" only
+    HashMap<uint64_t, uint16_t> m_PipelineIndices;      // "Create" only: bytecode => index in "pipelines"
+    SharedTables* m_Shared = nullptr;
     Timer m_Timer;
     InstanceDesc m_Desc = {};
     CommonSettings m_CommonSettings = {};
     float4x4 m_ViewToClip = float4x4::Identity();
     float4x4 m_ViewToClipPrev = float4x4::Identity();
-    float4x4 m_ClipToView = float4x4::Identity();
-    float4x4 m_ClipToViewPrev = float4x4::Identity();
     float4x4 m_WorldToView = float4x4::Identity();
     float4x4 m_WorldToViewPrev = float4x4::Identity();
     float4x4 m_ViewToWorld = float4x4::Identity();
     float4x4 m_ViewToWorldPrev = float4x4::Identity();
     float4x4 m_WorldToClip = float4x4::Identity();
     float4x4 m_WorldToClipPrev = float4x4::Identity();
-    float4x4 m_ClipToWorld = float4x4::Identity();
-    float4x4 m_ClipToWorldPrev = float4x4::Identity();
     float4x4 m_WorldPrevToWorld = float4x4::Identity();
     float4 m_RotatorPre = float4::Zero();
     float4 m_Rotator = float4::Zero();
@@ -363,11 +432,12 @@ private:
     float3 m_ViewDirectionPrev = float3::Zero();
     float m_SplitScreenPrev = 0.0f;
     const char* m_PassName = nullptr;
+    PipelineType m_PipelineType = PipelineType::DEFAULT;
     uint8_t* m_ConstantDataUnaligned = nullptr;
     uint8_t* m_ConstantData = nullptr;
     size_t m_ConstantDataOffset = 0;
     size_t m_ResourceOffset = 0;
-    size_t m_DispatchClearIndex[2] = {};
+    size_t m_DispatchClearIndex[4] = {}; // [batch][isInteger]
     float m_OrthoMode = 0.0f;
     float m_CheckerboardResolveAccumSpeed = 0.0f;
     float m_JitterDelta = 0.0f;
@@ -377,6 +447,12 @@ private:
     uint32_t m_AccumulatedFrameNum = 0;
     uint16_t m_TransientPoolOffset = 0;
     uint16_t m_PermanentPoolOffset = 0;
+    uint16_t m_SharedTilesIndexInPool = uint16_t(-1);  // in permanent pool
+    uint16_t m_SharedTilesLocalIndex = uint16_t(-1);   // in transient pool of the current denoiser
+    bool m_EnableSharedTileClassification = false;
+    bool m_AreSharedTilesClassified = false;
+    bool m_IsStaticFrame = false;
+    bool m_IsCameraDirty = true;
     bool m_IsFirstUse = true;
 };
 } // namespace nrd
@@ -13,6 +13,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "../Shaders/REBLUR_Config.hlsli"
 #include "../Shaders/REBLUR_Blur.resources.hlsli"
 #include "../Shaders/REBLUR_ClassifyTiles.resources.hlsli"
+#include "../Shaders/REBLUR_Downsample.resources.hlsli"
 #include "../Shaders/REBLUR_HistoryFix.resources.hlsli"
 #include "../Shaders/REBLUR_HitDistReconstruction.resources.hlsli"
 #include "../Shaders/REBLUR_PostBlur.resources.hlsli"
@@ -20,6 +21,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "../Shaders/REBLUR_SplitScreen.resources.hlsli"
 #include "../Shaders/REBLUR_TemporalAccumulation.resources.hlsli"
 #include "../Shaders/REBLUR_TemporalStabilization.resources.hlsli"
+#include "../Shaders/REBLUR_Upsample.resources.hlsli"
 #include "../Shaders/REBLUR_Validation.resources.hlsli"
 
 // Permutations
@@ -95,6 +97,28 @@ constexpr std::array<ReblurProps, 10> g_ReblurProps = {{
     {true, false}, // REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION
 }};
 
+// Virtual viewport seen by the passes between "Downsample" and "Upsample": half resolution internal textures start at (0, 0),
+// jitter is in half resolution pixels, confidence inputs can't be used
+static nrd::CommonSettings GetHalfResolutionCommonSettings(const nrd::CommonSettings& commonSettings) {
+    nrd::CommonSettings halfResolutionSettings = commonSettings;
+
+    for (uint32_t i = 0; i < 2; i++) {
+        halfResolutionSettings.resourceSize[i] = nrd::DivideUp(commonSettings.resourceSize[i], 2);
+        halfResolutionSettings.resourceSizePrev[i] = nrd::DivideUp(commonSettings.resourceSizePrev[i], 2);
+        halfResolutionSettings.rectSize[i] = nrd::DivideUp(commonSettings.rectSize[i], 2);
+        halfResolutionSettings.rectSizePrev[i] = nrd::DivideUp(commonSettings.rectSizePrev[i], 2);
+        halfResolutionSettings.rectOrigin[i] = 0;
+        halfResolutionSettings.printfAt[i] = commonSettings.printfAt[i] / 2;
+        halfResolutionSettings.cameraJitter[i] = commonSettings.cameraJitter[i] * 0.5f;
+        halfResolutionSettings.cameraJitterPrev[i] = commonSettings.cameraJitterPrev[i] * 0.5f;
+    }
+
+    halfResolutionSettings.isHistoryConfidenceAvailable = false;
+    halfResolutionSettings.isDisocclusionThresholdMixAvailable = false;
+
+    return halfResolutionSettings;
+}
+
 void nrd::InstanceImpl::Update_Reblur(const DenoiserData& denoiserData) {
     enum class Dispatch {
         CLASSIFY_TILES,
@@ -107,6 +131,8 @@ void nrd::InstanceImpl::Update_Reblur(const DenoiserData& denoiserData) {
         TEMPORAL_STABILIZATION = POST_BLUR + REBLUR_POST_BLUR_PERMUTATION_NUM,
         SPLIT_SCREEN = TEMPORAL_STABILIZATION + REBLUR_NO_PERMUTATIONS,
         VALIDATION = SPLIT_SCREEN + REBLUR_NO_PERMUTATIONS,
+        DOWNSAMPLE = VALIDATION + REBLUR_NO_PERMUTATIONS, // half resolution only
+        UPSAMPLE = DOWNSAMPLE + REBLUR_NO_PERMUTATIONS,   // half resolution only
     };
 
     NRD_DECLARE_DIMS;
@@ -117,6 +143,7 @@ void nrd::InstanceImpl::Update_Reblur(const DenoiserData& denoiserData) {
     bool enableHitDistanceReconstruction = settings.hitDistanceReconstructionMode != HitDistanceReconstructionMode::OFF && settings.checkerboardMode == CheckerboardMode::OFF;
     bool skipTemporalStabilization = settings.maxStabilizedFrameNum == 0;
     bool skipPrePass = (settings.diffusePrepassBlurRadius == 0.0f || !props.hasDiffuse) && (settings.specularPrepassBlurRadius == 0.0f || !props.hasSpecular) && settings.checkerboardMode == CheckerboardMode::OFF;
+    bool isHalfRes = denoiserData.desc.enableHalfResolution;
 
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f) {
@@ -126,9 +153,21 @@ void nrd::InstanceImpl::Update_Reblur(const DenoiserData& denoiserData) {
         return;
     }
 
-    { // CLASSIFY_TILES
+    // DOWNSAMPLE (the denoising passes below see a virtual half resolution viewport)
+    CommonSettings commonSettings = m_CommonSettings;
+    if (isHalfRes) {
+        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::DOWNSAMPLE));
+        AddSharedConstants_Reblur(settings, consts);
+
+        m_CommonSettings = GetHalfResolutionCommonSettings(commonSettings);
+    }
+
+    // CLASSIFY_TILES (shared tiles are classified by the first denoiser)
+    if (!denoiserData.usesSharedTiles || !m_AreSharedTilesClassified) {
         void* consts = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
         AddSharedConstants_Reblur(settings, consts);
+
+        m_AreSharedTilesClassified |= denoiserData.usesSharedTiles;
     }
 
     // HITDIST_RECONSTRUCTION
@@ -183,14 +222,22 @@ void nrd::InstanceImpl::Update_Reblur(const DenoiserData& denoiserData) {
         AddSharedConstants_Reblur(settings, consts);
     }
 
+    // UPSAMPLE
+    if (isHalfRes) {
+        m_CommonSettings = commonSettings;
+
+        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::UPSAMPLE));
+        AddSharedConstants_Reblur(settings, consts);
+    }
+
     // SPLIT_SCREEN
     if (m_CommonSettings.splitScreen > 0.0f) {
         void* consts = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
         AddSharedConstants_Reblur(settings, consts);
     }
 
-    // VALIDATION
-    if (m_CommonSettings.enableValidation) {
+    // VALIDATION (not supported in half resolution)
+    if (m_CommonSettings.enableValidation && !isHalfRes) {
         REBLUR_ValidationConstants* consts = (REBLUR_ValidationConstants*)PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION));
         AddSharedConstants_Reblur(settings, consts);
         consts->gHasDiffuse = props.hasDiffuse ? 1 : 0;   // TODO: push constant
@@ -225,9 +272,12 @@ void nrd::InstanceImpl::Update_ReblurOcclusion(const DenoiserData& denoiserData)
         return;
     }
 
-    { // CLASSIFY_TILES
+    // CLASSIFY_TILES (shared tiles are classified by the first denoiser)
+    if (!denoiserData.usesSharedTiles || !m_AreSharedTilesClassified) {
         void* consts = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
         AddSharedConstants_Reblur(settings, consts);
+
+        m_AreSharedTilesClassified |= denoiserData.usesSharedTiles;
     }
 
     // HITDIST_RECONSTRUCTION
@@ -281,6 +331,8 @@ void nrd::InstanceImpl::Update_ReblurOcclusion(const DenoiserData& denoiserData)
 }
 
 void nrd::InstanceImpl::AddSharedConstants_Reblur(const ReblurSettings& settings, void* data) {
+    UpdateCamera();
+
     struct SharedConstants {
         REBLUR_SHARED_CONSTANTS
     };
@@ -397,6 +449,7 @@ void nrd::InstanceImpl::AddSharedConstants_Reblur(const ReblurSettings& settings
 #if NRD_EMBEDS_DXBC_SHADERS
 #    include "REBLUR_Blur.cs.dxbc.h"
 #    include "REBLUR_ClassifyTiles.cs.dxbc.h"
+#    include "REBLUR_Downsample.cs.dxbc.h"
 #    include "REBLUR_HistoryFix.cs.dxbc.h"
 #    include "REBLUR_HitDistReconstruction.cs.dxbc.h"
 #    include "REBLUR_PostBlur.cs.dxbc.h"
@@ -404,12 +457,14 @@ void nrd::InstanceImpl::AddSharedConstants_Reblur(const ReblurSettings& settings
 #    include "REBLUR_SplitScreen.cs.dxbc.h"
 #    include "REBLUR_TemporalAccumulation.cs.dxbc.h"
 #    include "REBLUR_TemporalStabilization.cs.dxbc.h"
+#    include "REBLUR_Upsample.cs.dxbc.h"
 #    include "REBLUR_Validation.cs.dxbc.h"
 #endif
 
 #if NRD_EMBEDS_DXIL_SHADERS
 #    include "REBLUR_Blur.cs.dxil.h"
 #    include "REBLUR_ClassifyTiles.cs.dxil.h"
+#    include "REBLUR_Downsample.cs.dxil.h"
 #    include "REBLUR_HistoryFix.cs.dxil.h"
 #    include "REBLUR_HitDistReconstruction.cs.dxil.h"
 #    include "REBLUR_PostBlur.cs.dxil.h"
@@ -417,12 +472,14 @@ void nrd::InstanceImpl::AddSharedConstants_Reblur(const ReblurSettings& settings
 #    include "REBLUR_SplitScreen.cs.dxil.h"
 #    include "REBLUR_TemporalAccumulation.cs.dxil.h"
 #    include "REBLUR_TemporalStabilization.cs.dxil.h"
+#    include "REBLUR_Upsample.cs.dxil.h"
 #    include "REBLUR_Validation.cs.dxil.h"
 #endif
 
 #if NRD_EMBEDS_SPIRV_SHADERS
 #    include "REBLUR_Blur.cs.spirv.h"
 #    include "REBLUR_ClassifyTiles.cs.spirv.h"
+#    include "REBLUR_Downsample.cs.spirv.h"
 #    include "REBLUR_HistoryFix.cs.spirv.h"
 #    include "REBLUR_HitDistReconstruction.cs.spirv.h"
 #    include "REBLUR_PostBlur.cs.spirv.h"
@@ -430,6 +487,7 @@ void nrd::InstanceImpl::AddSharedConstants_Reblur(const ReblurSettings& settings
 #    include "REBLUR_SplitScreen.cs.spirv.h"
 #    include "REBLUR_TemporalAccumulation.cs.spirv.h"
 #    include "REBLUR_TemporalStabilization.cs.spirv.h"
+#    include "REBLUR_Upsample.cs.spirv.h"
 #    include "REBLUR_Validation.cs.spirv.h"
 #endif
 
@@ -18,6 +18,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "../Shaders/RELAX_Copy.resources.hlsli"
 #include "../Shaders/RELAX_HistoryClamping.resources.hlsli"
 #include "../Shaders/RELAX_HistoryFix.resources.hlsli"
+#include "../Shaders/RELAX_HistoryFixMip.resources.hlsli"
+#include "../Shaders/RELAX_HistoryFixMipGen.resources.hlsli"
 #include "../Shaders/RELAX_HitDistReconstruction.resources.hlsli"
 #include "../Shaders/RELAX_PrePass.resources.hlsli"
 #include "../Shaders/RELAX_SplitScreen.resources.hlsli"
@@ -44,6 +46,7 @@ constexpr uint32_t RELAX_MAX_ATROUS_PASS_NUM = 8;
         PushInput(AsUint(ResourceType::IN_VIEWZ)); \
         PushInput(AsUint(ResourceType::IN_MV)); \
         PushInput(AsUint(Transient::HISTORY_LENGTH)); \
+        PushInput(AsUint(Transient::ATROUS_TILES)); \
         PushOutput(AsUint(ResourceType::OUT_VALIDATION)); \
         std::array<ShaderMake::ShaderConstant, 0> defines = {}; \
         AddDispatch(RELAX_Validation, defines); \
@@ -58,6 +61,8 @@ inline float3 RELAX_GetFrustumForward(const float4x4& viewToWorld, const float4&
 }
 
 void nrd::InstanceImpl::AddSharedConstants_Relax(const RelaxSettings& settings, void* data) {
+    UpdateCamera();
+
     struct SharedConstants {
         RELAX_SHARED_CONSTANTS
     };
@@ -192,6 +197,8 @@ void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData) {
         ATROUS = ANTI_FIREFLY + RELAX_NO_PERMUTATIONS,
         SPLIT_SCREEN = ATROUS + RELAX_ATROUS_PERMUTATION_NUM * RELAX_ATROUS_BINDING_VARIANT_NUM,
         VALIDATION = SPLIT_SCREEN + RELAX_NO_PERMUTATIONS,
+        HISTORY_FIX_MIP_GEN = VALIDATION + RELAX_NO_PERMUTATIONS,        // radiance only
+        HISTORY_FIX_MIP = HISTORY_FIX_MIP_GEN + RELAX_NO_PERMUTATIONS,   // radiance only
     };
 
     NRD_DECLARE_DIMS;
@@ -199,6 +206,9 @@ void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData) {
     const RelaxSettings& settings = denoiserData.settings.relax;
     bool enableHitDistanceReconstruction = settings.hitDistanceReconstructionMode != HitDistanceReconstructionMode::OFF && settings.checkerboardMode == CheckerboardMode::OFF;
     uint32_t iterationNum = clamp(settings.atrousIterationNum, 2u, RELAX_MAX_ATROUS_PASS_NUM);
+    bool isAdaptiveAtrous = settings.atrousConvergenceThreshold > 0.0f;
+    bool isSh = denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SH || denoiserData.desc.denoiser == Denoiser::RELAX_SPECULAR_SH || denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SPECULAR_SH;
+    bool enableMipBasedHistoryFix = settings.enableMipBasedHistoryFix && !isSh;
 
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f) {
@@ -208,9 +218,12 @@ void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData) {
         return;
     }
 
-    { // CLASSIFY_TILES
+    // CLASSIFY_TILES (shared tiles are classified by the first denoiser)
+    if (!denoiserData.usesSharedTiles || !m_AreSharedTilesClassified) {
         void* consts = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
         AddSharedConstants_Relax(settings, consts);
+
+        m_AreSharedTilesClassified |= denoiserData.usesSharedTiles;
     }
 
     // HITDIST_RECONSTRUCTION
@@ -233,7 +246,17 @@ void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData) {
         AddSharedConstants_Relax(settings, consts);
     }
 
-    { // HISTORY_FIX
+    if (enableMipBasedHistoryFix) {
+        { // HISTORY_FIX_MIP_GEN
+            void* consts = PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_FIX_MIP_GEN));
+            AddSharedConstants_Relax(settings, consts);
+        }
+
+        { // HISTORY_FIX_MIP
+            void* consts = PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_FIX_MIP));
+            AddSharedConstants_Relax(settings, consts);
+        }
+    } else { // HISTORY_FIX
         void* consts = PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_FIX));
         AddSharedConstants_Relax(settings, consts);
     }
@@ -267,6 +290,8 @@ void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData) {
         AddSharedConstants_Relax(settings, consts);
         consts->gStepSize = 1 << i;                          // TODO: push constant
         consts->gIsLastPass = i == iterationNum - 1 ? 1 : 0; // TODO: push constant
+        consts->gSkipConvergedTiles = (isAdaptiveAtrous && i >= settings.atrousConvergedIterationNum) ? 1 : 0;
+        consts->gConvergenceThreshold = settings.atrousConvergenceThreshold;
     }
 
     // SPLIT_SCREEN
@@ -291,6 +316,8 @@ void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData) {
 #    include "RELAX_Copy.cs.dxbc.h"
 #    include "RELAX_HistoryClamping.cs.dxbc.h"
 #    include "RELAX_HistoryFix.cs.dxbc.h"
+#    include "RELAX_HistoryFixMip.cs.dxbc.h"
+#    include "RELAX_HistoryFixMipGen.cs.dxbc.h"
 #    include "RELAX_HitDistReconstruction.cs.dxbc.h"
 #    include "RELAX_PrePass.cs.dxbc.h"
 #    include "RELAX_SplitScreen.cs.dxbc.h"
@@ -306,6 +333,8 @@ void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData) {
 #    include "RELAX_Copy.cs.dxil.h"
 #    include "RELAX_HistoryClamping.cs.dxil.h"
 #    include "RELAX_HistoryFix.cs.dxil.h"
+#    include "RELAX_HistoryFixMip.cs.dxil.h"
+#    include "RELAX_HistoryFixMipGen.cs.dxil.h"
 #    include "RELAX_HitDistReconstruction.cs.dxil.h"
 #    include "RELAX_PrePass.cs.dxil.h"
 #    include "RELAX_SplitScreen.cs.dxil.h"
@@ -321,6 +350,8 @@ void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData) {
 #    include "RELAX_Copy.cs.spirv.h"
 #    include "RELAX_HistoryClamping.cs.spirv.h"
 #    include "RELAX_HistoryFix.cs.spirv.h"
+#    include "RELAX_HistoryFixMip.cs.spirv.h"
+#    include "RELAX_HistoryFixMipGen.cs.spirv.h"
 #    include "RELAX_HitDistReconstruction.cs.spirv.h"
 #    include "RELAX_PrePass.cs.spirv.h"
 #    include "RELAX_SplitScreen.cs.spirv.h"
@@ -84,6 +84,8 @@ void nrd::InstanceImpl::Update_SigmaShadow(const DenoiserData& denoiserData) {
 }
 
 void nrd::InstanceImpl::AddSharedConstants_Sigma(const SigmaSettings& settings, void* data) {
+    UpdateCamera();
+
     struct SharedConstants {
         SIGMA_SHARED_CONSTANTS
     };
@@ -11,6 +11,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #pragma once
 
 #include <array>
+#include <unordered_map>
 #include <vector>
 
 namespace nrd {
@@ -113,4 +114,7 @@ inline void Deallocate(StdAllocator<uint8_t>& allocator, T* object) {
 template <typename T>
 using Vector = std::vector<T, StdAllocator<T>>;
 
+template <typename K, typename V>
+using HashMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, StdAllocator<std::pair<const K, V>>>;
+
 } // namespace nrd
@@ -11,6 +11,9 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "../Resources/Version.h"
 #include "InstanceImpl.h"
 #include "NRD.h"
+#include "NRDTrace.h"
+
+#include <mutex> // std::mutex
 
 static_assert(VERSION_MAJOR == NRD_VERSION_MAJOR, "VERSION_MAJOR & NRD_VERSION_MAJOR don't match!");
 static_assert(VERSION_MINOR == NRD_VERSION_MINOR, "VERSION_MINOR & NRD_VERSION_MINOR don't match!");
@@ -179,6 +182,39 @@ static void NRD_CALL AlignedFree(void*, void* memory) {
 
 #endif
 
+// Trace recorder (see "NRDTrace.h"). A record is written under the lock, i.e. records of concurrent calls don't interleave and
+// "SetTraceCallback" can't swap the callback in the middle of a record. The atomic is a cheap "is recording" check
+static std::atomic<nrd::TraceWriteCallback> g_TraceCallback = {nullptr};
+static void* g_TraceUserArg = nullptr; // protected by "g_TraceLock"
+static std::mutex g_TraceLock;
+
+static void TraceWriteHeader(nrd::TraceWriteCallback callback, nrd::TraceRecord type, const void* instance, size_t size) {
+    nrd::TraceRecordHeader header = {};
+    header.type = type;
+    header.size = (uint32_t)size;
+    header.instance = (uint64_t)(size_t)instance;
+
+    callback(g_TraceUserArg, &header, sizeof(header));
+}
+
+struct TraceRecorder {
+    inline TraceRecorder(nrd::TraceRecord type, const void* instance, size_t size)
+        : m_Lock(g_TraceLock), m_Callback(g_TraceCallback.load(std::memory_order_relaxed)) {
+        // Recording could have been stopped since the check
+        if (m_Callback)
+            TraceWriteHeader(m_Callback, type, instance, size);
+    }
+
+    inline void Write(const void* data, size_t size) {
+        if (m_Callback && size)
+            m_Callback(g_TraceUserArg, data, size);
+    }
+
+private:
+    std::lock_guard<std::mutex> m_Lock;
+    nrd::TraceWriteCallback m_Callback;
+};
+
 NRD_API const nrd::LibraryDesc* NRD_CALL nrd::GetLibraryDesc() {
     return &g_NrdLibraryDesc;
 }
@@ -202,6 +238,40 @@ NRD_API nrd::Result NRD_CALL nrd::CreateInstance(const InstanceCreationDesc& ins
     } else
         instance = (Instance*)impl;
 
+    if (g_TraceCallback) {
+        uint32_t enableSharedTileClassification = instanceCreationDesc.enableSharedTileClassification ? 1 : 0;
+        size_t denoisersSize = instanceCreationDesc.denoisersNum * sizeof(DenoiserDesc);
+
+        TraceRecorder trace(TraceRecord::CREATE_INSTANCE, instance, sizeof(result) + sizeof(uint32_t) * 2 + denoisersSize);
+        trace.Write(&result, sizeof(result));
+        trace.Write(&instanceCreationDesc.denoisersNum, sizeof(uint32_t));
+        trace.Write(&enableSharedTileClassification, sizeof(uint32_t));
+        trace.Write(instanceCreationDesc.denoisers, denoisersSize);
+    }
+
+    return result;
+}
+
+NRD_API nrd::Result NRD_CALL nrd::CloneInstance(const Instance& instance, Instance*& clone) {
+    StdAllocator<uint8_t> memoryAllocator = ((const InstanceImpl&)instance).GetStdAllocator();
+
+    InstanceImpl* impl = Allocate<InstanceImpl>(memoryAllocator, memoryAllocator);
+    Result result = impl->Clone((const InstanceImpl&)instance);
+
+    if (result != Result::SUCCESS) {
+        Deallocate(memoryAllocator, impl);
+        clone = nullptr;
+    } else
+        clone = (Instance*)impl;
+
+    if (g_TraceCallback) {
+        uint64_t sourceInstance = (uint64_t)(size_t)&instance;
+
+        TraceRecorder trace(TraceRecord::CLONE_INSTANCE, clone, sizeof(result) + sizeof(sourceInstance));
+        trace.Write(&result, sizeof(result));
+        trace.Write(&sourceInstance, sizeof(sourceInstance));
+    }
+
     return result;
 }
 
@@ -210,18 +280,102 @@ NRD_API const nrd::InstanceDesc* NRD_CALL nrd::GetInstanceDesc(const Instance& d
 }
 
 NRD_API nrd::Result NRD_CALL nrd::SetCommonSettings(Instance& instance, const CommonSettings& commonSettings) {
-    return ((InstanceImpl&)instance).SetCommonSettings(commonSettings);
+    Result result = ((InstanceImpl&)instance).SetCommonSettings(commonSettings);
+
+    if (g_TraceCallback) {
+        TraceRecorder trace(TraceRecord::SET_COMMON_SETTINGS, &instance, sizeof(result) + sizeof(commonSettings));
+        trace.Write(&result, sizeof(result));
+        trace.Write(&commonSettings, sizeof(commonSettings));
+    }
+
+    return result;
 }
 
 NRD_API nrd::Result NRD_CALL nrd::SetDenoiserSettings(Instance& instance, Identifier identifier, const void* denoiserSettings) {
-    return ((InstanceImpl&)instance).SetDenoiserSettings(identifier, denoiserSettings);
+    Result result = ((InstanceImpl&)instance).SetDenoiserSettings(identifier, denoiserSettings);
+
+    if (g_TraceCallback) {
+        size_t settingsSize = ((const InstanceImpl&)instance).GetDenoiserSettingsSize(identifier);
+
+        TraceRecorder trace(TraceRecord::SET_DENOISER_SETTINGS, &instance, sizeof(result) + sizeof(identifier) + settingsSize);
+        trace.Write(&result, sizeof(result));
+        trace.Write(&identifier, sizeof(identifier));
+        trace.Write(denoiserSettings, settingsSize);
+    }
+
+    return result;
+}
+
+NRD_API nrd::Result NRD_CALL nrd::SetDenoiserFeedback(Instance& instance, Identifier identifier, uint32_t activeTileNum) {
+    Result result = ((InstanceImpl&)instance).SetDenoiserFeedback(identifier, activeTileNum);
+
+    if (g_TraceCallback) {
+        TraceRecorder trace(TraceRecord::SET_DENOISER_FEEDBACK, &instance, sizeof(result) + sizeof(identifier) + sizeof(activeTileNum));
+        trace.Write(&result, sizeof(result));
+        trace.Write(&identifier, sizeof(identifier));
+        trace.Write(&activeTileNum, sizeof(activeTileNum));
+    }
+
+    return result;
+}
+
+NRD_API nrd::Result NRD_CALL nrd::RestartDenoiser(Instance& instance, Identifier identifier) {
+    Result result = ((InstanceImpl&)instance).RestartDenoiser(identifier);
+
+    if (g_TraceCallback) {
+        TraceRecorder trace(TraceRecord::RESTART_DENOISER, &instance, sizeof(result) + sizeof(identifier));
+        trace.Write(&result, sizeof(result));
+        trace.Write(&identifier, sizeof(identifier));
+    }
+
+    return result;
 }
 
 NRD_API nrd::Result NRD_CALL nrd::GetComputeDispatches(Instance& instance, const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum) {
-    return ((InstanceImpl&)instance).GetComputeDispatches(identifiers, identifiersNum, dispatchDescs, dispatchDescsNum);
+    Result result = ((InstanceImpl&)instance).GetComputeDispatches(identifiers, identifiersNum, dispatchDescs, dispatchDescsNum);
+
+    if (g_TraceCallback) {
+        uint32_t num = result == Result::SUCCESS ? dispatchDescsNum : 0;
+        size_t identifiersSize = identifiersNum * sizeof(Identifier);
+
+        TraceRecorder trace(TraceRecord::GET_COMPUTE_DISPATCHES, &instance, sizeof(result) + sizeof(uint32_t) * 2 + identifiersSize + num * sizeof(TraceDispatch));
+        trace.Write(&result, sizeof(result));
+        trace.Write(&identifiersNum, sizeof(identifiersNum));
+        trace.Write(identifiers, identifiersSize);
+        trace.Write(&num, sizeof(num));
+
+        for (uint32_t i = 0; i < num; i++) {
+            TraceDispatch traceDispatch = GetTraceDispatch(dispatchDescs[i]);
+            trace.Write(&traceDispatch, sizeof(traceDispatch));
+        }
+    }
+
+    return result;
+}
+
+NRD_API void NRD_CALL nrd::SetTraceCallback(TraceWriteCallback callback, void* userArg) {
+    // In-flight records get finished with the previous callback, "BEGIN" is guaranteed to be the first record
+    std::lock_guard<std::mutex> lock(g_TraceLock);
+
+    g_TraceCallback = callback;
+    g_TraceUserArg = userArg;
+
+    if (callback) {
+        TraceBegin traceBegin = {};
+        traceBegin.signature = NRD_TRACE_SIGNATURE;
+        traceBegin.versionMajor = VERSION_MAJOR;
+        traceBegin.versionMinor = VERSION_MINOR;
+        traceBegin.versionBuild = VERSION_BUILD;
+
+        TraceWriteHeader(callback, TraceRecord::BEGIN, nullptr, sizeof(traceBegin));
+        callback(userArg, &traceBegin, sizeof(traceBegin));
+    }
 }
 
 NRD_API void NRD_CALL nrd::DestroyInstance(Instance& instance) {
+    if (g_TraceCallback)
+        TraceRecorder trace(TraceRecord::DESTROY_INSTANCE, &instance, 0);
+
     StdAllocator<uint8_t> memoryAllocator = ((InstanceImpl&)instance).GetStdAllocator();
     Deallocate(memoryAllocator, (InstanceImpl*)&instance);
 }